@@ -0,0 +1,252 @@
+// pico_forge_bench: throughput, latency percentiles and allocations per
+// operation for the generation pipeline, over synthetic configs of growing size.
+//
+//   pico_forge_bench [--sizes 10,100,...] [--iterations N] [--out results.json]
+//
+// Results are written as JSON (stdout unless --out is given); a human-readable
+// summary goes to stderr.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "../src/config/config.h"
+#include "../src/config/config_parser.h"
+#include "../src/config/config_validator.h"
+#include "../src/core/code_injector.h"
+#include "../src/generators/cmake_generator.h"
+#include "../src/generators/main_generator.h"
+#include "../src/utils/json_writer.h"
+#include "synthetic_config.h"
+
+// Counting global allocator. Relaxed atomics: we only read totals between runs.
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_allocated_bytes{0};
+// Benchmarked results are folded in here so the optimiser cannot drop the work.
+std::atomic<size_t> g_sink{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using namespace picoforge;
+using Clock = std::chrono::steady_clock;
+
+struct BenchResult {
+    std::string op;
+    size_t modules = 0;
+    size_t iterations = 0;
+    double meanNs = 0;
+    double p50Ns = 0;
+    double p99Ns = 0;
+    double allocsPerOp = 0;
+    double bytesPerOp = 0;
+};
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+BenchResult measure(const std::string& op, size_t modules, size_t iterations, const std::function<void()>& fn) {
+    fn();  // warm-up: first-touch allocations and caches
+
+    std::vector<double> samples;
+    samples.reserve(iterations);
+    uint64_t allocsBefore = g_allocations.load(std::memory_order_relaxed);
+    uint64_t bytesBefore = g_allocated_bytes.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < iterations; ++i) {
+        auto start = Clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+    // samples was reserved up front, so the loop itself adds no allocations.
+    uint64_t allocs = g_allocations.load(std::memory_order_relaxed) - allocsBefore;
+    uint64_t bytes = g_allocated_bytes.load(std::memory_order_relaxed) - bytesBefore;
+
+    std::sort(samples.begin(), samples.end());
+    BenchResult r;
+    r.op = op;
+    r.modules = modules;
+    r.iterations = iterations;
+    double total = 0;
+    for (double s : samples) total += s;
+    r.meanNs = total / static_cast<double>(iterations);
+    r.p50Ns = percentile(samples, 0.50);
+    r.p99Ns = percentile(samples, 0.99);
+    r.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(iterations);
+    r.bytesPerOp = static_cast<double>(bytes) / static_cast<double>(iterations);
+    return r;
+}
+
+// Enough repetitions for stable percentiles on small inputs without letting
+// the 100k-module runs dominate wall time.
+size_t default_iterations(size_t modules) {
+    return std::clamp<size_t>(200000 / std::max<size_t>(modules, 1), 5, 1000);
+}
+
+void run_size(size_t modules, size_t iterations, std::vector<BenchResult>& results) {
+    if (iterations == 0) iterations = default_iterations(modules);
+
+    const std::string config = bench::syntheticConfig(modules);
+    ProjectConfig project = ConfigParser::parseProjectString(config);
+    ProjectStore store = ConfigParser::parseProjectStoreString(config);
+    MainGenerator generator;
+    GeneratedCode code = generator.generate(project.modules);
+    const std::string generatedMain = MainGenerator::composeMainSource(code);
+    const std::string existingMain = bench::withUserCode(generatedMain);
+    const UserBlockScan scan = CodeInjector::scanUserBlocks(existingMain);
+
+    size_t sink = 0;
+
+    results.push_back(measure("parse", modules, iterations, [&]() {
+        sink += ConfigParser::parseProjectString(config).modules.size();
+    }));
+    results.push_back(measure("parse_store", modules, iterations, [&]() {
+        sink += ConfigParser::parseProjectStoreString(config).modules.size();
+    }));
+    results.push_back(measure("validate", modules, iterations, [&]() {
+        for (const auto& m : project.modules) sink += m->validate() ? 1 : 0;
+    }));
+    results.push_back(measure("validate_all", modules, iterations, [&]() {
+        sink += ConfigValidator::validateAll(project.modules).diagnostics.size();
+    }));
+    results.push_back(measure("main_generate", modules, iterations, [&]() {
+        sink += generator.generate(project.modules).mainBody.size();
+    }));
+    results.push_back(measure("main_generate_store", modules, iterations, [&]() {
+        sink += generator.generate(store.modules).mainBody.size();
+    }));
+    results.push_back(measure("cmake_generate", modules, iterations, [&]() {
+        sink += CMakeGenerator::generate(project.name, project.modules).size();
+    }));
+    results.push_back(measure("cmake_generate_store", modules, iterations, [&]() {
+        sink += CMakeGenerator::generate(store.name, store.modules).size();
+    }));
+    results.push_back(measure("inject_extract", modules, iterations, [&]() {
+        sink += CodeInjector::scanUserBlocks(existingMain).blocks.size();
+    }));
+    results.push_back(measure("inject_apply", modules, iterations, [&]() {
+        sink += CodeInjector::injectUserBlocks(generatedMain, scan.blocks).size();
+    }));
+
+    g_sink.fetch_add(sink, std::memory_order_relaxed);
+}
+
+std::vector<size_t> parse_sizes(const std::string& list) {
+    std::vector<size_t> sizes;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t comma = list.find(',', pos);
+        if (comma == std::string::npos) comma = list.size();
+        size_t n = std::strtoull(list.substr(pos, comma - pos).c_str(), nullptr, 10);
+        if (n > 0) sizes.push_back(n);
+        pos = comma + 1;
+    }
+    return sizes;
+}
+
+std::string to_json(const std::vector<BenchResult>& results) {
+    JsonWriter w;
+    w.beginObject()
+     .key("benchmark").value("pico_forge_bench")
+     .key("version").value(kVersion)
+     .key("results").beginArray();
+    for (const auto& r : results) {
+        double opsPerSec = r.meanNs > 0 ? 1e9 / r.meanNs : 0;
+        w.beginObject()
+         .key("op").value(r.op)
+         .key("modules").value(r.modules)
+         .key("iterations").value(r.iterations)
+         .key("mean_ns").value(r.meanNs)
+         .key("p50_ns").value(r.p50Ns)
+         .key("p99_ns").value(r.p99Ns)
+         .key("ops_per_sec").value(opsPerSec)
+         .key("modules_per_sec").value(opsPerSec * static_cast<double>(r.modules))
+         .key("allocs_per_op").value(r.allocsPerOp)
+         .key("bytes_per_op").value(r.bytesPerOp)
+         .endObject();
+    }
+    w.endArray().endObject();
+    return w.take();
+}
+
+void print_summary(const std::vector<BenchResult>& results) {
+    for (const auto& r : results) {
+        std::cerr << r.op << " n=" << r.modules << ": p50 " << r.p50Ns / 1000.0 << " us, p99 "
+                  << r.p99Ns / 1000.0 << " us, " << r.allocsPerOp << " allocs/op\n";
+    }
+}
+
+void print_usage() {
+    std::cerr << "Usage: pico_forge_bench [--sizes 10,100,1000,10000,100000] [--iterations N] [--out FILE]\n";
+}
+
+}  // namespace
+
+int main(int argc, const char* argv[]) {
+    std::vector<size_t> sizes = {10, 100, 1000, 10000, 100000};
+    size_t iterations = 0;
+    std::string outPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sizes" && i + 1 < argc) {
+            sizes = parse_sizes(argv[++i]);
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--out" && i + 1 < argc) {
+            outPath = argv[++i];
+        } else {
+            print_usage();
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        print_usage();
+        return 1;
+    }
+
+    try {
+        std::vector<BenchResult> results;
+        for (size_t n : sizes) {
+            run_size(n, iterations, results);
+        }
+        print_summary(results);
+
+        std::string json = to_json(results) + "\n";
+        if (outPath.empty()) {
+            std::cout << json;
+        } else {
+            std::ofstream out(outPath, std::ios::binary);
+            out << json;
+            if (!out) {
+                std::cerr << "Error: cannot write " << outPath << "\n";
+                return 1;
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,86 @@
+#include "synthetic_config.h"
+
+#include "../src/utils/json_writer.h"
+
+namespace picoforge {
+namespace bench {
+
+namespace {
+constexpr int kTypeCount = 7;
+
+void write_module(JsonWriter& w, size_t index) {
+    int i = static_cast<int>(index % 1000000);
+    int pin = i % 26;  // keeps every pin, including ADC-adjacent ones, in range
+
+    w.beginObject().key("type");
+    switch (i % kTypeCount) {
+        case 0:
+            w.value("gpio").key("config").beginObject()
+             .key("pin").value(pin).key("direction").value(i % 2 ? "input" : "output")
+             .key("pull").value(i % 3 == 0 ? "up" : "none").endObject();
+            break;
+        case 1:
+            w.value("pwm").key("config").beginObject()
+             .key("pin").value(pin).key("freq_hz").value(1000 + i % 50000)
+             .key("duty_pct").value((i % 100) + 0.5).endObject();
+            break;
+        case 2:
+            w.value("timer").key("config").beginObject()
+             .key("id").value("t" + std::to_string(i)).key("interval_ms").value(1 + i % 1000)
+             .key("periodic").value(true).key("callback").value("on_tick_" + std::to_string(i)).endObject();
+            break;
+        case 3:
+            w.value("uart").key("config").beginObject()
+             .key("id").value(i % 2).key("baud").value(115200)
+             .key("tx_pin").value(pin).key("rx_pin").value((pin + 1) % 26)
+             .key("parity").value("none").endObject();
+            break;
+        case 4:
+            w.value("i2c").key("config").beginObject()
+             .key("id").value(i % 2).key("sda").value(pin).key("scl").value((pin + 1) % 26)
+             .key("speed_hz").value(400000).endObject();
+            break;
+        case 5:
+            w.value("spi").key("config").beginObject()
+             .key("id").value(i % 2).key("sck").value(pin).key("mosi").value((pin + 1) % 26)
+             .key("miso").value((pin + 2) % 26).key("speed_hz").value(1000000)
+             .key("mode").value(i % 4).endObject();
+            break;
+        default:
+            w.value("adc").key("config").beginObject()
+             .key("pin").value(26 + i % 3).key("samples").value(1 + i % 64).endObject();
+            break;
+    }
+    w.endObject();
+}
+
+void insert_after_marker(std::string& source, const std::string& marker, const std::string& text) {
+    auto pos = source.find(marker);
+    if (pos == std::string::npos) return;
+    pos = source.find('\n', pos);
+    if (pos == std::string::npos) return;
+    source.insert(pos + 1, text);
+}
+}  // namespace
+
+std::string syntheticConfig(size_t modules) {
+    JsonWriter w;
+    w.beginObject().key("project_name").value("bench_" + std::to_string(modules));
+    w.key("modules").beginArray();
+    for (size_t i = 0; i < modules; ++i) {
+        write_module(w, i);
+    }
+    w.endArray().endObject();
+    return w.take();
+}
+
+std::string withUserCode(const std::string& mainSource) {
+    std::string source = mainSource;
+    insert_after_marker(source, "[USER_CODE] includes", "#include \"sensors.h\"\n#include \"display.h\"\n");
+    insert_after_marker(source, "[USER_CODE] main_loop",
+                        "    sensors_poll();\n    display_refresh();\n    sleep_ms(10);\n");
+    return source;
+}
+
+}  // namespace bench
+}  // namespace picoforge
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace picoforge {
+namespace bench {
+
+// Deterministic config document with `modules` instances in the tagged
+// "modules" layout, cycling through gpio/pwm/timer/uart/i2c/spi/adc with
+// in-range values so every instance passes validate().
+std::string syntheticConfig(size_t modules);
+
+// Fills the [USER_CODE] blocks of a composed main.cpp with a few lines of
+// hand-written code, as an existing project on disk would have.
+std::string withUserCode(const std::string& mainSource);
+
+}  // namespace bench
+}  // namespace picoforge
@@ -35,9 +35,8 @@ namespace picoforge {
     /**
      * @brief Initialize PicoForge system
      * 
-     * Registers all built-in modules and prepares the system for use.
+     * Built-in modules are resolved through the compile-time registry, so
+     * there is nothing left to set up; kept for API compatibility.
      */
-    inline void initialize() {
-        registerAllModules();
-    }
+    inline void initialize() {}
 }
@@ -2,7 +2,7 @@
 
 namespace picoforge {
 
-constexpr auto kVersion = "1.0.0";
+constexpr auto kVersion = "1.1.1";  // part of every cache key; bump when generated output changes
 constexpr auto kDefaultLogLevel = "INFO";
 constexpr auto kModulePluginsDir = "plugins";
 
@@ -1,50 +1,351 @@
 #include "config_parser.h"
 
-#include <fstream>
-#include <sstream>
+#include <stdexcept>
 
 #include "../modules/gpio_module.h"
 #include "../modules/pwm_module.h"
 #include "../modules/timer_module.h"
 #include "../modules/adc_module.h"
+#include "../modules/uart_module.h"
+#include "../modules/i2c_module.h"
+#include "../modules/spi_module.h"
+#include "../modules/pio_module.h"
+#include "../modules/dma_module.h"
+#include "../modules/multicore_module.h"
+#include "../utils/file_utils.h"
+#include "../utils/profiler.h"
 
 namespace picoforge {
 
 namespace {
-std::string read_file(const std::string& path) {
-    std::ifstream ifs(path);
-    std::ostringstream ss;
-    ss << ifs.rdbuf();
-    return ss.str();
+// Parsing copies every string it keeps, so the mapping can go once parsing is done.
+MappedFile read_file(const std::string& path) {
+    auto file = FileUtils::mapFile(path);
+    if (!file.isOpen()) {
+        throw std::runtime_error("cannot open config file: " + path);
+    }
+    return file;
 }
 
-bool has_substr(const std::string& str, const std::string& sub) {
-    return str.find(sub) != std::string::npos;
+std::string read_text(JsonReader& r) {
+    auto raw = r.readString();
+    if (raw.find('\\') == std::string_view::npos) {
+        return std::string(raw);
+    }
+    return JsonReader::unescape(raw);
 }
+
+// Multi-line text: one string, or an array of lines joined with '\n'.
+std::string read_source(JsonReader& r) {
+    if (r.peek() != JsonReader::Kind::Array) return read_text(r);
+    std::string text;
+    r.beginArray();
+    while (r.nextElement()) text.append(read_text(r)).append("\n");
+    return text;
 }
 
-ModuleList ConfigParser::parseFile(const std::string& filepath) {
-    return parseString(read_file(filepath));
+std::string normalize_direction(std::string dir) {
+    if (dir == "out") return "output";
+    if (dir == "in") return "input";
+    return dir;
 }
 
-ModuleList ConfigParser::parseString(const std::string& json_str) {
-    ModuleList modules;
-    
-    // Lightweight parser stub - production would use nlohmann/json
-    if (has_substr(json_str, "\"gpio\"")) {
-        modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "none"}));
+// Per-type field readers. Both the canonical struct field names and the
+// aliases used by the editor-exported layout are accepted; unknown keys are skipped.
+void read_field(GpioConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "pin") c.pin = r.readInt();
+    else if (key == "direction") c.direction = normalize_direction(read_text(r));
+    else if (key == "pull") c.pull = read_text(r);
+    else r.skipValue();
+}
+
+void read_field(PwmConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "pin") c.pin = r.readInt();
+    else if (key == "freq_hz" || key == "frequency") c.freq_hz = r.readInt();
+    else if (key == "duty_pct" || key == "duty_cycle") c.duty_pct = r.readNumber();
+    else r.skipValue();
+}
+
+void read_field(TimerConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "id") c.id = read_text(r);
+    else if (key == "interval_ms") c.interval_ms = r.readInt();
+    else if (key == "periodic") c.periodic = r.readBool();
+    else if (key == "type") c.periodic = r.readString() == "periodic";
+    else if (key == "callback") c.callback = read_text(r);
+    else r.skipValue();
+}
+
+void read_field(AdcConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "pin") c.pin = r.readInt();
+    else if (key == "samples") c.samples = r.readInt();
+    else if (key == "temperature" || key == "read_temp") c.temperature = r.readBool();
+    else if (key == "channel") {
+        int ch = r.readInt();
+        if (ch == 4) c.temperature = true;  // ADC input 4 is the on-die sensor
+        else c.pin = 26 + ch;
     }
-    if (has_substr(json_str, "\"pwm\"")) {
-        modules.push_back(std::make_shared<PwmModule>(PwmConfig{2, 1000, 50.0}));
+    else if (key == "mode") c.capture.enabled = read_text(r) == "capture";
+    else if (key == "capture") c.capture.enabled = r.readBool();
+    else if (key == "inputs") {
+        r.beginArray();
+        while (r.nextElement()) c.capture.inputs.push_back(r.readInt());
     }
-    if (has_substr(json_str, "\"timers\"")) {
-        modules.push_back(std::make_shared<TimerModule>(TimerConfig{"heartbeat", 500, true, "on_heartbeat"}));
+    else if (key == "sample_rate" || key == "sample_rate_hz") c.capture.sample_rate_hz = r.readInt();
+    else if (key == "block_samples") c.capture.block_samples = r.readInt();
+    else if (key == "dma_channel") c.capture.dma_channel = r.readInt();
+    else if (key == "chain_channel") c.capture.chain_channel = r.readInt();
+    else if (key == "irq_line") c.capture.irq_line = r.readInt();
+    else if (key == "filter") c.capture.filter.type = read_text(r);
+    else if (key == "bandwidth" || key == "bandwidth_hz") c.capture.filter.bandwidth_hz = r.readInt();
+    else if (key == "decimation") c.capture.filter.decimation = r.readInt();
+    else if (key == "filter_order") c.capture.filter.order = r.readInt();
+    else r.skipValue();
+}
+
+void read_field(UartConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "id" || key == "instance") c.id = r.readInt();
+    else if (key == "baud" || key == "baud_rate") c.baud = r.readInt();
+    else if (key == "tx_pin") c.tx_pin = r.readInt();
+    else if (key == "rx_pin") c.rx_pin = r.readInt();
+    else if (key == "parity") c.parity = read_text(r);
+    else r.skipValue();
+}
+
+void read_field(I2cConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "id" || key == "instance") c.id = r.readInt();
+    else if (key == "sda" || key == "sda_pin") c.sda = r.readInt();
+    else if (key == "scl" || key == "scl_pin") c.scl = r.readInt();
+    else if (key == "speed_hz" || key == "speed") c.speed_hz = r.readInt();
+    else if (key == "pullups") c.pullups = r.readBool();
+    else r.skipValue();
+}
+
+void read_field(SpiConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "id" || key == "instance") c.id = r.readInt();
+    else if (key == "sck" || key == "sck_pin") c.sck = r.readInt();
+    else if (key == "mosi" || key == "mosi_pin") c.mosi = r.readInt();
+    else if (key == "miso" || key == "miso_pin") c.miso = r.readInt();
+    else if (key == "speed_hz" || key == "speed") c.speed_hz = r.readInt();
+    else if (key == "mode") c.mode = r.readInt();
+    else r.skipValue();
+}
+
+void read_field(PioConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "name") c.name = read_text(r);
+    else if (key == "preset") c.preset = read_text(r);
+    else if (key == "sm_count") c.sm_count = r.readInt();
+    else if (key == "data_pin" || key == "pin") c.data_pin = r.readInt();
+    else if (key == "block") c.block = r.readInt();
+    else if (key == "sm") c.sm = r.readInt();
+    else if (key == "offset") c.offset = r.readInt();
+    else if (key == "program_length") c.program_length = r.readInt();
+    else if (key == "program" || key == "source") c.program = read_source(r);
+    else if (key == "led_count" || key == "num_leds") c.led_count = r.readInt();
+    else if (key == "rgbw") c.rgbw = r.readBool();
+    else if (key == "freq_hz" || key == "frequency") c.freq_hz = r.readInt();
+    else if (key == "dma_channel") c.dma_channel = r.readInt();
+    else if (key == "irq_line") c.irq_line = r.readInt();
+    else r.skipValue();
+}
+
+void read_field(DmaConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "channel") c.channel = r.readInt();
+    else if (key == "data_size") c.data_size = r.readInt();
+    else if (key == "src_inc") c.src_inc = r.readBool();
+    else if (key == "dst_inc") c.dst_inc = r.readBool();
+    else if (key == "dreq") c.dreq = read_text(r);
+    else if (key == "src") c.stream.src = read_text(r);
+    else if (key == "dst") c.stream.dst = read_text(r);
+    else if (key == "transfer_count" || key == "count") c.stream.transfer_count = r.readInt();
+    else if (key == "ring_bits") c.stream.ring_bits = r.readInt();
+    else if (key == "ping_pong") c.stream.ping_pong = r.readBool();
+    else if (key == "chain_channel") c.stream.chain_channel = r.readInt();
+    else if (key == "irq") c.stream.irq = r.readBool();
+    else if (key == "irq_line") c.stream.irq_line = r.readInt();
+    else r.skipValue();
+}
+
+void read_field(MulticoreConfig& c, std::string_view key, JsonReader& r) {
+    if (key == "enable") c.enable = r.readBool();
+    else if (key == "core1_entry") c.core1_entry = read_text(r);
+    else r.skipValue();
+}
+
+// Parsed modules land either in a ModuleList (one shared_ptr each) or
+// directly in a ModuleStore; the readers are written once for both.
+template <typename Module>
+void append(ModuleList& out, Module&& module) {
+    out.push_back(std::make_shared<Module>(std::forward<Module>(module)));
+}
+
+template <typename Module>
+void append(ModuleStore& out, Module&& module) {
+    out.add(std::forward<Module>(module));
+}
+
+template <typename Module, typename Config, typename Sink>
+void read_module(JsonReader& r, Sink& out) {
+    Config cfg;
+    std::string_view key;
+    r.beginObject();
+    while (r.nextKey(key)) {
+        read_field(cfg, key, r);
     }
-    if (has_substr(json_str, "\"adc\"")) {
-        modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 4, false}));
+    append(out, Module(std::move(cfg)));
+}
+
+struct ModuleReader {
+    std::string_view type;
+    void (*intoList)(JsonReader&, ModuleList&);
+    void (*intoStore)(JsonReader&, ModuleStore&);
+};
+
+template <typename Module, typename Config>
+constexpr ModuleReader reader(std::string_view type) {
+    return {type, read_module<Module, Config, ModuleList>, read_module<Module, Config, ModuleStore>};
+}
+
+constexpr ModuleReader kReaders[] = {
+    reader<GpioModule, GpioConfig>("gpio"),
+    reader<PwmModule, PwmConfig>("pwm"),
+    reader<TimerModule, TimerConfig>("timer"),
+    reader<TimerModule, TimerConfig>("timers"),
+    reader<AdcModule, AdcConfig>("adc"),
+    reader<UartModule, UartConfig>("uart"),
+    reader<I2cModule, I2cConfig>("i2c"),
+    reader<SpiModule, SpiConfig>("spi"),
+    reader<PioModule, PioConfig>("pio"),
+    reader<DmaModule, DmaConfig>("dma"),
+    reader<MulticoreModule, MulticoreConfig>("multicore"),
+};
+
+const ModuleReader* find_reader(std::string_view type) {
+    for (const auto& reader : kReaders) {
+        if (reader.type == type) return &reader;
     }
-    
-    return modules;
+    return nullptr;
+}
+
+void read_into(const ModuleReader& reader, JsonReader& r, ModuleList& out) { reader.intoList(r, out); }
+void read_into(const ModuleReader& reader, JsonReader& r, ModuleStore& out) { reader.intoStore(r, out); }
+
+// A type section is either one instance object or an array of them.
+template <typename Sink>
+void read_section(JsonReader& r, const ModuleReader& reader, Sink& out) {
+    if (r.peek() == JsonReader::Kind::Object) {
+        read_into(reader, r, out);
+        return;
+    }
+    if (r.peek() != JsonReader::Kind::Array) {
+        r.fail("module section must be an object or an array");
+    }
+    r.beginArray();
+    while (r.nextElement()) {
+        read_into(reader, r, out);
+    }
+}
+
+// Tagged entry: { "type": "...", "config": {...} }. "config" is parsed in place
+// when "type" precedes it; otherwise its span is remembered and parsed once the type is known.
+template <typename Sink>
+void read_tagged_entry(JsonReader& r, Sink& out) {
+    const ModuleReader* reader = nullptr;
+    bool typeSeen = false;
+    bool hasConfig = false;
+    std::string_view deferred;
+    std::string_view key;
+
+    r.beginObject();
+    while (r.nextKey(key)) {
+        if (key == "type") {
+            auto type = r.readString();
+            reader = find_reader(type);
+            typeSeen = true;
+        } else if (key == "config") {
+            hasConfig = true;
+            if (typeSeen && reader) read_into(*reader, r, out);
+            else if (typeSeen) r.skipValue();
+            else deferred = r.skipValue();
+        } else {
+            r.skipValue();
+        }
+    }
+
+    if (!typeSeen) r.fail("module entry is missing \"type\"");
+    if (!reader) return;  // unknown module types are ignored
+    if (!deferred.empty()) {
+        JsonReader sub(deferred);
+        read_into(*reader, sub, out);
+    } else if (!hasConfig) {
+        JsonReader sub("{}");
+        read_into(*reader, sub, out);
+    }
+}
+
+template <typename Sink>
+void read_tagged_modules(JsonReader& r, Sink& out) {
+    r.beginArray();
+    while (r.nextElement()) {
+        read_tagged_entry(r, out);
+    }
+}
+
+void read_project_block(JsonReader& r, std::string& name) {
+    std::string_view key;
+    r.beginObject();
+    while (r.nextKey(key)) {
+        if (key == "name") name = read_text(r);
+        else r.skipValue();
+    }
+}
+
+// Project is ProjectConfig or ProjectStore: anything with .name and .modules.
+template <typename Project>
+void read_project(std::string_view json_str, Project& project) {
+    PF_PROFILE_SCOPE("parse");
+    JsonReader r(json_str);
+    std::string_view key;
+
+    r.beginObject();
+    while (r.nextKey(key)) {
+        if (key == "modules") {
+            read_tagged_modules(r, project.modules);
+        } else if (key == "project_name") {
+            project.name = read_text(r);
+        } else if (key == "project" && r.peek() == JsonReader::Kind::Object) {
+            read_project_block(r, project.name);
+        } else if (auto reader = find_reader(key)) {
+            read_section(r, *reader, project.modules);
+        } else {
+            r.skipValue();
+        }
+    }
+    r.expectEnd();
+}
+}  // namespace
+
+ModuleList ConfigParser::parseFile(const std::string& filepath) {
+    return parseProjectString(read_file(filepath).view()).modules;
+}
+
+ModuleList ConfigParser::parseString(const std::string& json_str) {
+    return parseProjectString(json_str).modules;
+}
+
+ProjectConfig ConfigParser::parseProjectFile(const std::string& filepath) {
+    return parseProjectString(read_file(filepath).view());
+}
+
+ProjectConfig ConfigParser::parseProjectString(std::string_view json_str) {
+    ProjectConfig project;
+    read_project(json_str, project);
+    return project;
+}
+
+ProjectStore ConfigParser::parseProjectStoreString(std::string_view json_str) {
+    ProjectStore project;
+    read_project(json_str, project);
+    return project;
 }
 
 }  // namespace picoforge
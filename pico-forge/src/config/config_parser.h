@@ -4,13 +4,34 @@
 #include <vector>
 
 #include "../core/module.h"
+#include "../core/module_store.h"
+#include "json_reader.h"
 
 namespace picoforge {
 
+struct ProjectConfig {
+    std::string name;
+    ModuleList modules;
+};
+
+// Same project, parsed straight into contiguous value storage.
+struct ProjectStore {
+    std::string name;
+    ModuleStore modules;
+};
+
+// Single-pass config reader. Accepts both layouts we ship:
+//   { "gpio": [ {...}, ... ], "pwm": [...], ... }              (per-type arrays)
+//   { "modules": [ { "type": "gpio", "config": {...} }, ... ] } (tagged entries)
+// Throws ConfigParseError on malformed JSON.
 class ConfigParser {
 public:
     static ModuleList parseFile(const std::string& filepath);
     static ModuleList parseString(const std::string& json_str);
+
+    static ProjectConfig parseProjectFile(const std::string& filepath);
+    static ProjectConfig parseProjectString(std::string_view json_str);
+    static ProjectStore parseProjectStoreString(std::string_view json_str);
 };
 
 }  // namespace picoforge
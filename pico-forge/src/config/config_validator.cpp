@@ -1,7 +1,128 @@
 #include "config_validator.h"
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+
+#include "../utils/profiler.h"
+
 namespace picoforge {
 
+namespace {
+// Every resource kind fits in 32 units; one occupancy bitset and owner table per kind.
+constexpr size_t kMaxUnits = 32;
+
+struct Occupancy {
+    std::array<std::bitset<kMaxUnits>, kResourceKindCount> used;
+    std::array<std::array<size_t, kMaxUnits>, kResourceKindCount> owner{};
+    std::array<std::bitset<kMaxUnits>, kResourceKindCount> shared;  // every holder so far claimed it shared
+
+    bool taken(ResourceKind kind, int index) const { return used[static_cast<size_t>(kind)].test(static_cast<size_t>(index)); }
+    size_t holder(ResourceKind kind, int index) const { return owner[static_cast<size_t>(kind)][static_cast<size_t>(index)]; }
+    bool sharedBy(ResourceKind kind, int index) const { return shared[static_cast<size_t>(kind)].test(static_cast<size_t>(index)); }
+    void take(ResourceKind kind, int index, size_t module, bool isShared = false) {
+        used[static_cast<size_t>(kind)].set(static_cast<size_t>(index));
+        shared[static_cast<size_t>(kind)].set(static_cast<size_t>(index), isShared);
+        owner[static_cast<size_t>(kind)][static_cast<size_t>(index)] = module;
+    }
+};
+
+struct PendingClaim {
+    size_t module;
+    ResourceClaim claim;
+};
+
+std::string describe_unit(ResourceKind kind, int index) {
+    switch (kind) {
+        case ResourceKind::PioStateMachine:
+            return "pio" + std::to_string(index / 4) + " SM" + std::to_string(index % 4);
+        case ResourceKind::PwmSlice: return "PWM slice " + std::to_string(index);
+        case ResourceKind::Uart: return "uart" + std::to_string(index);
+        case ResourceKind::I2c: return "i2c" + std::to_string(index);
+        case ResourceKind::Spi: return "spi" + std::to_string(index);
+        case ResourceKind::Adc: return "the ADC";
+        default: return std::string(resourceKindName(kind)) + " " + std::to_string(index);
+    }
+}
+}  // namespace
+
+ResourceReport ConfigValidator::validateAll(const ModuleList& modules) {
+    ResourceReport report;
+    Occupancy occupancy;
+    std::vector<PendingClaim> anyClaims;
+    ResourceClaims claims;
+
+    // Pass 1: per-module checks and fixed claims, in config order.
+    for (size_t i = 0; i < modules.size(); ++i) {
+        const auto& m = *modules[i];
+        PF_PROFILE_SCOPE_DETAIL("validate", m.id());
+
+        if (!m.validate()) {
+            ResourceDiagnostic d;
+            d.kind = ResourceDiagnostic::Kind::InvalidModule;
+            d.module = i;
+            d.moduleId = m.id();
+            d.message = "module " + d.moduleId + " has an invalid configuration";
+            report.diagnostics.push_back(std::move(d));
+        }
+
+        claims.clear();
+        m.claimResources(claims);
+        for (const auto& c : claims.all()) {
+            if (c.index < 0) {
+                anyClaims.push_back(PendingClaim{i, c});
+                continue;
+            }
+            // Out-of-range indices are already reported by validate().
+            if (c.index >= resourceCapacity(c.kind)) continue;
+            if (!occupancy.taken(c.kind, c.index)) {
+                occupancy.take(c.kind, c.index, i, c.shared);
+                continue;
+            }
+            if (c.shared && occupancy.sharedBy(c.kind, c.index)) continue;
+
+            size_t holder = occupancy.holder(c.kind, c.index);
+            if (holder == i) continue;  // overlaps within one module are validate()'s job
+            ResourceDiagnostic d;
+            d.kind = ResourceDiagnostic::Kind::Conflict;
+            d.resource = c.kind;
+            d.index = c.index;
+            d.module = i;
+            d.holder = holder;
+            d.moduleId = m.id();
+            d.holderId = modules[holder]->id();
+            d.message = describe_unit(c.kind, c.index) + " is used by both " + d.holderId + " and " +
+                        d.moduleId + " (" + c.role + ")";
+            report.diagnostics.push_back(std::move(d));
+        }
+    }
+
+    // Pass 2: "any" claims take the lowest free unit in their range.
+    for (const auto& pending : anyClaims) {
+        const auto& c = pending.claim;
+        int end = std::min(c.first + c.span, resourceCapacity(c.kind));
+        int found = -1;
+        for (int unit = c.first; unit < end && found < 0; ++unit) {
+            if (!occupancy.taken(c.kind, unit)) found = unit;
+        }
+        if (found >= 0) {
+            occupancy.take(c.kind, found, pending.module);
+            report.assignments.push_back(ResourceAssignment{pending.module, c.kind, found, c.role});
+            continue;
+        }
+
+        ResourceDiagnostic d;
+        d.kind = ResourceDiagnostic::Kind::Exhausted;
+        d.resource = c.kind;
+        d.module = pending.module;
+        d.moduleId = modules[pending.module]->id();
+        d.message = std::string("no free ") + resourceKindName(c.kind) + " left for " + d.moduleId;
+        report.diagnostics.push_back(std::move(d));
+    }
+
+    return report;
+}
+
 ValidationResult ConfigValidator::validatePinNumber(int pin) {
     ValidationResult result;
     
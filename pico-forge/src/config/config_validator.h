@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 
+#include "../core/module.h"
 #include "../utils/error_codes.h"
 
 namespace picoforge {
@@ -21,8 +22,47 @@ struct ValidationResult {
     }
 };
 
+// One problem found by ConfigValidator::validateAll. Module positions index
+// the ModuleList that was validated.
+struct ResourceDiagnostic {
+    enum class Kind {
+        InvalidModule,  // validate() returned false
+        Conflict,       // fixed claim on a unit another module already holds
+        Exhausted,      // "any" claim with no free unit left in its range
+    };
+
+    Kind kind = Kind::InvalidModule;
+    ResourceKind resource = ResourceKind::Gpio;
+    int index = -1;              // contested unit (Conflict only)
+    size_t module = 0;
+    size_t holder = 0;           // module that already held it (Conflict only)
+    std::string moduleId;
+    std::string holderId;
+    std::string message;
+};
+
+// Where an "any" claim landed.
+struct ResourceAssignment {
+    size_t module = 0;
+    ResourceKind resource = ResourceKind::Gpio;
+    int index = 0;
+    const char* role = "";
+};
+
+struct ResourceReport {
+    std::vector<ResourceDiagnostic> diagnostics;
+    std::vector<ResourceAssignment> assignments;
+
+    bool ok() const { return diagnostics.empty(); }
+};
+
 class ConfigValidator {
 public:
+    // Checks every module and the hardware they claim in one linear sweep,
+    // reporting all problems rather than stopping at the first. Fixed claims
+    // are placed first; "any" claims then take the lowest free unit.
+    static ResourceReport validateAll(const ModuleList& modules);
+
     static ValidationResult validatePinNumber(int pin);
     static ValidationResult validateFrequency(int freq, int min, int max);
     static ValidationResult validateBaudRate(int baud);
@@ -0,0 +1,277 @@
+#include "json_reader.h"
+
+#include <charconv>
+#include <cmath>
+
+namespace picoforge {
+
+namespace {
+constexpr int kMaxDepth = 256;
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void append_utf8(std::string& out, unsigned cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+}  // namespace
+
+void JsonReader::fail(const std::string& message) const {
+    size_t line = 1;
+    size_t column = 1;
+    for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+        if (text_[i] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+    }
+    throw ConfigParseError(message, line, column);
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        ++pos_;
+    }
+}
+
+bool JsonReader::consume(char c) {
+    skipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+        ++pos_;
+        return true;
+    }
+    return false;
+}
+
+void JsonReader::expect(char c) {
+    if (!consume(c)) {
+        fail(std::string("expected '") + c + "'");
+    }
+}
+
+JsonReader::Kind JsonReader::peek() {
+    skipWhitespace();
+    if (pos_ >= text_.size()) return Kind::End;
+    switch (text_[pos_]) {
+        case '{': return Kind::Object;
+        case '[': return Kind::Array;
+        case '"': return Kind::String;
+        case 't':
+        case 'f': return Kind::Bool;
+        case 'n': return Kind::Null;
+        default: break;
+    }
+    if (text_[pos_] == '-' || is_digit(text_[pos_])) return Kind::Number;
+    fail(std::string("unexpected character '") + text_[pos_] + "'");
+}
+
+void JsonReader::beginObject() {
+    expect('{');
+    if (++depth_ > kMaxDepth) fail("nesting too deep");
+    last_ = '{';
+}
+
+bool JsonReader::nextKey(std::string_view& key) {
+    bool first = last_ == '{';
+    if (consume('}')) {
+        --depth_;
+        last_ = '\0';
+        return false;
+    }
+    if (!first) expect(',');
+    key = readString();
+    expect(':');
+    return true;
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+    if (++depth_ > kMaxDepth) fail("nesting too deep");
+    last_ = '[';
+}
+
+bool JsonReader::nextElement() {
+    bool first = last_ == '[';
+    if (consume(']')) {
+        --depth_;
+        last_ = '\0';
+        return false;
+    }
+    if (!first) expect(',');
+    last_ = '\0';
+    return true;
+}
+
+std::string_view JsonReader::readString() {
+    expect('"');
+    size_t start = pos_;
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c == '"') {
+            last_ = '\0';
+            return text_.substr(start, pos_++ - start);
+        }
+        if (c == '\\') {
+            ++pos_;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fail("control character in string");
+        }
+        ++pos_;
+    }
+    fail("unterminated string");
+}
+
+std::string_view JsonReader::scanNumber() {
+    skipWhitespace();
+    size_t start = pos_;
+    if (pos_ < text_.size() && text_[pos_] == '-') ++pos_;
+    if (pos_ >= text_.size() || !is_digit(text_[pos_])) fail("invalid number");
+    if (text_[pos_] == '0') {
+        ++pos_;
+    } else {
+        while (pos_ < text_.size() && is_digit(text_[pos_])) ++pos_;
+    }
+    if (pos_ < text_.size() && text_[pos_] == '.') {
+        ++pos_;
+        if (pos_ >= text_.size() || !is_digit(text_[pos_])) fail("invalid number");
+        while (pos_ < text_.size() && is_digit(text_[pos_])) ++pos_;
+    }
+    if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+        ++pos_;
+        if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) ++pos_;
+        if (pos_ >= text_.size() || !is_digit(text_[pos_])) fail("invalid number");
+        while (pos_ < text_.size() && is_digit(text_[pos_])) ++pos_;
+    }
+    last_ = '\0';
+    return text_.substr(start, pos_ - start);
+}
+
+double JsonReader::readNumber() {
+    auto token = scanNumber();
+    double value = 0.0;
+    auto res = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (res.ec != std::errc()) fail("number out of range");
+    return value;
+}
+
+int JsonReader::readInt() {
+    auto token = scanNumber();
+    int value = 0;
+    auto res = std::from_chars(token.data(), token.data() + token.size(), value);
+    if (res.ec == std::errc() && res.ptr == token.data() + token.size()) {
+        return value;
+    }
+    // Accept integral values written with a fraction or exponent (e.g. 1e3).
+    double d = 0.0;
+    auto dres = std::from_chars(token.data(), token.data() + token.size(), d);
+    if (dres.ec != std::errc() || d != std::floor(d) || d < -2147483648.0 || d > 2147483647.0) {
+        fail("expected an integer");
+    }
+    return static_cast<int>(d);
+}
+
+void JsonReader::skipLiteral(std::string_view word) {
+    skipWhitespace();
+    if (text_.substr(pos_, word.size()) != word) {
+        fail("invalid literal");
+    }
+    pos_ += word.size();
+    last_ = '\0';
+}
+
+bool JsonReader::readBool() {
+    if (peek() != Kind::Bool) fail("expected a boolean");
+    if (text_[pos_] == 't') {
+        skipLiteral("true");
+        return true;
+    }
+    skipLiteral("false");
+    return false;
+}
+
+void JsonReader::readNull() {
+    skipLiteral("null");
+}
+
+std::string_view JsonReader::skipValue() {
+    skipWhitespace();
+    size_t start = pos_;
+    std::string_view key;
+    switch (peek()) {
+        case Kind::Object:
+            beginObject();
+            while (nextKey(key)) skipValue();
+            break;
+        case Kind::Array:
+            beginArray();
+            while (nextElement()) skipValue();
+            break;
+        case Kind::String: readString(); break;
+        case Kind::Number: scanNumber(); break;
+        case Kind::Bool: readBool(); break;
+        case Kind::Null: readNull(); break;
+        case Kind::End: fail("unexpected end of input");
+    }
+    return text_.substr(start, pos_ - start);
+}
+
+void JsonReader::expectEnd() {
+    if (peek() != Kind::End) fail("trailing characters after document");
+}
+
+std::string JsonReader::unescape(std::string_view raw) {
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) {
+            out += c;
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                unsigned cp = 0;
+                for (int k = 0; k < 4 && i + 1 < raw.size(); ++k) {
+                    int h = hex_value(raw[++i]);
+                    cp = (cp << 4) | static_cast<unsigned>(h < 0 ? 0 : h);
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default: out += e; break;  // \" \\ \/
+        }
+    }
+    return out;
+}
+
+}  // namespace picoforge
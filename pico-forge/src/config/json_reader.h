@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+class ConfigParseError : public std::runtime_error {
+public:
+    ConfigParseError(const std::string& message, size_t line, size_t column)
+        : std::runtime_error(message + " at line " + std::to_string(line) +
+                             ", column " + std::to_string(column)),
+          line_(line), column_(column) {}
+
+    size_t line() const { return line_; }
+    size_t column() const { return column_; }
+
+private:
+    size_t line_;
+    size_t column_;
+};
+
+// Pull-style JSON tokenizer over a borrowed buffer.
+// Walks the input exactly once and hands out string_view tokens; no DOM is built.
+class JsonReader {
+public:
+    enum class Kind { Object, Array, String, Number, Bool, Null, End };
+
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    Kind peek();
+
+    void beginObject();
+    // Advances to the next key of the current object; false once '}' is consumed.
+    bool nextKey(std::string_view& key);
+
+    void beginArray();
+    // Positions on the next element of the current array; false once ']' is consumed.
+    bool nextElement();
+
+    // Raw string contents between the quotes (escape sequences left intact).
+    std::string_view readString();
+    double readNumber();
+    int readInt();
+    bool readBool();
+    void readNull();
+
+    // Skips the next value and returns its raw JSON text.
+    std::string_view skipValue();
+
+    // Fails unless only whitespace remains.
+    void expectEnd();
+
+    [[noreturn]] void fail(const std::string& message) const;
+
+    static std::string unescape(std::string_view raw);
+
+private:
+    void skipWhitespace();
+    bool consume(char c);
+    void expect(char c);
+    std::string_view scanNumber();
+    void skipLiteral(std::string_view word);
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    char last_ = '\0';  // '{' or '[' right after opening a container
+    int depth_ = 0;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,112 @@
+#include "batch_runner.h"
+
+#include <filesystem>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../utils/file_utils.h"
+#include "../utils/string_utils.h"
+
+namespace picoforge {
+
+namespace {
+std::string resolve(const std::string& path, const std::string& baseDir) {
+    std::filesystem::path p(path);
+    if (p.is_absolute() || baseDir.empty()) return path;
+    return (std::filesystem::path(baseDir) / p).lexically_normal().string();
+}
+
+// "out", "./out/" and "out/" name the same directory.
+std::string directory_key(const std::string& dir) {
+    auto p = std::filesystem::path(dir).lexically_normal();
+    return (p.has_filename() ? p : p.parent_path()).string();
+}
+
+BatchEntryResult run_entry(const BatchEntry& entry, const GenerationOptions& options) {
+    BatchEntryResult result;
+    result.entry = entry;
+    try {
+        auto output = GenerationPipeline::generateFile(entry.configPath, options, entry.outputDir);
+        result.files = GenerationPipeline::writeProject(output, entry.outputDir);
+        result.projectName = output.projectName;
+        result.moduleCount = output.moduleCount;
+        result.ok = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    return result;
+}
+}  // namespace
+
+std::vector<BatchEntry> BatchRunner::readManifest(const std::string& manifestPath) {
+    if (!FileUtils::fileExists(manifestPath)) {
+        throw std::runtime_error("cannot open manifest: " + manifestPath);
+    }
+    return parseManifest(FileUtils::readFile(manifestPath), FileUtils::getDirectory(manifestPath));
+}
+
+std::vector<BatchEntry> BatchRunner::parseManifest(const std::string& text, const std::string& baseDir) {
+    std::vector<BatchEntry> entries;
+    std::unordered_map<std::string, size_t> claimedBy;  // output dir -> manifest line
+    std::istringstream in(text);
+    std::string raw;
+    size_t lineNo = 0;
+
+    while (std::getline(in, raw)) {
+        ++lineNo;
+        auto line = StringUtils::trim(raw);
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        BatchEntry entry;
+        entry.line = lineNo;
+        fields >> entry.configPath >> entry.outputDir;
+
+        entry.configPath = resolve(entry.configPath, baseDir);
+        // Configs sharing a directory each get their own subdirectory; entries run
+        // concurrently, so two of them must never write the same files.
+        entry.outputDir = entry.outputDir.empty()
+            ? (std::filesystem::path(entry.configPath).parent_path() /
+               std::filesystem::path(entry.configPath).stem()).string()
+            : resolve(entry.outputDir, baseDir);
+        auto [it, fresh] = claimedBy.emplace(directory_key(entry.outputDir), lineNo);
+        if (!fresh) {
+            throw std::runtime_error("manifest line " + std::to_string(lineNo) + ": output directory " +
+                                     entry.outputDir + " is already used by line " + std::to_string(it->second));
+        }
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+std::vector<BatchEntryResult> BatchRunner::run(const std::vector<BatchEntry>& entries, ThreadPool& pool,
+                                              const GenerationOptions& options) {
+    // Each task owns exactly one slot, so no locking is needed on the results.
+    std::vector<BatchEntryResult> results(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        pool.submit([&entries, &results, &options, i]() { results[i] = run_entry(entries[i], options); });
+    }
+    pool.waitIdle();
+    return results;
+}
+
+size_t BatchRunner::report(const std::vector<BatchEntryResult>& results, std::ostream& out) {
+    size_t failed = 0;
+    for (const auto& r : results) {
+        if (r.ok) {
+            out << "[OK]   " << r.entry.configPath << " -> " << r.entry.outputDir
+                << " (" << r.projectName << ", " << r.moduleCount << " modules, "
+                << r.files.written << " written, " << r.files.unchanged << " unchanged)\n";
+        } else {
+            ++failed;
+            out << "[FAIL] " << r.entry.configPath << " (manifest line " << r.entry.line
+                << "): " << r.error << "\n";
+        }
+    }
+    out << results.size() - failed << "/" << results.size() << " projects generated\n";
+    return failed;
+}
+
+}  // namespace picoforge
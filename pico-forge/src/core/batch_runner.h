@@ -0,0 +1,44 @@
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "generation_pipeline.h"
+#include "thread_pool.h"
+
+namespace picoforge {
+
+struct BatchEntry {
+    std::string configPath;
+    std::string outputDir;  // defaults to <config dir>/<config stem>
+    size_t line = 0;        // manifest line, for error reports
+};
+
+struct BatchEntryResult {
+    BatchEntry entry;
+    bool ok = false;
+    std::string projectName;
+    size_t moduleCount = 0;
+    WriteReport files;
+    std::string error;
+};
+
+// Runs the generation pipeline for every manifest entry on a shared pool.
+// Results come back in manifest order regardless of completion order.
+class BatchRunner {
+public:
+    // Manifest format: one "<config.json> [output_dir]" per line; blank lines
+    // and '#' comments are ignored. Relative paths resolve against the manifest.
+    // Throws if two entries resolve to the same output directory.
+    static std::vector<BatchEntry> readManifest(const std::string& manifestPath);
+    static std::vector<BatchEntry> parseManifest(const std::string& text, const std::string& baseDir);
+
+    static std::vector<BatchEntryResult> run(const std::vector<BatchEntry>& entries, ThreadPool& pool,
+                                             const GenerationOptions& options = {});
+
+    // Writes one line per entry; returns the number of failed entries.
+    static size_t report(const std::vector<BatchEntryResult>& results, std::ostream& out);
+};
+
+}  // namespace picoforge
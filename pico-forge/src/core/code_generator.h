@@ -9,6 +9,15 @@ namespace picoforge {
 struct GeneratedCode {
     std::string mainBody;
     std::string headers;
+    std::string definitions;  // file-scope code, between the includes and main()
+};
+
+// Output of a single module: its generateHeaderCode(), generateInitCode() and
+// generateDefinitionsCode().
+struct ModuleFragment {
+    std::string headers;
+    std::string init;
+    std::string definitions;
 };
 
 class ICodeGenerator {
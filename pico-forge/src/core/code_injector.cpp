@@ -1,44 +1,158 @@
 #include "code_injector.h"
 
-#include <regex>
-#include <sstream>
+#include <cctype>
 
 namespace picoforge {
 
-std::map<std::string, std::string> CodeInjector::extractUserBlocks(const std::string& source) {
-    std::map<std::string, std::string> blocks;
-    std::regex pattern(R"(// \[USER_CODE\] (\w+)\n([\s\S]*?)// \[USER_CODE\] END)");
-    
-    auto begin = std::sregex_iterator(source.begin(), source.end(), pattern);
-    auto end = std::sregex_iterator();
-    
-    for (auto it = begin; it != end; ++it) {
-        blocks[(*it)[1].str()] = (*it)[2].str();
+namespace {
+constexpr std::string_view kMarker = "// [USER_CODE] ";
+constexpr std::string_view kEndTag = "END";
+
+struct BlockSpan {
+    std::string_view tag;
+    size_t contentBegin;  // first byte after the start marker line
+    size_t contentEnd;    // first byte of the END marker
+};
+
+bool is_word_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Single forward walk over the buffer. Line numbers are counted incrementally
+// between markers, so the whole scan stays O(n).
+class MarkerScanner {
+public:
+    explicit MarkerScanner(std::string_view text) : text_(text) {}
+
+    std::vector<BlockSpan> scan(std::vector<InjectionDiagnostic>& diagnostics) {
+        std::vector<BlockSpan> spans;
+        bool open = false;
+        BlockSpan current{};
+        size_t openLine = 0;
+
+        size_t pos = text_.find(kMarker);
+        while (pos != std::string_view::npos) {
+            size_t markerLine = lineAt(pos);
+            size_t tagBegin = pos + kMarker.size();
+            size_t tagEnd = tagBegin;
+            while (tagEnd < text_.size() && is_word_char(text_[tagEnd])) ++tagEnd;
+            std::string_view tag = text_.substr(tagBegin, tagEnd - tagBegin);
+
+            if (tag == kEndTag) {
+                if (open) {
+                    current.contentEnd = pos;
+                    spans.push_back(current);
+                    open = false;
+                } else {
+                    diagnostics.push_back({InjectionDiagnostic::Kind::UnmatchedEnd, "", markerLine,
+                                           "END marker without a matching start"});
+                }
+                pos = text_.find(kMarker, tagEnd);
+                continue;
+            }
+
+            size_t eol = tagEnd;
+            if (eol < text_.size() && text_[eol] == '\r') ++eol;
+            bool wellFormed = !tag.empty() && eol < text_.size() && text_[eol] == '\n';
+
+            if (wellFormed && open) {
+                diagnostics.push_back({InjectionDiagnostic::Kind::NestedBlock, std::string(tag), markerLine,
+                                       "block '" + std::string(tag) + "' is nested inside '" +
+                                       std::string(current.tag) + "'"});
+            } else if (wellFormed) {
+                current = BlockSpan{tag, eol + 1, 0};
+                openLine = markerLine;
+                open = true;
+            }
+            pos = text_.find(kMarker, tagEnd);
+        }
+
+        if (open) {
+            diagnostics.push_back({InjectionDiagnostic::Kind::UnterminatedBlock, std::string(current.tag), openLine,
+                                   "block '" + std::string(current.tag) + "' has no END marker"});
+        }
+        return spans;
+    }
+
+private:
+    size_t lineAt(size_t pos) {
+        for (; lineScanPos_ < pos; ++lineScanPos_) {
+            if (text_[lineScanPos_] == '\n') ++line_;
+        }
+        return line_;
     }
-    
-    return blocks;
+
+    std::string_view text_;
+    size_t lineScanPos_ = 0;
+    size_t line_ = 1;
+};
+}  // namespace
+
+UserBlockScan CodeInjector::scanUserBlocks(std::string_view source) {
+    UserBlockScan result;
+    MarkerScanner scanner(source);
+    for (const auto& span : scanner.scan(result.diagnostics)) {
+        std::string tag(span.tag);
+        auto content = source.substr(span.contentBegin, span.contentEnd - span.contentBegin);
+        auto [it, inserted] = result.blocks.emplace(tag, std::string(content));
+        if (!inserted) {
+            result.diagnostics.push_back({InjectionDiagnostic::Kind::DuplicateTag, tag, 0,
+                                          "block '" + tag + "' appears more than once"});
+            it->second.assign(content.data(), content.size());
+        }
+    }
+    return result;
+}
+
+std::map<std::string, std::string> CodeInjector::extractUserBlocks(const std::string& source) {
+    return scanUserBlocks(source).blocks;
 }
 
 std::string CodeInjector::injectUserBlocks(
     const std::string& generated,
-    const std::map<std::string, std::string>& userBlocks
+    const std::map<std::string, std::string>& userBlocks,
+    std::vector<InjectionDiagnostic>* diagnostics
 ) {
-    std::string result = generated;
-    
-    for (const auto& [tag, code] : userBlocks) {
-        std::string marker_start = "// [USER_CODE] " + tag + "\n";
-        std::string marker_end = "// [USER_CODE] END";
-        
-        size_t start_pos = result.find(marker_start);
-        if (start_pos == std::string::npos) continue;
-        
-        start_pos += marker_start.length();
-        size_t end_pos = result.find(marker_end, start_pos);
-        if (end_pos == std::string::npos) continue;
-        
-        result.replace(start_pos, end_pos - start_pos, code);
+    std::vector<InjectionDiagnostic> scanDiagnostics;
+    auto spans = MarkerScanner(generated).scan(scanDiagnostics);
+
+    // Resolve replacements (first occurrence of each tag) and size the output up front.
+    struct Replacement {
+        const BlockSpan* span;
+        const std::string* code;
+    };
+    std::vector<Replacement> replacements;
+    replacements.reserve(spans.size());
+    std::map<std::string_view, bool> used;
+    size_t outSize = generated.size();
+
+    for (const auto& span : spans) {
+        auto it = userBlocks.find(std::string(span.tag));
+        if (it == userBlocks.end() || used[span.tag]) continue;
+        used[span.tag] = true;
+        replacements.push_back({&span, &it->second});
+        outSize = outSize - (span.contentEnd - span.contentBegin) + it->second.size();
+    }
+
+    std::string result;
+    result.reserve(outSize);
+    size_t cursor = 0;
+    for (const auto& r : replacements) {
+        result.append(generated, cursor, r.span->contentBegin - cursor);
+        result.append(*r.code);
+        cursor = r.span->contentEnd;
+    }
+    result.append(generated, cursor, std::string::npos);
+
+    if (diagnostics) {
+        diagnostics->insert(diagnostics->end(), scanDiagnostics.begin(), scanDiagnostics.end());
+        for (const auto& [tag, code] : userBlocks) {
+            if (!used.count(tag)) {
+                diagnostics->push_back({InjectionDiagnostic::Kind::MissingTarget, tag, 0,
+                                        "user block '" + tag + "' has no marker in the generated code"});
+            }
+        }
     }
-    
     return result;
 }
 
@@ -2,18 +2,46 @@
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace picoforge {
 
+struct InjectionDiagnostic {
+    enum class Kind {
+        NestedBlock,        // start marker inside an open block (kept as content)
+        UnterminatedBlock,  // start marker with no END before end of file (block dropped)
+        UnmatchedEnd,       // END marker with no open block
+        DuplicateTag,       // tag seen twice; the later block wins
+        MissingTarget       // user block has no matching marker in the generated code
+    };
+
+    Kind kind;
+    std::string tag;
+    size_t line;  // 1-based line of the offending marker (0 for MissingTarget)
+    std::string message;
+};
+
+struct UserBlockScan {
+    std::map<std::string, std::string> blocks;
+    std::vector<InjectionDiagnostic> diagnostics;
+};
+
 class CodeInjector {
 public:
     // Extract user code blocks marked with [USER_CODE] tags
     static std::map<std::string, std::string> extractUserBlocks(const std::string& source);
+
+    // Same as extractUserBlocks, plus diagnostics for malformed markers.
+    // Walks the source once; never backtracks.
+    static UserBlockScan scanUserBlocks(std::string_view source);
     
-    // Inject user blocks back into generated template
+    // Inject user blocks back into generated template.
+    // Builds the result in one pass into a pre-sized buffer.
     static std::string injectUserBlocks(
         const std::string& generated,
-        const std::map<std::string, std::string>& userBlocks
+        const std::map<std::string, std::string>& userBlocks,
+        std::vector<InjectionDiagnostic>* diagnostics = nullptr
     );
 };
 
@@ -0,0 +1,88 @@
+#include "code_writer.h"
+
+#include <charconv>
+
+namespace picoforge {
+
+void CodeWriter::beginLineIfNeeded() {
+    if (atLineStart_ && indentLevel_ > 0) {
+        buffer_.append(static_cast<size_t>(indentLevel_ * indentWidth_), ' ');
+    }
+    atLineStart_ = false;
+}
+
+void CodeWriter::appendRaw(std::string_view text) {
+    if (text.empty()) return;
+    beginLineIfNeeded();
+    buffer_.append(text.data(), text.size());
+}
+
+CodeWriter& CodeWriter::write(std::string_view text) {
+    if (indentLevel_ == 0) {
+        buffer_.append(text.data(), text.size());
+        if (!text.empty()) atLineStart_ = text.back() == '\n';
+        return *this;
+    }
+
+    // Indented: split on newlines so every new line gets the prefix
+    // (blank lines stay blank).
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t nl = text.find('\n', start);
+        if (nl == std::string_view::npos) {
+            appendRaw(text.substr(start));
+            break;
+        }
+        appendRaw(text.substr(start, nl - start));
+        buffer_ += '\n';
+        atLineStart_ = true;
+        start = nl + 1;
+    }
+    return *this;
+}
+
+CodeWriter& CodeWriter::write(char c) {
+    if (c == '\n') {
+        buffer_ += '\n';
+        atLineStart_ = true;
+    } else {
+        beginLineIfNeeded();
+        buffer_ += c;
+    }
+    return *this;
+}
+
+CodeWriter& CodeWriter::write(long long value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    appendRaw(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+    return *this;
+}
+
+CodeWriter& CodeWriter::write(unsigned long long value) {
+    char buf[24];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    appendRaw(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+    return *this;
+}
+
+CodeWriter& CodeWriter::write(double value) {
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 6);
+    appendRaw(std::string_view(buf, static_cast<size_t>(res.ptr - buf)));
+    return *this;
+}
+
+std::string CodeWriter::take() {
+    std::string out = std::move(buffer_);
+    clear();
+    return out;
+}
+
+void CodeWriter::clear() {
+    buffer_.clear();
+    indentLevel_ = 0;
+    atLineStart_ = true;
+}
+
+}  // namespace picoforge
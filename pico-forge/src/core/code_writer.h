@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// Append-only sink for generated source text. All output lands in one
+// contiguous, geometrically grown buffer; numbers are formatted in place with
+// std::to_chars, so emitting a module costs no allocations beyond buffer growth.
+// Indentation is applied at the start of every line written while indented.
+class CodeWriter {
+public:
+    explicit CodeWriter(size_t reserveBytes = 4096) { buffer_.reserve(reserveBytes); }
+
+    CodeWriter& write(std::string_view text);
+    CodeWriter& write(char c);
+    CodeWriter& write(long long value);
+    CodeWriter& write(unsigned long long value);
+    // Same text as std::ostream's default formatting (%g, 6 significant digits).
+    CodeWriter& write(double value);
+
+    CodeWriter& operator<<(std::string_view text) { return write(text); }
+    CodeWriter& operator<<(const char* text) { return write(std::string_view(text)); }
+    CodeWriter& operator<<(const std::string& text) { return write(std::string_view(text)); }
+    CodeWriter& operator<<(char c) { return write(c); }
+    CodeWriter& operator<<(int value) { return write(static_cast<long long>(value)); }
+    CodeWriter& operator<<(long value) { return write(static_cast<long long>(value)); }
+    CodeWriter& operator<<(long long value) { return write(value); }
+    CodeWriter& operator<<(unsigned value) { return write(static_cast<unsigned long long>(value)); }
+    CodeWriter& operator<<(unsigned long value) { return write(static_cast<unsigned long long>(value)); }
+    CodeWriter& operator<<(unsigned long long value) { return write(value); }
+    CodeWriter& operator<<(double value) { return write(value); }
+    CodeWriter& operator<<(bool) = delete;  // spell out "true"/"false" explicitly
+
+    void indent() { ++indentLevel_; }
+    void dedent() { if (indentLevel_ > 0) --indentLevel_; }
+    void setIndentWidth(int width) { indentWidth_ = width; }
+
+    size_t size() const { return buffer_.size(); }
+    std::string_view view() const { return buffer_; }
+    std::string_view view(size_t offset, size_t length) const { return std::string_view(buffer_).substr(offset, length); }
+
+    // Moves the buffer out; the writer is left empty and reusable.
+    std::string take();
+    void clear();
+
+private:
+    void beginLineIfNeeded();
+    void appendRaw(std::string_view text);
+
+    std::string buffer_;
+    int indentLevel_ = 0;
+    int indentWidth_ = 4;
+    bool atLineStart_ = true;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,51 @@
+#include "config_key.h"
+
+#include <charconv>
+
+namespace picoforge {
+
+ConfigKeyBuilder::ConfigKeyBuilder(std::string_view type) {
+    key_.reserve(64);
+    key_.append(type);
+    key_ += '{';
+}
+
+void ConfigKeyBuilder::name(std::string_view n) {
+    if (!first_) key_ += ',';
+    first_ = false;
+    key_.append(n);
+    key_ += '=';
+}
+
+ConfigKeyBuilder& ConfigKeyBuilder::field(std::string_view n, int value) {
+    name(n);
+    key_ += std::to_string(value);
+    return *this;
+}
+
+ConfigKeyBuilder& ConfigKeyBuilder::field(std::string_view n, double value) {
+    name(n);
+    char buf[32];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);  // shortest round-trip form
+    key_.append(buf, res.ptr);
+    return *this;
+}
+
+ConfigKeyBuilder& ConfigKeyBuilder::field(std::string_view n, bool value) {
+    name(n);
+    key_ += value ? "true" : "false";
+    return *this;
+}
+
+ConfigKeyBuilder& ConfigKeyBuilder::field(std::string_view n, const std::string& value) {
+    name(n);
+    key_ += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') key_ += '\\';
+        key_ += c;
+    }
+    key_ += '"';
+    return *this;
+}
+
+}  // namespace picoforge
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// Builds the canonical text form of a module config, e.g.
+//   gpio{pin=15,direction="output",pull="none"}
+// Two configs that generate different code must never share a key.
+class ConfigKeyBuilder {
+public:
+    explicit ConfigKeyBuilder(std::string_view type);
+
+    ConfigKeyBuilder& field(std::string_view name, int value);
+    ConfigKeyBuilder& field(std::string_view name, double value);
+    ConfigKeyBuilder& field(std::string_view name, bool value);
+    ConfigKeyBuilder& field(std::string_view name, const std::string& value);
+    ConfigKeyBuilder& field(std::string_view name, const char* value) = delete;
+
+    std::string str() const { return key_ + "}"; }
+
+private:
+    void name(std::string_view n);
+
+    std::string key_;
+    bool first_ = true;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,379 @@
+#include "daemon.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../generators/main_generator.h"
+#include "../utils/json_writer.h"
+#include "../utils/logger.h"
+#include "../utils/profiler.h"
+#include "code_injector.h"
+#include "generation_cache.h"
+#include "generation_pipeline.h"
+
+namespace picoforge {
+
+namespace {
+// Readers wake this often to notice a shutdown request.
+constexpr int kPollIntervalMs = 100;
+constexpr size_t kDefaultMaxConnections = 64;
+
+std::string error_response(const std::string& id, const std::string& message) {
+    JsonWriter w;
+    w.beginObject().key("id").raw(id).key("ok").value(false).key("error").value(message).endObject();
+    return w.take();
+}
+
+bool write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string join(const std::vector<std::string>& items) {
+    std::string out;
+    for (const auto& s : items) {
+        if (!out.empty()) out += ", ";
+        out += s;
+    }
+    return out;
+}
+
+const char* diagnostic_kind(ResourceDiagnostic::Kind kind) {
+    switch (kind) {
+        case ResourceDiagnostic::Kind::InvalidModule: return "invalid_module";
+        case ResourceDiagnostic::Kind::Conflict: return "conflict";
+        case ResourceDiagnostic::Kind::Exhausted: return "exhausted";
+    }
+    return "unknown";
+}
+
+void write_diagnostic(JsonWriter& w, const ResourceDiagnostic& d) {
+    w.beginObject().key("kind").value(diagnostic_kind(d.kind)).key("module").value(d.moduleId);
+    if (d.kind != ResourceDiagnostic::Kind::InvalidModule) {
+        w.key("resource").value(resourceKindName(d.resource));
+    }
+    if (d.kind == ResourceDiagnostic::Kind::Conflict) {
+        w.key("index").value(d.index).key("holder").value(d.holderId);
+    }
+    w.key("message").value(d.message).endObject();
+}
+}  // namespace
+
+struct Daemon::Connection {
+    Connection(int in, int out, bool owned) : inFd(in), outFd(out), ownsFds(owned) {}
+    ~Connection() {
+        if (ownsFds) ::close(inFd);
+    }
+
+    // Responses from different workers must not interleave mid-frame.
+    void send(const std::string& frame) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (broken) return;
+        broken = !write_all(outFd, frame.data(), frame.size());
+    }
+
+    int inFd;
+    int outFd;
+    bool ownsFds;
+    std::mutex writeMutex;
+    bool broken = false;
+};
+
+Daemon::Daemon(const DaemonOptions& options)
+    : cache_(options.cache), cmake_(options.cmake), maxInFlight_(options.maxInFlight),
+      maxConnections_(options.maxConnections), pool_(options.jobs) {
+    if (maxInFlight_ == 0) maxInFlight_ = 4 * pool_.size();
+    if (maxConnections_ == 0) maxConnections_ = kDefaultMaxConnections;
+    if (!options.root.empty()) {
+        root_ = std::filesystem::weakly_canonical(std::filesystem::absolute(options.root));
+    }
+}
+
+Daemon::~Daemon() {
+    stopping_ = true;
+    std::unique_lock<std::mutex> lock(slotMutex_);
+    slotFreed_.wait(lock, [this]() { return activeReaders_ == 0; });
+}
+
+DaemonStats Daemon::stats() const {
+    DaemonStats s;
+    s.requests = requests_.load();
+    s.failures = failures_.load();
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    s.inFlight = inFlight_;
+    return s;
+}
+
+void Daemon::serveStream(int inFd, int outFd) {
+    {
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        ++activeReaders_;
+    }
+    serveConnection(std::make_shared<Connection>(inFd, outFd, false));
+    pool_.waitIdle();
+}
+
+void Daemon::serveSocket(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("socket path too long: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    // Replace a stale socket left by a previous run, but never a regular file.
+    struct stat st {};
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) throw std::runtime_error("refusing to replace non-socket " + path);
+        ::unlink(path.c_str());
+    }
+
+    int listenFd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) throw std::runtime_error(std::string("socket: ") + std::strerror(errno));
+    // bind() creates the socket file; the umask makes it 0600 from the start
+    // rather than chmod'ing it after other users could already connect.
+    mode_t oldMask = ::umask(0177);
+    bool bound = ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    ::umask(oldMask);
+    if (!bound || ::listen(listenFd, 64) < 0) {
+        std::string message = std::strerror(errno);
+        ::close(listenFd);
+        throw std::runtime_error("cannot listen on " + path + ": " + message);
+    }
+    Logger::info("serving", {{"socket", path}});
+
+    while (!stopping_) {
+        {
+            // At the cap, clients queue in the listen backlog until one disconnects.
+            std::unique_lock<std::mutex> lock(slotMutex_);
+            if (!slotFreed_.wait_for(lock, std::chrono::milliseconds(kPollIntervalMs),
+                                     [this]() { return activeReaders_ < maxConnections_; })) {
+                continue;
+            }
+        }
+        pollfd p{listenFd, POLLIN, 0};
+        int rc = ::poll(&p, 1, kPollIntervalMs);
+        if (rc <= 0) continue;
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        auto conn = std::make_shared<Connection>(fd, fd, true);
+        {
+            std::lock_guard<std::mutex> lock(slotMutex_);
+            ++activeReaders_;
+        }
+        std::thread([this, conn]() { serveConnection(conn); }).detach();
+    }
+
+    ::close(listenFd);
+    ::unlink(path.c_str());
+    {
+        std::unique_lock<std::mutex> lock(slotMutex_);
+        slotFreed_.wait(lock, [this]() { return activeReaders_ == 0; });
+    }
+    pool_.waitIdle();
+}
+
+void Daemon::serveConnection(const std::shared_ptr<Connection>& conn) {
+    FrameDecoder decoder;
+    std::string frame;
+    char buf[64 * 1024];
+
+    while (!stopping_) {
+        pollfd p{conn->inFd, POLLIN, 0};
+        int rc = ::poll(&p, 1, kPollIntervalMs);
+        if (rc < 0 && errno != EINTR) break;
+        if (rc <= 0) continue;
+
+        ssize_t n = ::read(conn->inFd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+
+        decoder.feed(buf, static_cast<size_t>(n));
+        try {
+            while (!stopping_ && decoder.next(frame)) {
+                dispatch(conn, std::move(frame));
+            }
+        } catch (const std::exception& e) {
+            // A bad length header leaves no way to find the next frame.
+            conn->send(encodeFrame(error_response("null", e.what())));
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(slotMutex_);
+    --activeReaders_;
+    slotFreed_.notify_all();
+}
+
+void Daemon::dispatch(const std::shared_ptr<Connection>& conn, std::string payload) {
+    {
+        // Backpressure: hold the reader until a slot frees up.
+        std::unique_lock<std::mutex> lock(slotMutex_);
+        slotFreed_.wait(lock, [this]() { return inFlight_ < maxInFlight_; });
+        ++inFlight_;
+    }
+
+    pool_.submit([this, conn, payload = std::move(payload)]() {
+        std::string response;
+        try {
+            response = handle(payload);
+        } catch (const std::exception& e) {
+            response = error_response("null", e.what());
+        }
+        conn->send(encodeFrame(response));
+
+        std::lock_guard<std::mutex> lock(slotMutex_);
+        --inFlight_;
+        slotFreed_.notify_all();
+    });
+}
+
+std::string Daemon::handle(std::string_view payload) {
+    PF_PROFILE_SCOPE("request");
+    ++requests_;
+    DaemonRequest request;
+    try {
+        parseRequest(payload, request);
+        return respond(request);
+    } catch (const std::exception& e) {
+        ++failures_;
+        return error_response(request.id, e.what());
+    }
+}
+
+std::string Daemon::respond(const DaemonRequest& request) {
+    JsonWriter w;
+    w.beginObject().key("id").raw(request.id).key("ok");
+
+    switch (request.op) {
+        case DaemonRequest::Op::Ping:
+            w.value(true);
+            return w.endObject().take();
+
+        case DaemonRequest::Op::Shutdown:
+            requestShutdown();
+            w.value(true);
+            return w.endObject().take();
+
+        case DaemonRequest::Op::Stats: {
+            auto s = stats();
+            w.value(true).key("requests").value(s.requests).key("failures").value(s.failures)
+             .key("in_flight").value(s.inFlight).key("workers").value(pool_.size());
+            if (cache_) {
+                auto c = cache_->stats();
+                w.key("cache").beginObject()
+                 .key("hits").value(c.hits).key("misses").value(c.misses)
+                 .key("entries").value(c.entries).key("bytes").value(c.bytes)
+                 .endObject();
+            }
+            return w.endObject().take();
+        }
+
+        case DaemonRequest::Op::Validate:
+        case DaemonRequest::Op::Generate:
+            break;
+    }
+
+    if (request.config.empty() && request.configPath.empty()) {
+        throw std::runtime_error("request needs \"config\" or \"config_path\"");
+    }
+    if (request.config.empty()) checkInsideRoot("config_path", request.configPath);
+    if (!request.outputDir.empty()) checkInsideRoot("output", request.outputDir);
+    ProjectConfig project = request.config.empty()
+        ? ConfigParser::parseProjectFile(request.configPath)
+        : ConfigParser::parseProjectString(request.config);
+    if (!request.projectName.empty()) {
+        project.name = request.projectName;
+    } else if (project.name.empty() && !request.configPath.empty()) {
+        project.name = std::filesystem::path(request.configPath).stem().string();
+    }
+
+    auto report = GenerationPipeline::validate(project);
+    std::vector<std::string> invalid;
+    for (const auto& d : report.diagnostics) {
+        if (d.kind == ResourceDiagnostic::Kind::InvalidModule) invalid.push_back(d.moduleId);
+    }
+    if (request.op == DaemonRequest::Op::Validate) {
+        w.value(report.ok()).key("modules").value(project.modules.size()).key("invalid").beginArray();
+        for (const auto& id : invalid) w.value(id);
+        w.endArray().key("diagnostics").beginArray();
+        for (const auto& d : report.diagnostics) write_diagnostic(w, d);
+        return w.endArray().endObject().take();
+    }
+    if (!invalid.empty()) {
+        throw std::runtime_error("invalid module config: " + join(invalid));
+    }
+
+    GenerationOptions options;
+    options.cache = cache_;
+    options.incremental = request.incremental;
+    options.cmake = cmake_;
+
+    if (!request.outputDir.empty()) {
+        auto lock = outputLock(request.outputDir);
+        std::lock_guard<std::mutex> guard(*lock);
+        auto output = GenerationPipeline::generate(project, options, request.outputDir);
+        auto files = GenerationPipeline::writeProject(output, request.outputDir);
+        w.value(true).key("project").value(output.projectName)
+         .key("modules").value(output.moduleCount).key("reused").value(output.modulesReused)
+         .key("written").value(files.written).key("unchanged").value(files.unchanged);
+        return w.endObject().take();
+    }
+
+    auto output = GenerationPipeline::generate(project, options);
+    std::string mainSource = MainGenerator::composeMainSource(output.code);
+    std::vector<InjectionDiagnostic> diagnostics;
+    if (!request.existingMain.empty()) {
+        auto scan = CodeInjector::scanUserBlocks(request.existingMain);
+        diagnostics = std::move(scan.diagnostics);
+        mainSource = CodeInjector::injectUserBlocks(mainSource, scan.blocks, &diagnostics);
+    }
+
+    w.value(true).key("project").value(output.projectName).key("modules").value(output.moduleCount)
+     .key("headers").value(output.code.headers).key("body").value(output.code.mainBody)
+     .key("definitions").value(output.code.definitions).key("main").value(mainSource).key("cmake").value(output.cmake);
+    if (!output.presets.empty()) w.key("presets").value(output.presets);
+    w.key("warnings").beginArray();
+    for (const auto& d : diagnostics) w.value(d.message);
+    return w.endArray().endObject().take();
+}
+
+void Daemon::checkInsideRoot(const char* field, const std::string& path) const {
+    if (root_.empty()) return;
+    // Symlinks are resolved as far as the path exists, so a link out of the
+    // root does not get through.
+    auto resolved = std::filesystem::weakly_canonical(std::filesystem::absolute(path));
+    auto relative = resolved.lexically_relative(root_);
+    if (relative.empty() || *relative.begin() == "..") {
+        throw std::runtime_error(std::string(field) + " is outside the daemon root: " + path);
+    }
+}
+
+std::shared_ptr<std::mutex> Daemon::outputLock(const std::string& outputDir) {
+    auto key = std::filesystem::absolute(outputDir).lexically_normal().string();
+    std::lock_guard<std::mutex> lock(outputLocksMutex_);
+    auto& slot = outputLocks_[key];
+    if (!slot) slot = std::make_shared<std::mutex>();
+    return slot;
+}
+
+}  // namespace picoforge
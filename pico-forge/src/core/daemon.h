@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../generators/cmake_generator.h"
+#include "daemon_protocol.h"
+#include "thread_pool.h"
+
+namespace picoforge {
+
+class GenerationCache;
+
+struct DaemonOptions {
+    size_t jobs = 0;          // worker threads; 0 = hardware concurrency
+    size_t maxInFlight = 0;   // queued + running requests; 0 = 4 per worker
+    GenerationCache* cache = nullptr;
+    CMakeOptions cmake;       // applied to every generated project
+    size_t maxConnections = 0;  // concurrent socket clients; 0 = 64, the rest wait in the backlog
+    std::string root;         // if set, config_path and output must resolve inside it
+};
+
+struct DaemonStats {
+    uint64_t requests = 0;
+    uint64_t failures = 0;
+    size_t inFlight = 0;
+};
+
+// Long-lived request server behind `pico-forge --serve`. Keeps the module
+// factory, generation cache and thread pool warm across requests. Frames (see
+// daemon_protocol.h) are read per connection and handed to the pool; once
+// maxInFlight requests are outstanding the reader stops reading, which pushes
+// back on clients through the socket/pipe buffers instead of queueing without
+// bound. Responses on one connection may arrive out of order; match them by id.
+//
+// The socket is created owner-only (0600): whoever can connect can read any
+// config_path and write any output the daemon user can, unless `root` confines
+// both. POSIX only; the build leaves the daemon out on Windows.
+class Daemon {
+public:
+    explicit Daemon(const DaemonOptions& options = {});
+    ~Daemon();
+
+    Daemon(const Daemon&) = delete;
+    Daemon& operator=(const Daemon&) = delete;
+
+    // Serves frames read from inFd, answering on outFd, until EOF or shutdown.
+    // Neither descriptor is closed.
+    void serveStream(int inFd, int outFd);
+
+    // Listens on a Unix domain socket until a shutdown request arrives.
+    // Throws std::runtime_error if the socket cannot be set up.
+    void serveSocket(const std::string& path);
+
+    // Handles one request payload synchronously and returns the response payload.
+    std::string handle(std::string_view payload);
+
+    void requestShutdown() { stopping_ = true; }
+    bool stopping() const { return stopping_; }
+
+    DaemonStats stats() const;
+
+private:
+    struct Connection;
+
+    void serveConnection(const std::shared_ptr<Connection>& conn);
+    void dispatch(const std::shared_ptr<Connection>& conn, std::string payload);
+    std::string respond(const DaemonRequest& request);
+    std::shared_ptr<std::mutex> outputLock(const std::string& outputDir);
+    void checkInsideRoot(const char* field, const std::string& path) const;
+
+    GenerationCache* cache_;
+    CMakeOptions cmake_;
+    size_t maxInFlight_;
+    size_t maxConnections_;
+    std::filesystem::path root_;  // canonical; empty = unrestricted
+    std::atomic<bool> stopping_{false};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> failures_{0};
+
+    mutable std::mutex slotMutex_;
+    std::condition_variable slotFreed_;
+    size_t inFlight_ = 0;
+    size_t activeReaders_ = 0;
+
+    // Requests writing into the same project directory are serialised.
+    std::mutex outputLocksMutex_;
+    std::unordered_map<std::string, std::shared_ptr<std::mutex>> outputLocks_;
+
+    ThreadPool pool_;  // last: drained and joined before the members above go away
+};
+
+}  // namespace picoforge
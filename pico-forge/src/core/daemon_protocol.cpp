@@ -0,0 +1,89 @@
+#include "daemon_protocol.h"
+
+#include <stdexcept>
+
+#include "../config/json_reader.h"
+
+namespace picoforge {
+
+namespace {
+std::string read_text(JsonReader& r) {
+    auto raw = r.readString();
+    if (raw.find('\\') == std::string_view::npos) {
+        return std::string(raw);
+    }
+    return JsonReader::unescape(raw);
+}
+
+DaemonRequest::Op parse_op(const std::string& name) {
+    if (name == "generate") return DaemonRequest::Op::Generate;
+    if (name == "validate") return DaemonRequest::Op::Validate;
+    if (name == "ping") return DaemonRequest::Op::Ping;
+    if (name == "stats") return DaemonRequest::Op::Stats;
+    if (name == "shutdown") return DaemonRequest::Op::Shutdown;
+    throw std::runtime_error("unknown op: " + name);
+}
+}  // namespace
+
+void FrameDecoder::feed(const char* data, size_t size) {
+    // Compact once the consumed prefix dominates, so long sessions stay bounded.
+    if (start_ > 0 && start_ >= buffer_.size() / 2) {
+        buffer_.erase(0, start_);
+        start_ = 0;
+    }
+    buffer_.append(data, size);
+}
+
+bool FrameDecoder::next(std::string& frame) {
+    size_t eol = buffer_.find('\n', start_);
+    if (eol == std::string::npos) {
+        if (buffered() > 20) throw std::runtime_error("malformed frame header");
+        return false;
+    }
+
+    size_t len = 0;
+    if (eol == start_) throw std::runtime_error("malformed frame header");
+    for (size_t i = start_; i < eol; ++i) {
+        char c = buffer_[i];
+        if (c == '\r' && i + 1 == eol) break;  // tolerate CRLF from hand-typed input
+        if (c < '0' || c > '9') throw std::runtime_error("malformed frame header");
+        len = len * 10 + static_cast<size_t>(c - '0');
+        if (len > kMaxFrameBytes) throw std::runtime_error("frame exceeds size limit");
+    }
+
+    if (buffer_.size() - (eol + 1) < len) return false;
+    frame.assign(buffer_, eol + 1, len);
+    start_ = eol + 1 + len;
+    return true;
+}
+
+std::string encodeFrame(std::string_view payload) {
+    std::string out = std::to_string(payload.size());
+    out.reserve(out.size() + 1 + payload.size());
+    out += '\n';
+    out += payload;
+    return out;
+}
+
+void parseRequest(std::string_view payload, DaemonRequest& request) {
+    JsonReader r(payload);
+    r.beginObject();
+    std::string_view key;
+    while (r.nextKey(key)) {
+        if (key == "id") request.id = std::string(r.skipValue());
+        else if (key == "op") request.op = parse_op(read_text(r));
+        else if (key == "config") {
+            // Either an inline object or a string holding the config document.
+            request.config = r.peek() == JsonReader::Kind::String ? read_text(r) : std::string(r.skipValue());
+        }
+        else if (key == "config_path") request.configPath = read_text(r);
+        else if (key == "project_name") request.projectName = read_text(r);
+        else if (key == "output") request.outputDir = read_text(r);
+        else if (key == "existing_main") request.existingMain = read_text(r);
+        else if (key == "incremental") request.incremental = r.readBool();
+        else r.skipValue();
+    }
+    r.expectEnd();
+}
+
+}  // namespace picoforge
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// Wire format for `pico-forge --serve`. Every message in either direction is a
+// frame:
+//   <payload-byte-count>\n<payload>
+// and every payload is one JSON object. Requests:
+//   {"id": 7, "op": "generate", "config": {...} | "config_path": "...",
+//    "project_name": "...", "output": "dir", "incremental": true,
+//    "existing_main": "..."}
+// op is one of generate (default), validate, ping, stats, shutdown. Responses
+// echo "id" verbatim and carry "ok" plus either results or "error".
+class FrameDecoder {
+public:
+    static constexpr size_t kMaxFrameBytes = 16 * 1024 * 1024;
+
+    void feed(const char* data, size_t size);
+
+    // Pops the next complete frame. Throws std::runtime_error on a malformed or
+    // oversized length header; the stream cannot be resynchronised after that.
+    bool next(std::string& frame);
+
+    size_t buffered() const { return buffer_.size() - start_; }
+
+private:
+    std::string buffer_;
+    size_t start_ = 0;
+};
+
+std::string encodeFrame(std::string_view payload);
+
+struct DaemonRequest {
+    enum class Op { Generate, Validate, Ping, Stats, Shutdown };
+
+    std::string id = "null";  // raw JSON, echoed back unchanged
+    Op op = Op::Generate;
+    std::string config;       // raw JSON object text
+    std::string configPath;
+    std::string projectName;
+    std::string outputDir;
+    std::string existingMain;
+    bool incremental = false;
+};
+
+// Throws ConfigParseError on malformed JSON and std::runtime_error on an
+// unknown op. Whatever id was read before the failure is left in `request`.
+void parseRequest(std::string_view payload, DaemonRequest& request);
+
+}  // namespace picoforge
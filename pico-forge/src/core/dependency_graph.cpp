@@ -0,0 +1,153 @@
+#include "dependency_graph.h"
+
+#include <algorithm>
+#include <array>
+
+namespace picoforge {
+
+namespace {
+struct DependencyNode {
+    std::string_view header;
+    std::string_view library;
+    std::string_view implies;  // header of a node this one already provides, or empty
+};
+
+// Sorted by header so lookups can binary search; a node's index is its id.
+constexpr std::array<DependencyNode, 10> kNodes = {{
+    {"hardware/adc.h", "hardware_adc", ""},
+    {"hardware/dma.h", "hardware_dma", ""},
+    {"hardware/gpio.h", "hardware_gpio", ""},
+    {"hardware/i2c.h", "hardware_i2c", ""},
+    {"hardware/pio.h", "hardware_pio", "hardware/gpio.h"},
+    {"hardware/pwm.h", "hardware_pwm", ""},
+    {"hardware/spi.h", "hardware_spi", ""},
+    {"hardware/uart.h", "hardware_uart", ""},
+    {"pico/multicore.h", "pico_multicore", ""},
+    {"pico/time.h", "pico_time", ""},
+}};
+
+constexpr bool nodes_sorted() {
+    for (size_t i = 1; i < kNodes.size(); ++i) {
+        if (!(kNodes[i - 1].header < kNodes[i].header)) return false;
+    }
+    return true;
+}
+static_assert(nodes_sorted(), "kNodes must stay sorted by header");
+
+int find_node(std::string_view header) {
+    auto it = std::lower_bound(kNodes.begin(), kNodes.end(), header,
+                               [](const DependencyNode& n, std::string_view h) { return n.header < h; });
+    return it != kNodes.end() && it->header == header ? static_cast<int>(it - kNodes.begin()) : -1;
+}
+
+// Nodes implied by anything in `nodes`.
+uint32_t implied_by(uint32_t nodes) {
+    uint32_t implied = 0;
+    for (size_t i = 0; i < kNodes.size(); ++i) {
+        if ((nodes & (1u << i)) && !kNodes[i].implies.empty()) {
+            implied |= 1u << find_node(kNodes[i].implies);
+        }
+    }
+    return implied;
+}
+
+// Interned dependency names of each node, without and with ".h", so module
+// dependencies resolve with handle compares.
+struct NodeSymbols {
+    std::array<Symbol, kNodes.size()> name;
+    std::array<Symbol, kNodes.size()> header;
+};
+
+const NodeSymbols& node_symbols() {
+    static const NodeSymbols symbols = [] {
+        NodeSymbols s;
+        for (size_t i = 0; i < kNodes.size(); ++i) {
+            s.header[i] = Symbol(kNodes[i].header);
+            s.name[i] = Symbol(kNodes[i].header.substr(0, kNodes[i].header.size() - 2));
+        }
+        return s;
+    }();
+    return symbols;
+}
+
+// "hardware/gpio" -> "hardware_gpio" for SDK-style names the table does not know.
+std::string conventional_library(std::string_view header) {
+    if (header.size() < 2 || header.substr(header.size() - 2) != ".h") return {};
+    std::string_view name = header.substr(0, header.size() - 2);
+    if (name.rfind("hardware/", 0) != 0 && name.rfind("pico/", 0) != 0) return {};
+    std::string lib(name);
+    std::replace(lib.begin(), lib.end(), '/', '_');
+    return lib;
+}
+}  // namespace
+
+void DependencySet::addDependency(Symbol dependency) {
+    const auto& symbols = node_symbols();
+    for (size_t i = 0; i < kNodes.size(); ++i) {
+        if (symbols.name[i] == dependency || symbols.header[i] == dependency) {
+            nodes_ |= 1u << i;
+            return;
+        }
+    }
+    addDependency(std::string_view(dependency.str()));
+}
+
+void DependencySet::addDependency(std::string_view dependency) {
+    if (dependency.size() >= 2 && dependency.substr(dependency.size() - 2) == ".h") {
+        addInclude(dependency);
+    } else {
+        addInclude(std::string(dependency) + ".h");
+    }
+}
+
+void DependencySet::addInclude(std::string_view header) {
+    int node = find_node(header);
+    if (node >= 0) {
+        nodes_ |= 1u << node;
+    } else {
+        Symbol symbol(header);
+        if (std::find(unknown_.begin(), unknown_.end(), symbol) == unknown_.end()) unknown_.push_back(symbol);
+    }
+}
+
+std::vector<std::string> DependencySet::includes() const {
+    uint32_t nodes = nodes_ & ~implied_by(nodes_);
+    std::vector<std::string> out;
+    for (Symbol header : unknown_) out.push_back(header.str());
+    for (size_t i = 0; i < kNodes.size(); ++i) {
+        if (nodes & (1u << i)) out.emplace_back(kNodes[i].header);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+bool DependencySet::covers(std::string_view header) const {
+    int node = find_node(header);
+    if (node >= 0) return ((nodes_ | implied_by(nodes_)) >> node) & 1u;
+    return std::any_of(unknown_.begin(), unknown_.end(), [header](Symbol s) { return s.str() == header; });
+}
+
+std::vector<std::string> DependencySet::libraries() const {
+    uint32_t nodes = nodes_ & ~implied_by(nodes_);
+    std::vector<std::string> out;
+    for (size_t i = 0; i < kNodes.size(); ++i) {
+        if (nodes & (1u << i)) out.emplace_back(kNodes[i].library);
+    }
+    for (Symbol header : unknown_) {
+        auto lib = conventional_library(header.str());
+        if (!lib.empty()) out.push_back(std::move(lib));
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+std::vector<std::string> DependencySet::sdkHeaders() const {
+    std::vector<std::string> out{"pico/stdlib.h"};
+    for (size_t i = 0; i < kNodes.size(); ++i) {
+        if (nodes_ & (1u << i)) out.emplace_back(kNodes[i].header);
+    }
+    return out;
+}
+
+}  // namespace picoforge
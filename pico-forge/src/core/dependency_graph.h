@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../utils/symbol_table.h"
+
+namespace picoforge {
+
+// The pico-sdk pieces modules use, interned by header path. A module's
+// dependencies() ("hardware/gpio", "pico/time.h") and the #include lines it
+// emits resolve to the same node, so main.cpp's includes and CMakeLists.txt's
+// link libraries are derived from one set.
+//
+// A node may imply others whose header it includes and whose library it links
+// (hardware/pio pulls in hardware/gpio); implied nodes are left out of both
+// lists. Unknown dependencies are kept verbatim, as interned symbols.
+class DependencySet {
+public:
+    // Dependency name as returned by IModule::dependencies(). Known names are
+    // matched by handle.
+    void addDependency(Symbol dependency);
+    void addDependency(std::string_view dependency);
+    // Path of an angle-bracket #include.
+    void addInclude(std::string_view header);
+
+    // Sorted header paths, without ones another entry already includes.
+    std::vector<std::string> includes() const;
+    // True if including `header` adds nothing to includes(): it is in the set
+    // or implied by something that is.
+    bool covers(std::string_view header) const;
+    // Sorted link libraries (pico_stdlib not included), same pruning.
+    std::vector<std::string> libraries() const;
+    // pico/stdlib.h plus every known SDK header in use: what a precompiled
+    // header for the project should contain.
+    std::vector<std::string> sdkHeaders() const;
+
+    bool empty() const { return nodes_ == 0 && unknown_.empty(); }
+
+private:
+    uint32_t nodes_ = 0;  // bit per known node
+    std::vector<Symbol> unknown_;  // header paths
+};
+
+}  // namespace picoforge
@@ -1,7 +1,74 @@
 #include "dependency_injector.h"
 
+#include <stdexcept>
+#include <string>
+
 namespace picoforge {
 
-// Implementation is template-based; this TU exists for future non-template utilities.
+namespace di_detail {
+size_t next_type_index() {
+    static std::atomic<size_t> next{0};
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace di_detail
+
+struct DependencyInjector::Entry {
+    Entry(Lifetime l, Factory f) : lifetime(l), factory(std::move(f)) {}
+
+    Lifetime lifetime;
+    Factory factory;
+    // Singletons: `instance` is written once under `once`, then only read.
+    std::once_flag once;
+    std::atomic<bool> ready{false};
+    std::shared_ptr<void> instance;
+};
+
+DependencyInjector::DependencyInjector() {
+    for (auto& slot : slots_) slot.store(nullptr, std::memory_order_relaxed);
+}
+
+DependencyInjector::~DependencyInjector() = default;
+
+void DependencyInjector::add(size_t index, Lifetime lifetime, Factory factory) {
+    if (index >= kMaxServiceTypes) {
+        throw std::runtime_error("too many service types (max " + std::to_string(kMaxServiceTypes) + ")");
+    }
+    std::lock_guard<std::mutex> lock(registerMutex_);
+    entries_.push_back(std::make_unique<Entry>(lifetime, std::move(factory)));
+    slots_[index].store(entries_.back().get(), std::memory_order_release);
+}
+
+std::shared_ptr<void> DependencyInjector::resolveIndex(size_t index, Scope* scope) const {
+    Entry* entry = index < kMaxServiceTypes ? slots_[index].load(std::memory_order_acquire) : nullptr;
+    if (!entry) return nullptr;
+
+    switch (entry->lifetime) {
+        case Lifetime::Singleton:
+            if (!entry->ready.load(std::memory_order_acquire)) {
+                // Singletons may only depend on other singletons or transients.
+                std::call_once(entry->once, [&] {
+                    entry->instance = entry->factory(Resolver(this, nullptr));
+                    entry->ready.store(true, std::memory_order_release);
+                });
+            }
+            return entry->instance;
+
+        case Lifetime::Scoped: {
+            if (!scope) {
+                throw std::runtime_error("scoped service resolved outside a scope");
+            }
+            for (const auto& [i, instance] : scope->instances_) {
+                if (i == index) return instance;
+            }
+            auto instance = entry->factory(Resolver(this, scope));
+            scope->instances_.emplace_back(index, instance);
+            return instance;
+        }
+
+        case Lifetime::Transient:
+            return entry->factory(Resolver(this, scope));
+    }
+    return nullptr;
+}
 
 }  // namespace picoforge
@@ -1,31 +1,128 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <functional>
 #include <memory>
-#include <string>
-#include <unordered_map>
+#include <mutex>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace picoforge {
 
+enum class Lifetime {
+    Singleton,  // created once per injector, on first resolve, then shared
+    Scoped,     // one per DependencyInjector::Scope (e.g. per daemon request)
+    Transient,  // a new instance on every resolve
+};
+
+namespace di_detail {
+// Dense process-wide index per service type; doubles as the registration key.
+size_t next_type_index();
+
+template <typename T>
+size_t type_index() {
+    static const size_t index = next_type_index();
+    return index;
+}
+}  // namespace di_detail
+
+// Services are registered by type. Registration takes a mutex; resolution never
+// does: each type's entry sits in a fixed slot read with one atomic load, and a
+// singleton, once built, is returned from its cache without further
+// synchronisation beyond that load. Safe to resolve from many threads, and to
+// register concurrently with resolving (replaced entries stay alive until the
+// injector is destroyed).
 class DependencyInjector {
 public:
+    static constexpr size_t kMaxServiceTypes = 64;
+
+    class Scope;
+
+    // Handed to factories so they can resolve their own dependencies (within the
+    // scope being resolved, if any).
+    class Resolver {
+    public:
+        template <typename T>
+        std::shared_ptr<T> resolve() const {
+            return std::static_pointer_cast<T>(injector_->resolveIndex(di_detail::type_index<T>(), scope_));
+        }
+
+    private:
+        friend class DependencyInjector;
+        Resolver(const DependencyInjector* injector, Scope* scope) : injector_(injector), scope_(scope) {}
+
+        const DependencyInjector* injector_;
+        Scope* scope_;
+    };
+
+    // Per-request cache of Scoped services. Not thread-safe: use one per request.
+    class Scope {
+    public:
+        template <typename T>
+        std::shared_ptr<T> resolve() {
+            return Resolver(injector_, this).resolve<T>();
+        }
+
+    private:
+        friend class DependencyInjector;
+        explicit Scope(const DependencyInjector* injector) : injector_(injector) {}
+
+        const DependencyInjector* injector_;
+        std::vector<std::pair<size_t, std::shared_ptr<void>>> instances_;
+    };
+
+    using Factory = std::function<std::shared_ptr<void>(const Resolver&)>;
+
+    DependencyInjector();
+    ~DependencyInjector();
+    DependencyInjector(const DependencyInjector&) = delete;
+    DependencyInjector& operator=(const DependencyInjector&) = delete;
+
+    template <typename T, typename F>
+    void registerFactory(Lifetime lifetime, F&& factory) {
+        if constexpr (std::is_invocable_v<F&, const Resolver&>) {
+            add(di_detail::type_index<T>(), lifetime,
+                [f = std::forward<F>(factory)](const Resolver& r) -> std::shared_ptr<void> { return f(r); });
+        } else {
+            add(di_detail::type_index<T>(), lifetime,
+                [f = std::forward<F>(factory)](const Resolver&) -> std::shared_ptr<void> { return f(); });
+        }
+    }
+
+    // Singleton with an existing instance.
     template <typename T>
-    void registerFactory(const std::string& key, std::function<std::shared_ptr<T>()> factory) {
-        factories_[key] = [factory]() { return factory(); };
+    void registerInstance(std::shared_ptr<T> instance) {
+        add(di_detail::type_index<T>(), Lifetime::Singleton,
+            [instance = std::move(instance)](const Resolver&) -> std::shared_ptr<void> { return instance; });
     }
 
     template <typename T>
-    std::shared_ptr<T> resolve(const std::string& key) const {
-        auto it = factories_.find(key);
-        if (it == factories_.end()) {
-            return nullptr;
-        }
-        return std::static_pointer_cast<T>(it->second());
+    bool isRegistered() const {
+        size_t index = di_detail::type_index<T>();
+        return index < kMaxServiceTypes && slots_[index].load(std::memory_order_acquire) != nullptr;
     }
 
+    // nullptr if T is not registered. Throws std::runtime_error for a Scoped
+    // service resolved outside a Scope.
+    template <typename T>
+    std::shared_ptr<T> resolve() const {
+        return Resolver(this, nullptr).resolve<T>();
+    }
+
+    Scope createScope() const { return Scope(this); }
+
 private:
-    std::unordered_map<std::string, std::function<std::shared_ptr<void>()>> factories_;
+    struct Entry;
+
+    void add(size_t index, Lifetime lifetime, Factory factory);
+    std::shared_ptr<void> resolveIndex(size_t index, Scope* scope) const;
+
+    std::array<std::atomic<Entry*>, kMaxServiceTypes> slots_;
+    std::mutex registerMutex_;
+    std::vector<std::unique_ptr<Entry>> entries_;  // owns every entry ever registered
 };
 
 }  // namespace picoforge
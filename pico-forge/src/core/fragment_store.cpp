@@ -0,0 +1,88 @@
+#include "fragment_store.h"
+
+#include "../config/config.h"
+#include "../generators/main_generator.h"
+#include "../utils/file_utils.h"
+#include "../utils/profiler.h"
+#include "../utils/record_io.h"
+#include "dependency_graph.h"
+
+namespace picoforge {
+
+namespace {
+constexpr const char* kStateMagic = "picoforge-fragments 2\n";
+}  // namespace
+
+FragmentStore::FragmentStore(std::string stateFile) : stateFile_(std::move(stateFile)) {
+    if (!FileUtils::fileExists(stateFile_)) return;
+
+    std::string data = FileUtils::readFile(stateFile_);
+    size_t pos = std::char_traits<char>::length(kStateMagic);
+    std::string version;
+    if (data.compare(0, pos, kStateMagic) != 0 ||
+        !readRecord(data, pos, "version", version) || version != kVersion) {
+        return;  // unknown or stale state: everything is re-emitted
+    }
+
+    std::string key;
+    ModuleFragment fragment;
+    while (readRecord(data, pos, "key", key) &&
+           readRecord(data, pos, "headers", fragment.headers) &&
+           readRecord(data, pos, "init", fragment.init) &&
+           readRecord(data, pos, "definitions", fragment.definitions)) {
+        previous_[key] = fragment;
+    }
+}
+
+GeneratedCode FragmentStore::generate(const ModuleList& modules) {
+    current_.clear();
+    order_.clear();
+    reused_ = 0;
+    emitted_ = 0;
+
+    std::vector<const ModuleFragment*> fragments;
+    fragments.reserve(modules.size());
+    DependencySet deps;
+
+    for (const auto& m : modules) {
+        for (Symbol dep : m->dependencies()) deps.addDependency(dep);
+        auto key = m->configKey();
+        auto it = current_.find(key);
+        if (it == current_.end()) {
+            auto prev = previous_.find(key);
+            if (prev != previous_.end()) {
+                it = current_.emplace(key, prev->second).first;
+                ++reused_;
+            } else {
+                PF_PROFILE_SCOPE_DETAIL("emit_module", m->id());
+                it = current_.emplace(key, ModuleFragment{m->generateHeaderCode(), m->generateInitCode(),
+                                                                   m->generateDefinitionsCode()}).first;
+                ++emitted_;
+            }
+            order_.push_back(key);
+        } else {
+            ++reused_;
+        }
+        fragments.push_back(&it->second);
+    }
+
+    dirty_ = emitted_ > 0 || current_.size() != previous_.size();
+    return MainGenerator::assemble(fragments, deps);
+}
+
+bool FragmentStore::save() const {
+    if (!dirty_ && FileUtils::fileExists(stateFile_)) return true;
+
+    std::string data = kStateMagic;
+    appendRecord(data, "version", kVersion);
+    for (const auto& key : order_) {
+        const auto& f = current_.at(key);
+        appendRecord(data, "key", key);
+        appendRecord(data, "headers", f.headers);
+        appendRecord(data, "init", f.init);
+        appendRecord(data, "definitions", f.definitions);
+    }
+    return FileUtils::writeFileIfChanged(stateFile_, data) != WriteStatus::Failed;
+}
+
+}  // namespace picoforge
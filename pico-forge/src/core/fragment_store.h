@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "code_generator.h"
+
+namespace picoforge {
+
+// Per-project record of each module's generated fragments, keyed by
+// IModule::configKey(). Across runs only modules whose config changed are
+// re-emitted; the rest reuse their stored headers/init text.
+class FragmentStore {
+public:
+    // Loads previous fragments from stateFile if it exists and matches this generator version.
+    explicit FragmentStore(std::string stateFile);
+
+    GeneratedCode generate(const ModuleList& modules);
+
+    // Persists the fragments of the last generate(); no-op when nothing changed.
+    bool save() const;
+
+    size_t reused() const { return reused_; }
+    size_t emitted() const { return emitted_; }
+
+private:
+    std::string stateFile_;
+    std::unordered_map<std::string, ModuleFragment> previous_;
+    std::unordered_map<std::string, ModuleFragment> current_;
+    std::vector<std::string> order_;
+    size_t reused_ = 0;
+    size_t emitted_ = 0;
+    bool dirty_ = false;
+};
+
+}  // namespace picoforge
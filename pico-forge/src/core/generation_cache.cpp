@@ -0,0 +1,170 @@
+#include "generation_cache.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "../config/config.h"
+#include "../utils/file_utils.h"
+#include "../utils/hash.h"
+#include "../utils/record_io.h"
+#include "generation_pipeline.h"
+#include "module_factory.h"
+
+namespace fs = std::filesystem;
+
+namespace picoforge {
+
+namespace {
+constexpr const char* kEntryMagic = "picoforge-cache 3\n";
+constexpr const char* kEntryExt = ".pfc";
+}  // namespace
+
+GenerationCache::GenerationCache(std::string directory, uint64_t maxBytes)
+    : directory_(std::move(directory)), maxBytes_(maxBytes) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    loadIndex();
+}
+
+std::string GenerationCache::normalizedKey(const ProjectConfig& project, const CMakeOptions& cmake) {
+    std::string key = "version=";
+    key += kVersion;
+    key += "\ncmake=";
+    key += cmake.key();
+    key += "\ntypes=";
+    for (const auto& type : ModuleFactory::instance().registeredTypes()) {
+        key += type;
+        key += ',';
+    }
+    key += "\nproject=";
+    key += project.name;
+    key += '\n';
+    for (const auto& m : project.modules) {
+        key += m->configKey();
+        key += '\n';
+    }
+    return key;
+}
+
+std::string GenerationCache::pathFor(const std::string& hash) const {
+    return directory_ + "/" + hash + kEntryExt;
+}
+
+void GenerationCache::loadIndex() {
+    struct Found {
+        std::string hash;
+        uint64_t size;
+        fs::file_time_type mtime;
+    };
+    std::vector<Found> found;
+
+    std::error_code ec;
+    for (const auto& de : fs::directory_iterator(directory_, ec)) {
+        if (!de.is_regular_file(ec) || de.path().extension() != kEntryExt) continue;
+        found.push_back({de.path().stem().string(), de.file_size(ec), de.last_write_time(ec)});
+    }
+    std::sort(found.begin(), found.end(),
+              [](const Found& a, const Found& b) { return a.mtime > b.mtime; });
+
+    for (const auto& f : found) {
+        lru_.push_back(f.hash);
+        index_[f.hash] = Entry{pathFor(f.hash), f.size, std::prev(lru_.end())};
+        stats_.bytes += f.size;
+    }
+    stats_.entries = index_.size();
+}
+
+void GenerationCache::touch(const std::string& hash) {
+    auto it = index_.find(hash);
+    if (it == index_.end()) return;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+
+    std::error_code ec;
+    fs::last_write_time(it->second.file, fs::file_time_type::clock::now(), ec);
+}
+
+bool GenerationCache::lookup(const std::string& key, GenerationOutput& out) {
+    const std::string hash = Hasher().add(key).hex();
+    const std::string path = pathFor(hash);
+
+    std::string data = FileUtils::readFile(path);
+    std::string storedKey, moduleCount;
+    GenerationOutput entry;
+    size_t pos = std::char_traits<char>::length(kEntryMagic);
+
+    bool ok = data.compare(0, pos, kEntryMagic) == 0 &&
+              readRecord(data, pos, "key", storedKey) && storedKey == key &&
+              readRecord(data, pos, "name", entry.projectName) &&
+              readRecord(data, pos, "modules", moduleCount) &&
+              readRecord(data, pos, "headers", entry.code.headers) &&
+              readRecord(data, pos, "body", entry.code.mainBody) &&
+              readRecord(data, pos, "definitions", entry.code.definitions) &&
+              readRecord(data, pos, "cmake", entry.cmake) &&
+              readRecord(data, pos, "presets", entry.presets);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ok) {
+        ++stats_.misses;
+        return false;
+    }
+    entry.moduleCount = static_cast<size_t>(std::strtoull(moduleCount.c_str(), nullptr, 10));
+    out = std::move(entry);
+    ++stats_.hits;
+    touch(hash);
+    return true;
+}
+
+void GenerationCache::store(const std::string& key, const GenerationOutput& out) {
+    const std::string hash = Hasher().add(key).hex();
+    const std::string path = pathFor(hash);
+
+    std::string data = kEntryMagic;
+    appendRecord(data, "key", key);
+    appendRecord(data, "name", out.projectName);
+    appendRecord(data, "modules", std::to_string(out.moduleCount));
+    appendRecord(data, "headers", out.code.headers);
+    appendRecord(data, "body", out.code.mainBody);
+    appendRecord(data, "definitions", out.code.definitions);
+    appendRecord(data, "cmake", out.cmake);
+    appendRecord(data, "presets", out.presets);
+
+    // writeFile renames into place, so concurrent readers never observe a partial
+    // entry. No fsync: a lost entry is just a miss.
+    if (!FileUtils::writeFile(path, data, false)) return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(hash);
+    if (it != index_.end()) {
+        stats_.bytes -= it->second.size;
+        lru_.erase(it->second.lru);
+        index_.erase(it);
+    }
+    lru_.push_front(hash);
+    index_[hash] = Entry{path, data.size(), lru_.begin()};
+    stats_.bytes += data.size();
+    ++stats_.stores;
+    evictLocked(hash);
+    stats_.entries = index_.size();
+}
+
+void GenerationCache::evictLocked(const std::string& keep) {
+    while (stats_.bytes > maxBytes_ && !lru_.empty() && lru_.back() != keep) {
+        auto it = index_.find(lru_.back());
+        std::error_code ec;
+        fs::remove(it->second.file, ec);
+        stats_.bytes -= it->second.size;
+        lru_.pop_back();
+        index_.erase(it);
+        ++stats_.evictions;
+    }
+}
+
+CacheStats GenerationCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+}  // namespace picoforge
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "../config/config_parser.h"
+#include "../generators/cmake_generator.h"
+
+namespace picoforge {
+
+struct GenerationOutput;
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stores = 0;
+    uint64_t evictions = 0;
+    uint64_t bytes = 0;
+    size_t entries = 0;
+};
+
+// Persistent, content-addressed store of generation results.
+// Entries live as <hash>.pfc files in one directory and are keyed by the
+// normalized project (generator version, CMake options, registered module
+// types, project name and every module's configKey()). The full normalized key is stored in
+// the entry and compared on lookup, so hash collisions degrade to misses.
+// Size is bounded with least-recently-used eviction; recency is kept in file
+// mtimes so it survives across runs. Safe to share between threads.
+class GenerationCache {
+public:
+    static constexpr uint64_t kDefaultMaxBytes = 256ULL * 1024 * 1024;
+
+    explicit GenerationCache(std::string directory, uint64_t maxBytes = kDefaultMaxBytes);
+
+    static std::string normalizedKey(const ProjectConfig& project, const CMakeOptions& cmake = {});
+
+    bool lookup(const std::string& key, GenerationOutput& out);
+    void store(const std::string& key, const GenerationOutput& out);
+
+    CacheStats stats() const;
+
+private:
+    struct Entry {
+        std::string file;
+        uint64_t size = 0;
+        std::list<std::string>::iterator lru;
+    };
+
+    void loadIndex();
+    void touch(const std::string& hash);
+    void evictLocked(const std::string& keep);
+    std::string pathFor(const std::string& hash) const;
+
+    std::string directory_;
+    uint64_t maxBytes_;
+
+    mutable std::mutex mutex_;
+    std::list<std::string> lru_;  // most recent first
+    std::unordered_map<std::string, Entry> index_;
+    CacheStats stats_;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,136 @@
+#include "generation_pipeline.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+#include "../generators/cmake_generator.h"
+#include "../generators/main_generator.h"
+#include "../utils/file_utils.h"
+#include "../utils/logger.h"
+#include "../utils/profiler.h"
+#include "code_injector.h"
+#include "fragment_store.h"
+#include "generation_cache.h"
+#include "resource_allocator.h"
+
+namespace picoforge {
+
+namespace {
+std::string project_name_from_path(const std::string& configPath) {
+    auto stem = std::filesystem::path(configPath).stem().string();
+    return stem.empty() ? "pico_project" : stem;
+}
+
+void ensure_directory(const std::string& dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        throw std::runtime_error("cannot create directory " + dir + ": " + ec.message());
+    }
+}
+
+void write_output(const std::string& path, const std::string& content, WriteReport& report) {
+    PF_PROFILE_SCOPE_DETAIL("write_file", path);
+    switch (FileUtils::writeFileIfChanged(path, content)) {
+        case WriteStatus::Written: ++report.written; break;
+        case WriteStatus::Unchanged: ++report.unchanged; break;
+        case WriteStatus::Failed: throw std::runtime_error("cannot write " + path);
+    }
+}
+}  // namespace
+
+ResourceReport GenerationPipeline::validate(const ProjectConfig& project) {
+    return ConfigValidator::validateAll(project.modules);
+}
+
+GenerationOutput GenerationPipeline::generate(const ProjectConfig& project,
+                                              const GenerationOptions& options,
+                                              const std::string& outputDir) {
+    PF_PROFILE_SCOPE_DETAIL("generate", project.name);
+    for (const auto& d : validate(project).diagnostics) {
+        Logger::warning(d.message, {{"project", project.name}});
+    }
+
+    GenerationOutput out;
+    std::string key;
+    // Cache keys use the config as written; allocation is a pure function of it.
+    if (options.cache) {
+        PF_PROFILE_SCOPE("cache_lookup");
+        key = GenerationCache::normalizedKey(project, options.cmake);
+        if (options.cache->lookup(key, out)) {
+            return out;
+        }
+    }
+
+    auto allocation = ResourceAllocator::allocate(project.modules);
+    if (!allocation.ok()) {
+        std::string message = "resource allocation failed";
+        for (const auto& e : allocation.errors) message += "\n  " + e;
+        throw std::runtime_error(message);
+    }
+    const ModuleList& modules = allocation.modules;
+
+    out.projectName = project.name.empty() ? "pico_project" : project.name;
+    out.moduleCount = modules.size();
+
+    if (options.incremental && !outputDir.empty()) {
+        ensure_directory(stateDirectory(outputDir));
+        FragmentStore fragments(stateDirectory(outputDir) + "/fragments");
+        out.code = fragments.generate(modules);
+        out.modulesReused = fragments.reused();
+        if (!fragments.save()) {
+            throw std::runtime_error("cannot write fragment state in " + stateDirectory(outputDir));
+        }
+    } else {
+        MainGenerator gen;
+        out.code = gen.generate(modules);
+    }
+    {
+        PF_PROFILE_SCOPE("cmake_generate");
+        out.cmake = CMakeGenerator::generate(out.projectName, modules, options.cmake);
+        if (options.cmake.wantsPresets()) {
+            out.presets = CMakeGenerator::presets(out.projectName, options.cmake);
+        }
+    }
+
+    if (options.cache) {
+        PF_PROFILE_SCOPE("cache_store");
+        options.cache->store(key, out);
+    }
+    return out;
+}
+
+GenerationOutput GenerationPipeline::generateFile(const std::string& configPath,
+                                                  const GenerationOptions& options,
+                                                  const std::string& outputDir) {
+    auto project = ConfigParser::parseProjectFile(configPath);
+    if (project.name.empty()) {
+        project.name = project_name_from_path(configPath);
+    }
+    return generate(project, options, outputDir);
+}
+
+WriteReport GenerationPipeline::writeProject(const GenerationOutput& output, const std::string& outputDir) {
+    ensure_directory(outputDir);
+
+    const std::string mainPath = outputDir + "/main.cpp";
+    std::string mainSource = MainGenerator::composeMainSource(output.code);
+    if (FileUtils::fileExists(mainPath)) {
+        PF_PROFILE_SCOPE("inject_user_code");
+        auto scan = CodeInjector::scanUserBlocks(FileUtils::mapFile(mainPath).view());
+        mainSource = CodeInjector::injectUserBlocks(mainSource, scan.blocks, &scan.diagnostics);
+        for (const auto& d : scan.diagnostics) {
+            Logger::warning(d.message, {{"file", mainPath}, {"line", d.line}});
+        }
+    }
+
+    WriteReport report;
+    write_output(mainPath, mainSource, report);
+    write_output(outputDir + "/CMakeLists.txt", output.cmake, report);
+    if (!output.presets.empty()) {
+        write_output(outputDir + "/CMakePresets.json", output.presets, report);
+    }
+    return report;
+}
+
+}  // namespace picoforge
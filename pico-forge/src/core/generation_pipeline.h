@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../config/config_parser.h"
+#include "../config/config_validator.h"
+#include "../generators/cmake_generator.h"
+#include "code_generator.h"
+
+namespace picoforge {
+
+class GenerationCache;
+
+struct GenerationOptions {
+    // A cache hit skips MainGenerator/CMakeGenerator entirely.
+    GenerationCache* cache = nullptr;
+    // Reuse per-module fragments recorded in <outputDir>/.picoforge so only
+    // modules whose config changed are re-emitted. Needs an output directory.
+    bool incremental = false;
+    // Ninja/ccache/unity/presets settings for the generated CMake project.
+    CMakeOptions cmake;
+};
+
+struct GenerationOutput {
+    std::string projectName;
+    size_t moduleCount = 0;
+    size_t modulesReused = 0;  // incremental runs only
+    GeneratedCode code;
+    std::string cmake;
+    std::string presets;  // CMakePresets.json, empty unless requested
+};
+
+struct WriteReport {
+    size_t written = 0;
+    size_t unchanged = 0;
+};
+
+// Parse -> MainGenerator -> CMakeGenerator for one project, plus writing the
+// results into a project directory. Stateless and safe to call from many threads
+// (as long as no two calls share an output directory).
+class GenerationPipeline {
+public:
+    // ConfigValidator::validateAll over the project. generate() logs every
+    // diagnostic as a warning but still generates.
+    static ResourceReport validate(const ProjectConfig& project);
+
+    static GenerationOutput generate(const ProjectConfig& project,
+                                     const GenerationOptions& options = {},
+                                     const std::string& outputDir = "");
+    static GenerationOutput generateFile(const std::string& configPath,
+                                         const GenerationOptions& options = {},
+                                         const std::string& outputDir = "");
+
+    // Writes main.cpp and CMakeLists.txt into outputDir, carrying over
+    // [USER_CODE] blocks from an existing main.cpp. Files whose bytes would not
+    // change are left untouched so downstream builds stay incremental.
+    // Throws on I/O failure.
+    static WriteReport writeProject(const GenerationOutput& output, const std::string& outputDir);
+
+    static std::string stateDirectory(const std::string& outputDir) { return outputDir + "/.picoforge"; }
+};
+
+}  // namespace picoforge
@@ -2,6 +2,22 @@
 
 namespace picoforge {
 
-// No concrete logic yet; concrete modules will live in src/modules.
+std::string IModule::generateInitCode() const {
+    CodeWriter out(256);
+    emit(out);
+    return out.take();
+}
+
+std::string IModule::generateHeaderCode() const {
+    CodeWriter out(64);
+    emitHeader(out);
+    return out.take();
+}
+
+std::string IModule::generateDefinitionsCode() const {
+    CodeWriter out(64);
+    emitDefinitions(out);
+    return out.take();
+}
 
 }  // namespace picoforge
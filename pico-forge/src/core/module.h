@@ -1,20 +1,99 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "code_writer.h"
+#include "resources.h"
+#include "../utils/symbol_table.h"
+
 namespace picoforge {
 
+// A string slot owned by one object and filled lazily from const methods on
+// several threads. Copies carry the current value.
+class CachedString {
+public:
+    CachedString() = default;
+    CachedString(const CachedString& other) { copyFrom(other); }
+    CachedString& operator=(const CachedString& other) {
+        if (this != &other) {
+            delete text_.exchange(nullptr, std::memory_order_acq_rel);
+            copyFrom(other);
+        }
+        return *this;
+    }
+    ~CachedString() { delete text_.load(std::memory_order_relaxed); }
+
+    // Returns the cached text, building it with make() on first use. Racing
+    // callers may each call make(); one result wins and the rest are dropped.
+    template <typename Make>
+    const std::string& get(Make&& make) const {
+        if (const std::string* text = text_.load(std::memory_order_acquire)) return *text;
+        auto built = std::make_unique<const std::string>(make());
+        const std::string* expected = nullptr;
+        if (text_.compare_exchange_strong(expected, built.get(), std::memory_order_acq_rel)) {
+            return *built.release();
+        }
+        return *expected;
+    }
+
+private:
+    void copyFrom(const CachedString& other) {
+        const std::string* text = other.text_.load(std::memory_order_acquire);
+        text_.store(text ? new std::string(*text) : nullptr, std::memory_order_release);
+    }
+
+    mutable std::atomic<const std::string*> text_{nullptr};
+};
+
 class IModule {
 public:
     virtual ~IModule() = default;
 
-    virtual std::string id() const = 0;
+    // Instance id ("gpio_4"): buildId() runs once per module and later calls
+    // return the cached text without allocating. Ids embed user-chosen names
+    // (PIO programs, timers), so each module owns its copy rather than growing
+    // the process-wide SymbolTable with every request a daemon serves.
+    const std::string& id() const {
+        return id_.get([this] { return buildId(); });
+    }
+
     virtual bool validate() const = 0;
-    virtual std::string generateInitCode() const = 0;
-    virtual std::string generateHeaderCode() const = 0;
-    virtual std::vector<std::string> dependencies() const = 0;
+
+    // Primary generation path: append init / header code to a shared writer.
+    virtual void emit(CodeWriter& out) const = 0;
+    virtual void emitHeader(CodeWriter& out) const = 0;
+    // File-scope code (buffers, state, IRQ handlers, helper functions) placed
+    // after the includes, in module order. Names should start with id(); end
+    // the block with a blank line.
+    virtual void emitDefinitions(CodeWriter& out) const { (void)out; }
+
+    // String-returning adapters over emit()/emitHeader()/emitDefinitions().
+    virtual std::string generateInitCode() const;
+    virtual std::string generateHeaderCode() const;
+    std::string generateDefinitionsCode() const;
+
+    // SDK pieces the module needs ("hardware/gpio"), as interned names. Plugins
+    // written against the std::vector<std::string> signature wrap each name in
+    // Symbol; these are header names, a fixed set, never request data.
+    virtual std::vector<Symbol> dependencies() const = 0;
+
+    // Canonical, order-stable description of the module's config (see ConfigKeyBuilder).
+    // Used to key generation caches and detect per-module changes between runs.
+    virtual std::string configKey() const = 0;
+
+    // Hardware this module holds exclusively (pins, DMA channels, state
+    // machines, ...). Checked across all modules by ConfigValidator::validateAll.
+    virtual void claimResources(ResourceClaims& claims) const { (void)claims; }
+
+protected:
+    // Replaces the old virtual id(); called once, from id().
+    virtual std::string buildId() const = 0;
+
+private:
+    CachedString id_;
 };
 
 using ModulePtr = std::shared_ptr<IModule>;
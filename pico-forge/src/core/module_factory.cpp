@@ -1,5 +1,10 @@
 #include "module_factory.h"
 
+#include <algorithm>
+#include <mutex>
+
+#include "module_registry.h"
+
 namespace picoforge {
 
 ModuleFactory& ModuleFactory::instance() {
@@ -7,16 +12,47 @@ ModuleFactory& ModuleFactory::instance() {
     return inst;
 }
 
-void ModuleFactory::registerModule(const std::string& type, CreateFn creator) {
-    creators_[type] = creator;
+bool ModuleFactory::registerModule(const std::string& type, CreateFn creator) {
+    if (isBuiltinModuleType(type)) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> lock(pluginMutex_);
+    plugins_[Symbol(type)] = std::move(creator);
+    pluginCount_.store(plugins_.size(), std::memory_order_release);
+    return true;
 }
 
-ModulePtr ModuleFactory::create(const std::string& type) const {
-    auto it = creators_.find(type);
-    if (it == creators_.end()) {
+ModulePtr ModuleFactory::create(std::string_view type) const {
+    if (auto module = createBuiltinModule(type)) {
+        return module;
+    }
+    // Without plugins (the common case) an unknown name never touches the lock.
+    if (pluginCount_.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    // A name that was never interned cannot be a registered plugin.
+    Symbol symbol = SymbolTable::find(type);
+    if (!symbol.valid()) {
+        return nullptr;
+    }
+    std::shared_lock<std::shared_mutex> lock(pluginMutex_);
+    auto it = plugins_.find(symbol);
+    if (it == plugins_.end()) {
         return nullptr;
     }
     return it->second();
 }
 
+std::vector<std::string> ModuleFactory::registeredTypes() const {
+    std::vector<std::string> types = builtinModuleTypes();
+    {
+        std::shared_lock<std::shared_mutex> lock(pluginMutex_);
+        for (const auto& [type, creator] : plugins_) {
+            types.push_back(type.str());
+        }
+    }
+    std::sort(types.begin(), types.end());
+    return types;
+}
+
 }  // namespace picoforge
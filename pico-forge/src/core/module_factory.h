@@ -1,26 +1,41 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "module.h"
+#include "../utils/symbol_table.h"
 
 namespace picoforge {
 
+// Creates modules by type name. Built-in types resolve through the
+// compile-time registry (module_registry.h) without locking; plugin types
+// registered at runtime are consulted only when that lookup misses.
+// All methods are safe to call concurrently.
 class ModuleFactory {
 public:
     using CreateFn = std::function<ModulePtr()>;
-    
+
     static ModuleFactory& instance();
-    
-    void registerModule(const std::string& type, CreateFn creator);
-    ModulePtr create(const std::string& type) const;
-    
+
+    // Runtime extension point for plugin modules. Built-in type names cannot be
+    // shadowed: returns false (and ignores the creator) for those.
+    bool registerModule(const std::string& type, CreateFn creator);
+    ModulePtr create(std::string_view type) const;
+    std::vector<std::string> registeredTypes() const;  // built-in and plugin, sorted
+
 private:
     ModuleFactory() = default;
-    std::unordered_map<std::string, CreateFn> creators_;
+
+    mutable std::shared_mutex pluginMutex_;
+    std::unordered_map<Symbol, CreateFn> plugins_;  // keyed by interned type name
+    std::atomic<size_t> pluginCount_{0};
 };
 
 }  // namespace picoforge
@@ -1,8 +1,108 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "module.h"
+
 namespace picoforge {
 
-// Forward declarations
-void registerAllModules();
+namespace registry_detail {
+
+constexpr uint32_t hash(std::string_view s, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : s) {
+        h = (h ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return h;
+}
+
+constexpr size_t slot_count(size_t names) {
+    size_t slots = 1;
+    while (slots < names * 2) slots <<= 1;
+    return slots;
+}
+
+constexpr uint8_t kEmptySlot = 0xFF;
+
+template <size_t Slots>
+struct PerfectHashTable {
+    uint32_t seed = 0;
+    bool found = false;
+    std::array<uint8_t, Slots> slots{};
+};
+
+// Searches for a seed that sends every name to its own slot. Runs at compile time.
+template <size_t Slots, size_t N>
+constexpr PerfectHashTable<Slots> build_table(const std::array<std::string_view, N>& names) {
+    PerfectHashTable<Slots> table;
+    for (uint32_t seed = 0; seed < 100000; ++seed) {
+        for (auto& s : table.slots) s = kEmptySlot;
+        bool ok = true;
+        for (size_t i = 0; i < N && ok; ++i) {
+            auto slot = hash(names[i], seed) & (Slots - 1);
+            ok = table.slots[slot] == kEmptySlot;
+            table.slots[slot] = static_cast<uint8_t>(i);
+        }
+        if (ok) {
+            table.seed = seed;
+            table.found = true;
+            return table;
+        }
+    }
+    return table;
+}
+
+}  // namespace registry_detail
+
+// Compile-time registry over a list of module classes, each exposing
+// `static constexpr std::string_view kTypeName`. Lookup is one hash, one slot
+// probe and one string compare against a constexpr perfect-hash table; there
+// is no registration step and no mutable state, so it is safe from any thread.
+template <typename... Modules>
+class StaticModuleRegistry {
+public:
+    static constexpr size_t kCount = sizeof...(Modules);
+    static constexpr std::array<std::string_view, kCount> kNames = {Modules::kTypeName...};
+
+    // Index of `type` in the module list, or -1.
+    static constexpr int indexOf(std::string_view type) {
+        auto slot = kTable.slots[registry_detail::hash(type, kTable.seed) & (kSlots - 1)];
+        return slot != registry_detail::kEmptySlot && kNames[slot] == type ? slot : -1;
+    }
+
+    static constexpr bool contains(std::string_view type) { return indexOf(type) >= 0; }
+
+    static ModulePtr create(std::string_view type) {
+        int index = indexOf(type);
+        return index < 0 ? nullptr : kCreators[static_cast<size_t>(index)]();
+    }
+
+private:
+    static_assert(kCount > 0 && kCount < registry_detail::kEmptySlot, "module list size out of range");
+
+    template <typename Module>
+    static ModulePtr make() { return std::make_shared<Module>(); }
+
+    static constexpr size_t kSlots = registry_detail::slot_count(kCount);
+    static constexpr auto kTable = registry_detail::build_table<kSlots>(kNames);
+    static_assert(kTable.found, "duplicate module type names (no collision-free hash seed)");
+
+    static constexpr std::array<ModulePtr (*)(), kCount> kCreators = {&make<Modules>...};
+};
+
+// Built-in module types ("gpio", "pwm", ...), in list order.
+const std::vector<std::string>& builtinModuleTypes();
+bool isBuiltinModuleType(std::string_view type);
+// nullptr for names outside the built-in list.
+ModulePtr createBuiltinModule(std::string_view type);
+
+[[deprecated("built-in modules are registered at compile time")]]
+inline void registerAllModules() {}
 
 }  // namespace picoforge
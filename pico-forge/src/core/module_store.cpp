@@ -0,0 +1,48 @@
+#include "module_store.h"
+
+#include <memory>
+#include <typeinfo>
+
+namespace picoforge {
+
+namespace {
+// Tries each variant alternative in turn; exact typeid match only, so test
+// doubles and other subclasses are never sliced into their base.
+template <size_t I = 0>
+bool copy_into(const IModule& m, ModuleStore& out) {
+    if constexpr (I == std::variant_size_v<ModuleVariant>) {
+        return false;
+    } else {
+        using M = std::variant_alternative_t<I, ModuleVariant>;
+        if (typeid(m) == typeid(M)) {
+            out.add(static_cast<const M&>(m));
+            return true;
+        }
+        return copy_into<I + 1>(m, out);
+    }
+}
+}  // namespace
+
+bool ModuleStore::fromList(const ModuleList& list, ModuleStore& out) {
+    out.clear();
+    out.reserve(list.size());
+    for (const auto& m : list) {
+        if (!m || !copy_into(*m, out)) {
+            out.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+ModuleList ModuleStore::toList() const {
+    ModuleList list;
+    list.reserve(modules_.size());
+    forEach([&list](const auto& m) {
+        using M = std::decay_t<decltype(m)>;
+        list.push_back(std::make_shared<M>(m));
+    });
+    return list;
+}
+
+}  // namespace picoforge
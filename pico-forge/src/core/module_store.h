@@ -0,0 +1,77 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "../modules/builtin_modules.h"
+#include "module.h"
+
+namespace picoforge {
+
+using ModuleVariant = BuiltinModules::apply<std::variant>;
+
+// Value-semantic alternative to ModuleList for large configs: every module is
+// stored inline in one contiguous vector (no per-module heap object, no
+// refcounts), in config order. forEach() hands out the concrete module type,
+// so callers can make non-virtual calls (see callEmit below).
+// Only built-in module types fit; plugin modules need ModuleList.
+class ModuleStore {
+public:
+    template <typename Module>
+    Module& add(Module module) {
+        return std::get<Module>(modules_.emplace_back(std::in_place_type<Module>, std::move(module)));
+    }
+
+    void reserve(size_t n) { modules_.reserve(n); }
+    size_t size() const { return modules_.size(); }
+    bool empty() const { return modules_.empty(); }
+    void clear() { modules_.clear(); }
+
+    // Calls fn(const ConcreteModule&) for each module, in order.
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& m : modules_) {
+            std::visit(fn, m);
+        }
+    }
+
+    const std::vector<ModuleVariant>& values() const { return modules_; }
+
+    // Copies a ModuleList whose entries are all exactly built-in types (not
+    // subclasses). Returns false and leaves `out` empty otherwise.
+    static bool fromList(const ModuleList& list, ModuleStore& out);
+    ModuleList toList() const;
+
+private:
+    std::vector<ModuleVariant> modules_;
+};
+
+// Statically bound calls: qualified names bypass the vtable when the concrete
+// type is known, and fall back to virtual dispatch for IModule.
+template <typename M>
+void callEmit(const M& m, CodeWriter& out) {
+    if constexpr (std::is_same_v<M, IModule>) m.emit(out);
+    else m.M::emit(out);
+}
+
+template <typename M>
+void callEmitDefinitions(const M& m, CodeWriter& out) {
+    if constexpr (std::is_same_v<M, IModule>) m.emitDefinitions(out);
+    else m.M::emitDefinitions(out);
+}
+
+template <typename M>
+void callEmitHeader(const M& m, CodeWriter& out) {
+    if constexpr (std::is_same_v<M, IModule>) m.emitHeader(out);
+    else m.M::emitHeader(out);
+}
+
+template <typename M>
+std::vector<Symbol> callDependencies(const M& m) {
+    if constexpr (std::is_same_v<M, IModule>) return m.dependencies();
+    else return m.M::dependencies();
+}
+
+}  // namespace picoforge
@@ -0,0 +1,224 @@
+#include "resource_allocator.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+
+#include "../modules/adc_module.h"
+#include "../modules/dma_module.h"
+#include "../modules/pio_module.h"
+#include "../utils/profiler.h"
+
+namespace picoforge {
+
+namespace {
+constexpr int kPioBlocks = 2;
+constexpr int kSmsPerBlock = 4;
+constexpr int kInstructionWords = 32;
+
+struct PioBlock {
+    uint32_t sms = 0;    // busy state machines
+    uint32_t words = 0;  // busy instruction words
+    std::vector<std::pair<std::string, int>> programs;  // loaded program -> offset
+
+    int loadedAt(const std::string& key) const {
+        for (const auto& [k, offset] : programs) {
+            if (k == key) return offset;
+        }
+        return -1;
+    }
+};
+
+struct PioPlacement {
+    int block = -1;
+    int sm = -1;
+    int offset = -1;
+    bool shared = false;
+};
+
+uint32_t run_mask(int start, int length) {
+    return length >= 32 ? ~0u : ((1u << length) - 1u) << start;
+}
+
+// Lowest start of `length` free bits within `width`, or -1.
+int find_free_run(uint32_t busy, int length, int width) {
+    for (int start = 0; start + length <= width; ++start) {
+        if ((busy & run_mask(start, length)) == 0) return start;
+    }
+    return -1;
+}
+
+// Gives every auto (-1) channel in `channels` the lowest free DMA channel.
+// Null entries are skipped. False if the channels run out.
+bool assign_channels(std::initializer_list<int*> channels, uint32_t& busy) {
+    for (int* channel : channels) {
+        if (!channel || *channel >= 0) continue;
+        *channel = find_free_run(busy, 1, resourceCapacity(ResourceKind::DmaChannel));
+        if (*channel < 0) return false;
+        busy |= 1u << *channel;
+    }
+    return true;
+}
+
+template <typename M>
+const M* exact(const ModulePtr& m) {
+    return m && typeid(*m) == typeid(M) ? static_cast<const M*>(m.get()) : nullptr;
+}
+
+// Identical programs loaded into one block share their instruction words.
+std::string program_key(const PioModule& pio) {
+    const auto& c = pio.config();
+    if (const PioProgram* program = pio.program()) {
+        std::string key = "asm:" + program->name;
+        for (uint16_t word : program->instructions) key += "/" + std::to_string(word);
+        return key;
+    }
+    return (c.preset.empty() ? "custom:" + c.name : c.preset) + "/" + std::to_string(pio.programLength());
+}
+
+std::optional<PioPlacement> try_block(const PioModule& pio, const PioBlock& block, int index) {
+    const auto& c = pio.config();
+    PioPlacement p;
+    p.block = index;
+
+    if (pio.placed()) {
+        p.sm = c.sm;  // already marked busy by the fixed-claim pass
+    } else if (c.sm >= 0) {
+        if (block.sms & run_mask(c.sm, c.sm_count)) return std::nullopt;
+        p.sm = c.sm;
+    } else {
+        p.sm = find_free_run(block.sms, c.sm_count, kSmsPerBlock);
+        if (p.sm < 0) return std::nullopt;
+    }
+
+    int length = pio.programLength();
+    if (length == 0) return p;
+    p.offset = block.loadedAt(program_key(pio));
+    if (p.offset >= 0) {
+        p.shared = true;
+    } else if (c.offset >= 0) {
+        if (block.words & run_mask(c.offset, length)) return std::nullopt;
+        p.offset = c.offset;
+    } else {
+        p.offset = find_free_run(block.words, length, kInstructionWords);
+        if (p.offset < 0) return std::nullopt;
+    }
+    return p;
+}
+
+// Lower is better: reuse a loaded program, then the less busy block, then the emptier memory.
+auto placement_rank(const PioPlacement& p, const PioBlock& block) {
+    return std::make_tuple(p.shared ? 0 : 1, std::bitset<32>(block.sms).count(),
+                           std::bitset<32>(block.words).count(), p.block);
+}
+}  // namespace
+
+AllocationResult ResourceAllocator::allocate(const ModuleList& modules) {
+    PF_PROFILE_SCOPE("allocate_resources");
+    AllocationResult result;
+    result.modules = modules;
+
+    uint32_t dma = 0;
+    PioBlock blocks[kPioBlocks];
+
+    // Fixed claims first, from every module, so auto placements route around them.
+    ResourceClaims claims;
+    for (const auto& m : modules) {
+        claims.clear();
+        m->claimResources(claims);
+        for (const auto& c : claims.all()) {
+            if (c.index < 0 || c.index >= resourceCapacity(c.kind)) continue;
+            if (c.kind == ResourceKind::DmaChannel) dma |= 1u << c.index;
+            if (c.kind == ResourceKind::PioStateMachine) {
+                blocks[c.index / kSmsPerBlock].sms |= 1u << (c.index % kSmsPerBlock);
+            }
+        }
+        const auto* pio = exact<PioModule>(m);
+        if (pio && pio->validate() && pio->placed() && pio->config().offset >= 0 && pio->programLength() > 0) {
+            auto& block = blocks[pio->config().block];
+            block.words |= run_mask(pio->config().offset, pio->programLength());
+            block.programs.emplace_back(program_key(*pio), pio->config().offset);
+        }
+    }
+
+    std::vector<size_t> pioPending;
+    for (size_t i = 0; i < modules.size(); ++i) {
+        if (!modules[i]->validate()) continue;  // reported by ConfigValidator, generated as written
+        if (const auto* d = exact<DmaModule>(modules[i])) {
+            DmaConfig cfg = d->config();
+            bool chained = cfg.stream.enabled() && cfg.stream.ping_pong;
+            if (!assign_channels({&cfg.channel, chained ? &cfg.stream.chain_channel : nullptr}, dma)) {
+                result.errors.push_back(d->id() + ": all DMA channels are in use");
+            } else if (cfg.channel != d->config().channel || cfg.stream.chain_channel != d->config().stream.chain_channel) {
+                result.modules[i] = std::make_shared<DmaModule>(std::move(cfg));
+            }
+        } else if (const auto* a = exact<AdcModule>(modules[i]); a && a->config().capture.enabled) {
+            AdcConfig cfg = a->config();
+            if (!assign_channels({&cfg.capture.dma_channel, &cfg.capture.chain_channel}, dma)) {
+                result.errors.push_back(a->id() + ": all DMA channels are in use");
+            } else if (cfg.capture.dma_channel != a->config().capture.dma_channel ||
+                       cfg.capture.chain_channel != a->config().capture.chain_channel) {
+                result.modules[i] = std::make_shared<AdcModule>(std::move(cfg));
+            }
+        } else if (const auto* p = exact<PioModule>(modules[i])) {
+            if (p->drivesLeds() && p->config().dma_channel < 0) {
+                PioConfig cfg = p->config();
+                if (!assign_channels({&cfg.dma_channel}, dma)) {
+                    result.errors.push_back(p->id() + ": all DMA channels are in use");
+                } else {
+                    result.modules[i] = std::make_shared<PioModule>(std::move(cfg));
+                }
+            }
+            if (!p->placed() || (p->config().offset < 0 && p->programLength() > 0)) pioPending.push_back(i);
+        }
+    }
+
+    // Largest programs first packs instruction memory tighter.
+    std::stable_sort(pioPending.begin(), pioPending.end(), [&modules](size_t a, size_t b) {
+        return static_cast<const PioModule&>(*modules[a]).programLength() >
+               static_cast<const PioModule&>(*modules[b]).programLength();
+    });
+
+    for (size_t i : pioPending) {
+        const auto& pio = static_cast<const PioModule&>(*result.modules[i]);  // may carry a DMA channel
+        const auto& cfg = pio.config();
+
+        std::optional<PioPlacement> best;
+        for (int b = 0; b < kPioBlocks; ++b) {
+            if (cfg.block >= 0 && cfg.block != b) continue;
+            auto p = try_block(pio, blocks[b], b);
+            if (p && (!best || placement_rank(*p, blocks[b]) < placement_rank(*best, blocks[best->block]))) {
+                best = p;
+            }
+        }
+        if (!best) {
+            result.errors.push_back(pio.id() + ": no PIO block has " + std::to_string(cfg.sm_count) +
+                                    " free state machine(s) and " + std::to_string(pio.programLength()) +
+                                    " free instruction word(s)");
+            continue;
+        }
+
+        auto& block = blocks[best->block];
+        block.sms |= run_mask(best->sm, cfg.sm_count);
+        if (best->offset >= 0 && !best->shared) {
+            block.words |= run_mask(best->offset, pio.programLength());
+            block.programs.emplace_back(program_key(pio), best->offset);
+        }
+
+        PioConfig placed = cfg;
+        placed.block = best->block;
+        placed.sm = best->sm;
+        placed.offset = best->offset;
+        result.modules[i] = std::make_shared<PioModule>(std::move(placed));
+    }
+
+    return result;
+}
+
+}  // namespace picoforge
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "module.h"
+
+namespace picoforge {
+
+struct AllocationResult {
+    ModuleList modules;               // same order; auto DMA/PIO/ADC-capture modules replaced by placed copies
+    std::vector<std::string> errors;  // one per module that could not be placed
+
+    bool ok() const { return errors.empty(); }
+};
+
+// Assigns concrete DMA channels, PIO blocks/state machines and PIO instruction
+// offsets at generation time, so the generated firmware uses fixed indices
+// instead of claiming at boot, and over-subscription fails here rather than on
+// the device.
+//
+// Fixed placements from the config are honoured first. PIO programs are then
+// placed largest first: a block that already holds the same program is reused,
+// otherwise the block with fewer busy state machines wins, so load spreads
+// across pio0 and pio1. Only exact DmaModule/PioModule instances, and the DMA
+// channels of an AdcModule capture, are placed; other modules keep whatever
+// they claim.
+class ResourceAllocator {
+public:
+    static AllocationResult allocate(const ModuleList& modules);
+};
+
+}  // namespace picoforge
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace picoforge {
+
+// RP2040 hardware that modules can hold exclusively.
+enum class ResourceKind : uint8_t {
+    Gpio,             // GPIO0-29
+    DmaChannel,       // 12 channels
+    PioStateMachine,  // pio0 SM0-3 are 0-3, pio1 SM0-3 are 4-7
+    PwmSlice,         // 0-7; GPIOn drives slice (n >> 1) & 7, whose wrap and divider set the frequency
+    Uart,             // uart0/uart1
+    I2c,              // i2c0/i2c1
+    Spi,              // spi0/spi1
+    Adc,              // the one converter; polled reads share it, capture holds it
+};
+
+constexpr size_t kResourceKindCount = 8;
+
+constexpr int resourceCapacity(ResourceKind kind) {
+    switch (kind) {
+        case ResourceKind::Gpio: return 30;
+        case ResourceKind::DmaChannel: return 12;
+        case ResourceKind::PioStateMachine: return 8;
+        case ResourceKind::PwmSlice: return 8;
+        case ResourceKind::Uart:
+        case ResourceKind::I2c:
+        case ResourceKind::Spi: return 2;
+        case ResourceKind::Adc: return 1;
+    }
+    return 0;
+}
+
+constexpr const char* resourceKindName(ResourceKind kind) {
+    switch (kind) {
+        case ResourceKind::Gpio: return "GPIO";
+        case ResourceKind::DmaChannel: return "DMA channel";
+        case ResourceKind::PioStateMachine: return "PIO state machine";
+        case ResourceKind::PwmSlice: return "PWM slice";
+        case ResourceKind::Uart: return "UART";
+        case ResourceKind::I2c: return "I2C";
+        case ResourceKind::Spi: return "SPI";
+        case ResourceKind::Adc: return "ADC";
+    }
+    return "resource";
+}
+
+// One unit of hardware a module needs. A fixed claim names its index; an
+// "any" claim (index < 0) accepts the first free unit in [first, first + span).
+struct ResourceClaim {
+    ResourceKind kind = ResourceKind::Gpio;
+    int index = -1;
+    int first = 0;
+    int span = 0;
+    const char* role = "";  // what the module uses it for ("tx", "sda", ...)
+    bool shared = false;    // fixed claim that other shared claims may also hold
+};
+
+// Collected from IModule::claimResources().
+class ResourceClaims {
+public:
+    // A negative index is an unset or invalid config value that validate()
+    // reports; it claims nothing rather than becoming an "any" claim.
+    void claim(ResourceKind kind, int index, const char* role) {
+        if (index >= 0) claims_.push_back(ResourceClaim{kind, index, 0, 0, role});
+    }
+
+    void claimShared(ResourceKind kind, int index, const char* role) {
+        if (index >= 0) claims_.push_back(ResourceClaim{kind, index, 0, 0, role, true});
+    }
+
+    void claimAny(ResourceKind kind, int first, int span, const char* role) {
+        claims_.push_back(ResourceClaim{kind, -1, first, span, role});
+    }
+
+    const std::vector<ResourceClaim>& all() const { return claims_; }
+    void clear() { claims_.clear(); }
+
+private:
+    std::vector<ResourceClaim> claims_;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,109 @@
+#include "thread_pool.h"
+
+namespace picoforge {
+
+namespace {
+// Index of the pool worker running on this thread, or npos for outside threads.
+thread_local size_t tls_worker_index = static_cast<size_t>(-1);
+thread_local const ThreadPool* tls_worker_pool = nullptr;
+}  // namespace
+
+ThreadPool::ThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0) threadCount = 1;
+    }
+
+    queues_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    // Workers keep their own spawned work local; outside callers spread round-robin.
+    size_t target = tls_worker_pool == this
+        ? tls_worker_index
+        : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+    pending_.fetch_add(1);
+    {
+        // Count the task before publishing it: a scanning worker may pop it
+        // the moment it lands, and its fetch_sub must not wrap queued_.
+        // Workers never take wakeMutex_ while holding a queue mutex.
+        std::lock_guard<std::mutex> wakeLock(wakeMutex_);
+        queued_.fetch_add(1);
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_front(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    idle_.wait(lock, [this]() { return pending_.load() == 0; });
+}
+
+bool ThreadPool::popLocal(size_t index, Task& out) {
+    auto& q = *queues_[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    out = std::move(q.tasks.front());
+    q.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, Task& out) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        auto& q = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        out = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tls_worker_index = index;
+    tls_worker_pool = this;
+
+    for (;;) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            queued_.fetch_sub(1);
+            try {
+                task();
+            } catch (...) {
+            }
+            if (pending_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                idle_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wake_.wait(lock, [this]() { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) return;
+    }
+}
+
+}  // namespace picoforge
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace picoforge {
+
+// Work-stealing thread pool. Each worker owns a deque: it pops its own work
+// from the front and steals from the back of its siblings when it runs dry.
+// Tasks must handle their own errors; escaping exceptions are swallowed.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    // threadCount == 0 picks std::thread::hardware_concurrency().
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished.
+    void waitIdle();
+
+    size_t size() const { return threads_.size(); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& out);
+    bool steal(size_t thief, Task& out);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> pending_{0};
+    std::atomic<size_t> nextQueue_{0};
+    bool stopping_ = false;
+};
+
+}  // namespace picoforge
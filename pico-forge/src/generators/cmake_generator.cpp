@@ -1,26 +1,122 @@
 #include "cmake_generator.h"
 
-#include <set>
+#include <algorithm>
+#include <iterator>
 #include <sstream>
+#include <string_view>
+
+#include "../core/dependency_graph.h"
+#include "../core/module_store.h"
 
 namespace picoforge {
 
-std::string CMakeGenerator::generate(const std::string& projectName, const ModuleList& modules) {
-    std::set<std::string> libs;
-    
-    for (const auto& m : modules) {
-        for (const auto& dep : m->dependencies()) {
-            if (dep.find("hardware/") == 0) {
-                libs.insert(dep.substr(9)); // strip "hardware/"
-            } else if (dep == "pico/time.h") {
-                libs.insert("pico_time");
-            }
-        }
+namespace {
+void add_dependencies(const std::vector<Symbol>& deps, DependencySet& set) {
+    for (Symbol dep : deps) {
+        set.addDependency(dep);
     }
-    
+}
+
+std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// Quoted CMake argument.
+std::string cmake_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\' || c == '$') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// hardware_* drivers are plain functions with no runtime hooks, so they survive
+// being linked from a static archive. The ones pico_stdlib links itself are
+// left out: its INTERFACE sources compile them into the project regardless.
+bool prebuildable(const std::string& lib) {
+    static constexpr std::string_view kStdlibDrivers[] = {
+        "hardware_base", "hardware_boot_lock", "hardware_claim", "hardware_clocks",
+        "hardware_divider", "hardware_gpio", "hardware_irq", "hardware_pll",
+        "hardware_resets", "hardware_sync", "hardware_sync_spin_lock", "hardware_ticks",
+        "hardware_timer", "hardware_uart", "hardware_vreg", "hardware_watchdog", "hardware_xosc",
+    };
+    return lib.rfind("hardware_", 0) == 0 &&
+           std::find(std::begin(kStdlibDrivers), std::end(kStdlibDrivers), lib) == std::end(kStdlibDrivers);
+}
+
+void render_sdk_cache(std::ostringstream& oss, const std::string& projectName,
+                      const std::vector<std::string>& libs, const std::string& cacheDir) {
+    oss << "# Prebuilt pico-sdk drivers shared by every project with the same SDK, board,\n";
+    oss << "# toolchain, flags and definitions. The first build populates the cache; an\n";
+    oss << "# archive is only imported once the key file written after it matches.\n";
+    oss << "set(PICOFORGE_SDK_CACHE " << cmake_string(cacheDir) << " CACHE PATH \"Prebuilt pico-sdk libraries\")\n";
+    oss << "set(PICOFORGE_SDK_LIBS";
+    for (const auto& lib : libs) oss << " " << lib;
+    oss << ")\n";
+    oss << "string(TOUPPER \"${CMAKE_BUILD_TYPE}\" PICOFORGE_BUILD_TYPE)\n";
+    oss << "get_directory_property(PICOFORGE_DIR_DEFINITIONS COMPILE_DEFINITIONS)\n";
+    oss << "get_directory_property(PICOFORGE_DIR_OPTIONS COMPILE_OPTIONS)\n";
+    oss << "string(JOIN \"\\n\" PICOFORGE_SDK_KEY_TEXT\n";
+    oss << "    \"${PICO_SDK_PATH} ${PICO_SDK_VERSION_STRING} ${PICO_PLATFORM} ${PICO_BOARD}\"\n";
+    oss << "    \"${CMAKE_C_COMPILER} ${CMAKE_C_COMPILER_ID} ${CMAKE_C_COMPILER_VERSION}\"\n";
+    oss << "    \"${CMAKE_C_FLAGS} ${CMAKE_C_FLAGS_${PICOFORGE_BUILD_TYPE}}\"\n";
+    oss << "    \"${CMAKE_ASM_FLAGS} ${CMAKE_ASM_FLAGS_${PICOFORGE_BUILD_TYPE}}\"\n";
+    oss << "    \"${PICOFORGE_DIR_DEFINITIONS}\" \"${PICOFORGE_DIR_OPTIONS}\" \"${PICOFORGE_SDK_LIBS}\")\n";
+    oss << "string(SHA256 PICOFORGE_SDK_KEY \"${PICOFORGE_SDK_KEY_TEXT}\")\n";
+    oss << "string(SUBSTRING \"${PICOFORGE_SDK_KEY}\" 0 16 PICOFORGE_SDK_KEY)\n";
+    oss << "set(PICOFORGE_SDK_DIR \"${PICOFORGE_SDK_CACHE}/${PICO_SDK_VERSION_STRING}/${PICO_BOARD}/${PICOFORGE_SDK_KEY}\")\n";
+    oss << "set(PICOFORGE_SDK_ARCHIVE \"${PICOFORGE_SDK_DIR}/libpicoforge_sdk.a\")\n";
+    oss << "set(PICOFORGE_SDK_KEY_FILE \"${PICOFORGE_SDK_DIR}/key.txt\")\n";
+    oss << "set(PICOFORGE_SDK_CACHED OFF)\n";
+    oss << "if(EXISTS \"${PICOFORGE_SDK_ARCHIVE}\" AND EXISTS \"${PICOFORGE_SDK_KEY_FILE}\")\n";
+    oss << "    file(READ \"${PICOFORGE_SDK_KEY_FILE}\" PICOFORGE_SDK_STORED_KEY)\n";
+    oss << "    if(PICOFORGE_SDK_STORED_KEY STREQUAL PICOFORGE_SDK_KEY_TEXT)\n";
+    oss << "        set(PICOFORGE_SDK_CACHED ON)\n";
+    oss << "    endif()\n";
+    oss << "endif()\n";
+    oss << "if(PICOFORGE_SDK_CACHED)\n";
+    oss << "    add_library(picoforge_sdk STATIC IMPORTED)\n";
+    oss << "    set_target_properties(picoforge_sdk PROPERTIES IMPORTED_LOCATION \"${PICOFORGE_SDK_ARCHIVE}\")\n";
+    oss << "else()\n";
+    oss << "    add_library(picoforge_sdk STATIC)\n";
+    oss << "    target_link_libraries(picoforge_sdk PRIVATE ${PICOFORGE_SDK_LIBS})\n";
+    oss << "    file(WRITE \"${CMAKE_CURRENT_BINARY_DIR}/picoforge_sdk_key.txt\" \"${PICOFORGE_SDK_KEY_TEXT}\")\n";
+    oss << "    # Copy then rename under names unique to this configure, so concurrent builds\n";
+    oss << "    # never import a partial archive. The key goes last and marks it complete.\n";
+    oss << "    string(RANDOM LENGTH 12 PICOFORGE_SDK_TMP)\n";
+    oss << "    add_custom_command(TARGET picoforge_sdk POST_BUILD\n";
+    oss << "        COMMAND ${CMAKE_COMMAND} -E make_directory \"${PICOFORGE_SDK_DIR}\"\n";
+    oss << "        COMMAND ${CMAKE_COMMAND} -E copy $<TARGET_FILE:picoforge_sdk> \"${PICOFORGE_SDK_ARCHIVE}.${PICOFORGE_SDK_TMP}\"\n";
+    oss << "        COMMAND ${CMAKE_COMMAND} -E rename \"${PICOFORGE_SDK_ARCHIVE}.${PICOFORGE_SDK_TMP}\" \"${PICOFORGE_SDK_ARCHIVE}\"\n";
+    oss << "        COMMAND ${CMAKE_COMMAND} -E copy \"${CMAKE_CURRENT_BINARY_DIR}/picoforge_sdk_key.txt\" \"${PICOFORGE_SDK_KEY_FILE}.${PICOFORGE_SDK_TMP}\"\n";
+    oss << "        COMMAND ${CMAKE_COMMAND} -E rename \"${PICOFORGE_SDK_KEY_FILE}.${PICOFORGE_SDK_TMP}\" \"${PICOFORGE_SDK_KEY_FILE}\"\n";
+    oss << "        VERBATIM\n";
+    oss << "    )\n";
+    oss << "endif()\n";
+    // The _headers targets carry include paths and definitions without the sources.
+    oss << "list(TRANSFORM PICOFORGE_SDK_LIBS APPEND _headers OUTPUT_VARIABLE PICOFORGE_SDK_HEADERS)\n";
+    oss << "target_link_libraries(" << projectName << " picoforge_sdk ${PICOFORGE_SDK_HEADERS})\n\n";
+}
+
+std::string render(const std::string& projectName, const DependencySet& deps, const CMakeOptions& options) {
     std::ostringstream oss;
     oss << "cmake_minimum_required(VERSION 3.13)\n\n";
     oss << "include(pico_sdk_import.cmake)\n\n";
+
+    if (!options.compilerLauncher.empty()) {
+        oss << "find_program(PICOFORGE_COMPILER_LAUNCHER " << cmake_string(options.compilerLauncher) << ")\n";
+        oss << "if(PICOFORGE_COMPILER_LAUNCHER)\n";
+        oss << "    set(CMAKE_C_COMPILER_LAUNCHER ${PICOFORGE_COMPILER_LAUNCHER})\n";
+        oss << "    set(CMAKE_CXX_COMPILER_LAUNCHER ${PICOFORGE_COMPILER_LAUNCHER})\n";
+        oss << "endif()\n\n";
+    }
+
     oss << "project(" << projectName << " C CXX ASM)\n";
     oss << "set(CMAKE_C_STANDARD 11)\n";
     oss << "set(CMAKE_CXX_STANDARD 17)\n\n";
@@ -28,14 +124,102 @@ std::string CMakeGenerator::generate(const std::string& projectName, const Modul
     oss << "add_executable(" << projectName << "\n    main.cpp\n)\n\n";
     oss << "target_link_libraries(" << projectName << "\n    pico_stdlib\n";
     
-    for (const auto& lib : libs) {
+    std::vector<std::string> prebuilt;
+    for (const auto& lib : deps.libraries()) {
+        if (!options.sdkCacheDir.empty() && prebuildable(lib)) {
+            prebuilt.push_back(lib);
+            continue;
+        }
         oss << "    " << lib << "\n";
     }
     
     oss << ")\n\n";
+    if (!prebuilt.empty()) {
+        render_sdk_cache(oss, projectName, prebuilt, options.sdkCacheDir);
+    }
+
+    if (options.precompileHeaders || options.unityBuild) {
+        oss << "if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.16)\n";
+    }
+    if (options.precompileHeaders) {
+        // Most of a firmware build is spent parsing pico-sdk headers. Scoped to
+        // C++ so the SDK's C sources compiled into this target get no PCH of
+        // their own; $<ANGLE-R> keeps the header's '>' from closing the genex.
+        oss << "    target_precompile_headers(" << projectName << " PRIVATE\n";
+        for (const auto& header : deps.sdkHeaders()) {
+            oss << "        \"$<$<COMPILE_LANGUAGE:CXX>:<" << header << "$<ANGLE-R>>\"\n";
+        }
+        oss << "    )\n";
+    }
+    if (options.unityBuild) {
+        // The SDK's interface libraries compile their sources into this target, so
+        // they batch too. SDK sources are not written for that and can clash on
+        // file-local names; the generated file says how to keep one out.
+        oss << "    # pico-sdk sources batch too. One that clashes with its neighbours can be\n";
+        oss << "    # compiled alone: -DPICOFORGE_UNITY_SKIP=<path>[;<path>...]\n";
+        oss << "    set(PICOFORGE_UNITY_SKIP \"\" CACHE STRING \"Sources kept out of unity batches\")\n";
+        oss << "    if(PICOFORGE_UNITY_SKIP)\n";
+        oss << "        set_source_files_properties(${PICOFORGE_UNITY_SKIP} PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON)\n";
+        oss << "    endif()\n";
+        oss << "    set_target_properties(" << projectName << " PROPERTIES\n";
+        oss << "        UNITY_BUILD ON\n";
+        oss << "        UNITY_BUILD_BATCH_SIZE " << options.unityBatchSize << "\n";
+        oss << "    )\n";
+    }
+    if (options.precompileHeaders || options.unityBuild) {
+        oss << "endif()\n\n";
+    }
+
     oss << "pico_add_extra_outputs(" << projectName << ")\n";
     
     return oss.str();
 }
+}  // namespace
+
+std::string CMakeOptions::key() const {
+    return "generator=" + generator + ";launcher=" + compilerLauncher +
+           ";unity=" + (unityBuild ? std::to_string(unityBatchSize) : std::string("off")) +
+           ";pch=" + (precompileHeaders ? "on" : "off") +
+           ";presets=" + (wantsPresets() ? "on" : "off") + ";sdk_cache=" + sdkCacheDir;
+}
+
+std::string CMakeGenerator::generate(const std::string& projectName, const ModuleList& modules,
+                                     const CMakeOptions& options) {
+    DependencySet deps;
+    for (const auto& m : modules) {
+        add_dependencies(m->dependencies(), deps);
+    }
+    return render(projectName, deps, options);
+}
+
+std::string CMakeGenerator::generate(const std::string& projectName, const ModuleStore& modules,
+                                     const CMakeOptions& options) {
+    DependencySet deps;
+    modules.forEach([&deps](const auto& m) { add_dependencies(callDependencies(m), deps); });
+    return render(projectName, deps, options);
+}
+
+std::string CMakeGenerator::presets(const std::string& projectName, const CMakeOptions& options) {
+    std::ostringstream oss;
+    oss << "{\n";
+    oss << "    \"version\": 3,\n";
+    oss << "    \"cmakeMinimumRequired\": { \"major\": 3, \"minor\": 21, \"patch\": 0 },\n";
+    oss << "    \"configurePresets\": [\n";
+    oss << "        {\n";
+    oss << "            \"name\": \"default\",\n";
+    oss << "            \"displayName\": " << json_string(projectName) << ",\n";
+    if (!options.generator.empty()) {
+        oss << "            \"generator\": " << json_string(options.generator) << ",\n";
+    }
+    oss << "            \"binaryDir\": \"${sourceDir}/build\",\n";
+    oss << "            \"cacheVariables\": { \"CMAKE_BUILD_TYPE\": \"Release\" }\n";
+    oss << "        }\n";
+    oss << "    ],\n";
+    oss << "    \"buildPresets\": [\n";
+    oss << "        { \"name\": \"default\", \"configurePreset\": \"default\" }\n";
+    oss << "    ]\n";
+    oss << "}\n";
+    return oss.str();
+}
 
 }  // namespace picoforge
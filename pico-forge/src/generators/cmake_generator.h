@@ -7,9 +7,45 @@
 
 namespace picoforge {
 
+class ModuleStore;
+
+// Build-speed knobs for the generated project. The defaults produce the plain
+// CMakeLists.txt.
+struct CMakeOptions {
+    // Generator recorded in CMakePresets.json, e.g. "Ninja" ("" keeps CMake's
+    // default). A plain `cmake -S . -B build` ignores it; use `--preset default`.
+    std::string generator;
+    // Wraps every compile, e.g. "ccache"; ignored at configure time if not installed.
+    std::string compilerLauncher;
+    // Compile main.cpp and the pico-sdk sources linked into it in unity batches.
+    // SDK sources that clash in a batch can be excluded at configure time with
+    // PICOFORGE_UNITY_SKIP.
+    bool unityBuild = false;
+    int unityBatchSize = 16;
+    // Precompile the pico-sdk headers in use for main.cpp (C++ only, CMake 3.16+).
+    bool precompileHeaders = false;
+    // Write CMakePresets.json (implied by choosing a generator).
+    bool presets = false;
+    // Shared directory of prebuilt hardware_* libraries, keyed by SDK, board,
+    // toolchain, flags and definitions. Drivers pico_stdlib already links
+    // (gpio, uart, clocks, ...) are not cached. Empty compiles the SDK into
+    // every project.
+    std::string sdkCacheDir;
+
+    bool wantsPresets() const { return presets || !generator.empty(); }
+    // Folded into generation cache keys.
+    std::string key() const;
+};
+
 class CMakeGenerator {
 public:
-    static std::string generate(const std::string& projectName, const ModuleList& modules);
+    static std::string generate(const std::string& projectName, const ModuleList& modules,
+                                const CMakeOptions& options = {});
+    static std::string generate(const std::string& projectName, const ModuleStore& modules,
+                                const CMakeOptions& options = {});
+
+    // CMakePresets.json with one "default" configure/build preset (binary dir build/).
+    static std::string presets(const std::string& projectName, const CMakeOptions& options);
 };
 
 }  // namespace picoforge
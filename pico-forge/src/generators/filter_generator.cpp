@@ -0,0 +1,241 @@
+#include "filter_generator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace picoforge {
+
+namespace {
+constexpr int kMaxAverageLength = 1024;
+constexpr int kMaxCicOrder = 5;
+constexpr uint64_t kSampleRange = 4096;  // 12-bit ADC samples
+constexpr double kPi = 3.14159265358979323846;
+
+int floor_log2(uint32_t v) {
+    int bits = 0;
+    while (v >>= 1) ++bits;
+    return bits;
+}
+
+// A boxcar of N taps is 3 dB down at about 0.443 fs / N.
+std::optional<FilterDesign> design_average(const FilterSpec& spec, FilterDesign d) {
+    if (spec.length > 0) {
+        d.length = spec.length;
+    } else if (spec.bandwidth_hz > 0 && 2 * spec.bandwidth_hz < d.sample_rate_hz) {
+        d.length = std::max(1, static_cast<int>(std::lround(0.443 * d.sample_rate_hz / spec.bandwidth_hz)));
+    } else {
+        return std::nullopt;
+    }
+    if (d.length > kMaxAverageLength) return std::nullopt;
+    d.gain = FilterGenerator::reciprocal(static_cast<uint32_t>(d.length));
+    return d;
+}
+
+// Output rate 4x the bandwidth puts each stage's sinc droop there near 0.9 dB,
+// so three stages land close to -3 dB.
+std::optional<FilterDesign> design_cic(const FilterSpec& spec, FilterDesign d) {
+    d.order = spec.order > 0 ? spec.order : 3;
+    if (spec.decimation > 0) {
+        d.decimation = spec.decimation;
+    } else if (spec.bandwidth_hz > 0) {
+        d.decimation = d.sample_rate_hz / (4 * spec.bandwidth_hz);
+    } else {
+        return std::nullopt;
+    }
+    if (d.order > kMaxCicOrder || d.decimation < 2) return std::nullopt;
+    // Integrators wrap mod 2^32; the comb output is exact while the gain R^M fits.
+    uint64_t gain = 1;
+    for (int i = 0; i < d.order; ++i) {
+        gain *= static_cast<uint64_t>(d.decimation);
+        if (gain * kSampleRange > (uint64_t{1} << 32)) return std::nullopt;
+    }
+    d.gain = FilterGenerator::reciprocal(static_cast<uint32_t>(gain));
+    return d;
+}
+
+// RBJ cookbook low-pass, Q = 1/sqrt(2) (Butterworth). The feed-forward taps
+// are fixed up after rounding so the DC gain stays exactly one.
+std::optional<FilterDesign> design_biquad(const FilterSpec& spec, FilterDesign d) {
+    if (spec.bandwidth_hz <= 0 || 2 * spec.bandwidth_hz >= d.sample_rate_hz) return std::nullopt;
+    double w0 = 2.0 * kPi * spec.bandwidth_hz / d.sample_rate_hz;
+    double alpha = std::sin(w0) / std::sqrt(2.0);
+    double cosw = std::cos(w0);
+    double a0 = 1.0 + alpha;
+    double one = static_cast<double>(1 << FilterDesign::kBiquadShift);
+
+    d.a[0] = static_cast<int32_t>(std::lround(-2.0 * cosw / a0 * one));
+    d.a[1] = static_cast<int32_t>(std::lround((1.0 - alpha) / a0 * one));
+    d.b[0] = d.b[2] = static_cast<int32_t>(std::lround((1.0 - cosw) / 2.0 / a0 * one));
+    int64_t dc = static_cast<int64_t>(one) + d.a[0] + d.a[1];
+    d.b[1] = static_cast<int32_t>(dc - 2 * int64_t{d.b[0]});
+    if (d.b[0] < 1) return std::nullopt;  // bandwidth too small for the coefficient precision
+    return d;
+}
+
+}  // namespace
+
+std::optional<FilterDesign> FilterGenerator::design(const FilterSpec& spec, int sampleRateHz, int slots) {
+    if (sampleRateHz <= 0 || slots < 1) return std::nullopt;
+    FilterDesign d;
+    d.slots = slots;
+    d.sample_rate_hz = sampleRateHz;
+    if (spec.type == "average") {
+        d.kind = FilterKind::MovingAverage;
+        return design_average(spec, d);
+    }
+    if (spec.type == "cic") {
+        d.kind = FilterKind::Cic;
+        return design_cic(spec, d);
+    }
+    if (spec.type == "biquad") {
+        d.kind = FilterKind::Biquad;
+        return design_biquad(spec, d);
+    }
+    return std::nullopt;
+}
+
+FixedScale FilterGenerator::reciprocal(uint32_t divisor) {
+    FixedScale s;
+    if (divisor <= 1) return s;
+    int bits = floor_log2(divisor);
+    if ((divisor & (divisor - 1)) == 0) {
+        s.shift = bits;
+        return s;
+    }
+    // 2^(32+bits) / divisor lies in (2^31, 2^32).
+    s.shift = 32 + bits;
+    s.multiplier = static_cast<uint32_t>(((uint64_t{1} << s.shift) + divisor / 2) / divisor);
+    return s;
+}
+
+std::string FilterGenerator::scaled(const std::string& value, FixedScale scale) {
+    if (scale.shift == 0) return "(uint16_t)" + value;
+    std::string round = std::to_string(uint64_t{1} << (scale.shift - 1));
+    std::string shift = std::to_string(scale.shift);
+    if (scale.multiplier == 1) {
+        return "(uint16_t)((" + value + " + " + round + "u) >> " + shift + ")";
+    }
+    return "(uint16_t)(((uint64_t)" + value + " * " + std::to_string(scale.multiplier) + "u + " + round +
+           "ull) >> " + shift + ")";
+}
+
+int FilterGenerator::maxOutput(const FilterDesign& design, int inputSamples) {
+    if (design.kind != FilterKind::Cic) return inputSamples;
+    int frames = inputSamples / design.slots;
+    return (frames + design.decimation - 1) / design.decimation * design.slots;
+}
+
+void FilterGenerator::emitKernel(const std::string& prefix, const FilterDesign& d, CodeWriter& out) {
+    const std::string t = prefix + "_filter_t";
+    const int slots = d.slots;
+
+    switch (d.kind) {
+        case FilterKind::MovingAverage:
+            out << "// " << prefix << ": " << d.length << "-tap moving average per input, " << d.sample_rate_hz
+                << " Hz. Outputs ramp up over the first " << d.length << " frames.\n";
+            out << "typedef struct {\n";
+            out.indent();
+            out << "uint16_t history[" << slots << "][" << d.length << "];\n";
+            out << "uint32_t sum[" << slots << "];\n";
+            out << "uint32_t pos;  // history column the next frame replaces\n";
+            out.dedent();
+            out << "} " << t << ";\n\n";
+            break;
+        case FilterKind::Cic:
+            out << "// " << prefix << ": " << d.order << "-stage CIC decimator per input, R = " << d.decimation
+                << " (" << d.sample_rate_hz << " Hz -> " << d.outputRateHz() << " Hz).\n";
+            out << "typedef struct {\n";
+            out.indent();
+            out << "uint32_t integrator[" << slots << "][" << d.order << "];  // wraps mod 2^32; the combs undo it\n";
+            out << "uint32_t comb[" << slots << "][" << d.order << "];        // previous input of each comb\n";
+            out << "uint32_t phase;  // frames since the last output\n";
+            out.dedent();
+            out << "} " << t << ";\n\n";
+            break;
+        case FilterKind::Biquad:
+            out << "// " << prefix << ": 2nd-order Butterworth low-pass per input, " << d.sample_rate_hz
+                << " Hz. Q" << FilterDesign::kBiquadShift << " taps, Q16 state.\n";
+            out << "static const int32_t " << prefix << "_filter_b[3] = {" << d.b[0] << ", " << d.b[1] << ", "
+                << d.b[2] << "};\n";
+            out << "static const int32_t " << prefix << "_filter_a[2] = {" << d.a[0] << ", " << d.a[1] << "};\n\n";
+            out << "typedef struct {\n";
+            out.indent();
+            for (const char* name : {"x1", "x2", "y1", "y2"}) {
+                out << "int32_t " << name << "[" << slots << "];\n";
+            }
+            out.dedent();
+            out << "} " << t << ";\n\n";
+            break;
+    }
+
+    out << "static uint32_t " << prefix << "_filter_block(" << t
+        << "* f, const uint16_t* in, uint32_t n, uint16_t* out) {\n";
+    out.indent();
+    if (d.kind == FilterKind::Cic) out << "uint32_t written = 0;\n";
+    out << "for (uint32_t i = 0; i < n; i += " << slots << ") {\n";
+    out.indent();
+
+    switch (d.kind) {
+        case FilterKind::MovingAverage:
+            out << "for (uint32_t s = 0; s < " << slots << "; ++s) {\n";
+            out.indent();
+            out << "f->sum[s] += (uint32_t)in[i + s] - f->history[s][f->pos];\n";
+            out << "f->history[s][f->pos] = in[i + s];\n";
+            out << "out[i + s] = " << scaled("f->sum[s]", d.gain) << ";\n";
+            out.dedent();
+            out << "}\n";
+            out << "if (++f->pos == " << d.length << ") f->pos = 0;\n";
+            break;
+        case FilterKind::Cic:
+            out << "for (uint32_t s = 0; s < " << slots << "; ++s) {\n";
+            out.indent();
+            out << "uint32_t acc = in[i + s];\n";
+            out << "for (uint32_t k = 0; k < " << d.order << "; ++k) acc = f->integrator[s][k] += acc;\n";
+            out.dedent();
+            out << "}\n";
+            out << "if (++f->phase < " << d.decimation << ") continue;\n";
+            out << "f->phase = 0;\n";
+            out << "for (uint32_t s = 0; s < " << slots << "; ++s) {\n";
+            out.indent();
+            out << "uint32_t acc = f->integrator[s][" << d.order - 1 << "];\n";
+            out << "for (uint32_t k = 0; k < " << d.order << "; ++k) {\n";
+            out.indent();
+            out << "uint32_t prev = f->comb[s][k];\n";
+            out << "f->comb[s][k] = acc;\n";
+            out << "acc -= prev;\n";
+            out.dedent();
+            out << "}\n";
+            out << "out[written++] = " << scaled("acc", d.gain) << ";\n";
+            out.dedent();
+            out << "}\n";
+            break;
+        case FilterKind::Biquad: {
+            const std::string b = prefix + "_filter_b";
+            const std::string a = prefix + "_filter_a";
+            out << "for (uint32_t s = 0; s < " << slots << "; ++s) {\n";
+            out.indent();
+            out << "int32_t x = (int32_t)in[i + s] << 16;\n";
+            out << "int64_t acc = (int64_t)" << b << "[0] * x + (int64_t)" << b << "[1] * f->x1[s]\n";
+            out << "            + (int64_t)" << b << "[2] * f->x2[s] - (int64_t)" << a << "[0] * f->y1[s]\n";
+            out << "            - (int64_t)" << a << "[1] * f->y2[s];\n";
+            out << "int32_t y = (int32_t)(acc >> " << FilterDesign::kBiquadShift << ");\n";
+            out << "int32_t r = (y + 32768) >> 16;\n";
+            out << "f->x2[s] = f->x1[s];\n";
+            out << "f->x1[s] = x;\n";
+            out << "f->y2[s] = f->y1[s];\n";
+            out << "f->y1[s] = y;\n";
+            out << "out[i + s] = (uint16_t)(r < 0 ? 0 : r > 65535 ? 65535 : r);\n";
+            out.dedent();
+            out << "}\n";
+            break;
+        }
+    }
+
+    out.dedent();
+    out << "}\n";
+    out << "return " << (d.kind == FilterKind::Cic ? "written" : "n") << ";\n";
+    out.dedent();
+    out << "}\n\n";
+}
+
+}  // namespace picoforge
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "../core/code_writer.h"
+
+namespace picoforge {
+
+// Requested filter; empty `type` means none. Unset (0) fields are derived
+// from the sample rate and `bandwidth_hz`.
+struct FilterSpec {
+    std::string type;      // "average", "cic" or "biquad" (low-pass)
+    int bandwidth_hz = 0;  // -3 dB point
+    int decimation = 0;    // CIC rate change R
+    int order = 0;         // CIC stages (default 3)
+    int length = 0;        // moving average taps
+
+    bool enabled() const { return !type.empty(); }
+};
+
+enum class FilterKind { MovingAverage, Cic, Biquad };
+
+// Division by a constant as (x * multiplier + round) >> shift; rounds
+// correctly for x up to 4096 times the divisor.
+struct FixedScale {
+    uint32_t multiplier = 1;
+    int shift = 0;
+};
+
+// Everything the kernel needs, fixed at generation time.
+struct FilterDesign {
+    FilterKind kind = FilterKind::MovingAverage;
+    int slots = 1;          // interleaved inputs per frame
+    int sample_rate_hz = 0; // per slot
+    int length = 1;         // moving average taps
+    int decimation = 1;     // CIC R (outputs every R frames)
+    int order = 1;          // CIC stages
+    FixedScale gain;        // removes the average / CIC DC gain
+    int32_t b[3] = {0, 0, 0};  // biquad feed-forward, Q(kBiquadShift)
+    int32_t a[2] = {0, 0};     // biquad feedback a1, a2, Q(kBiquadShift)
+
+    static constexpr int kBiquadShift = 28;
+
+    int outputRateHz() const { return sample_rate_hz / decimation; }
+};
+
+// Fixed-point filter kernels for 12-bit sample blocks. Coefficients, lengths
+// and shifts are worked out here; the emitted code is plain C99 that needs
+// only <stdint.h>, so it builds and runs on the host as well as the Pico.
+class FilterGenerator {
+public:
+    // Nullopt if the spec cannot be met (unknown type, bandwidth at or past
+    // Nyquist, CIC bit growth past 32 bits, ...).
+    static std::optional<FilterDesign> design(const FilterSpec& spec, int sampleRateHz, int slots = 1);
+
+    static FixedScale reciprocal(uint32_t divisor);
+    // C expression dividing the unsigned `value` by the divisor `scale` was built for.
+    static std::string scaled(const std::string& value, FixedScale scale);
+
+    // Emits `<prefix>_filter_t` (zero-initialized state is ready to run) and
+    // `uint32_t <prefix>_filter_block(<prefix>_filter_t*, const uint16_t* in,
+    // uint32_t n, uint16_t* out)`, which consumes n interleaved samples (whole
+    // frames) and returns the number written to out.
+    static void emitKernel(const std::string& prefix, const FilterDesign& design, CodeWriter& out);
+
+    // Most samples one call for an n-sample input can write.
+    static int maxOutput(const FilterDesign& design, int inputSamples);
+};
+
+}  // namespace picoforge
@@ -1,28 +1,147 @@
 #include "main_generator.h"
 
-#include <set>
-#include <sstream>
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include "../core/code_writer.h"
+#include "../core/dependency_graph.h"
+#include "../core/module_store.h"
+#include "../utils/profiler.h"
 
 namespace picoforge {
 
+namespace {
+// The angle-bracket includes are those of the modules' dependencies(), the same
+// set CMakeLists.txt links from (minimal, sorted). Emitted header lines that set
+// covers are dropped; any other line is de-duplicated verbatim and written after.
+void write_unique_headers(const std::vector<std::string_view>& fragments, const DependencySet& deps,
+                          CodeWriter& out) {
+    PF_PROFILE_SCOPE("dedup_headers");
+    constexpr std::string_view kInclude = "#include <";
+    std::vector<std::string_view> other;
+    for (auto fragment : fragments) {
+        while (!fragment.empty()) {
+            size_t end = fragment.find('\n');
+            auto line = fragment.substr(0, end);
+            fragment.remove_prefix(end == std::string_view::npos ? fragment.size() : end + 1);
+            bool covered = line.rfind(kInclude, 0) == 0 && line.back() == '>' &&
+                           deps.covers(line.substr(kInclude.size(), line.size() - kInclude.size() - 1));
+            if (!covered && !line.empty()) other.push_back(line);
+        }
+    }
+
+    for (const auto& header : deps.includes()) {
+        out << kInclude << header << ">\n";
+    }
+    std::sort(other.begin(), other.end());
+    other.erase(std::unique(other.begin(), other.end()), other.end());
+    for (auto line : other) {
+        out << line << "\n";
+    }
+}
+
+// Every module writes into the same two buffers; header fragments are
+// remembered as spans and de-duplicated once all modules have emitted.
+// `forEach` visits modules in order, passing either IModule or a concrete type.
+template <typename ForEach>
+GeneratedCode generate_modules(size_t count, ForEach&& forEach) {
+    CodeWriter body(count * 160 + 64);
+    CodeWriter headerScratch(count * 32 + 64);
+    CodeWriter definitions(256);
+    std::vector<std::pair<size_t, size_t>> headerSpans;
+    headerSpans.reserve(count);
+    DependencySet deps;
+
+    forEach([&](const auto& m) {
+        size_t start = headerScratch.size();
+        {
+            PF_PROFILE_SCOPE_DETAIL("emit_header", m.id());
+            callEmitHeader(m, headerScratch);
+        }
+        headerSpans.emplace_back(start, headerScratch.size() - start);
+        for (Symbol dep : callDependencies(m)) deps.addDependency(dep);
+        callEmitDefinitions(m, definitions);
+        PF_PROFILE_SCOPE_DETAIL("emit_init", m.id());
+        callEmit(m, body);
+    });
+
+    std::vector<std::string_view> fragments;
+    fragments.reserve(headerSpans.size());
+    for (const auto& [offset, length] : headerSpans) {
+        fragments.push_back(headerScratch.view(offset, length));
+    }
+    CodeWriter headers(headerScratch.size());
+    write_unique_headers(fragments, deps, headers);
+
+    GeneratedCode out;
+    out.headers = headers.take();
+    out.mainBody = body.take();
+    out.definitions = definitions.take();
+    return out;
+}
+}  // namespace
+
 GeneratedCode MainGenerator::generate(const ModuleList& modules) const {
-    std::set<std::string> header_set;
-    std::ostringstream body;
+    return generate_modules(modules.size(), [&modules](const auto& emitOne) {
+        for (const auto& m : modules) emitOne(*m);
+    });
+}
+
+GeneratedCode MainGenerator::generate(const ModuleStore& modules) const {
+    return generate_modules(modules.size(), [&modules](const auto& emitOne) { modules.forEach(emitOne); });
+}
 
-    for (const auto& m : modules) {
-        header_set.insert(m->generateHeaderCode());
-        body << m->generateInitCode();
+GeneratedCode MainGenerator::assemble(const std::vector<const ModuleFragment*>& fragments,
+                                     const DependencySet& deps) {
+    std::vector<std::string_view> headerFragments;
+    headerFragments.reserve(fragments.size());
+    size_t bodySize = 0;
+    for (const auto* f : fragments) {
+        headerFragments.push_back(f->headers);
+        bodySize += f->init.size();
     }
 
-    std::ostringstream headers;
-    for (const auto& h : header_set) {
-        headers << h;
+    CodeWriter body(bodySize);
+    CodeWriter definitions;
+    for (const auto* f : fragments) {
+        body << f->init;
+        definitions << f->definitions;
     }
+    CodeWriter headers;
+    write_unique_headers(headerFragments, deps, headers);
 
     GeneratedCode out;
-    out.headers = headers.str();
-    out.mainBody = body.str();
+    out.headers = headers.take();
+    out.mainBody = body.take();
+    out.definitions = definitions.take();
     return out;
 }
 
+std::string MainGenerator::composeMainSource(const GeneratedCode& code) {
+    PF_PROFILE_SCOPE("compose_main");
+    CodeWriter out(code.headers.size() + code.definitions.size() + code.mainBody.size() * 5 / 4 + 512);
+    out << "#include <stdio.h>\n";
+    out << "#include \"pico/stdlib.h\"\n";
+    out << code.headers << "\n";
+    out << "// [USER_CODE] includes\n";
+    out << "// [USER_CODE] END\n\n";
+    out << code.definitions;  // each module's block ends with a blank line
+    out << "int main() {\n";
+    out.indent();
+    out << "stdio_init_all();\n\n";
+    out << code.mainBody;
+    out << "\n// [USER_CODE] main_loop\n";
+    out << "while (true) {\n";
+    out.indent();
+    out << "tight_loop_contents();\n";
+    out.dedent();
+    out << "}\n";
+    out << "// [USER_CODE] END\n\n";
+    out << "return 0;\n";
+    out.dedent();
+    out << "}\n";
+    return out.take();
+}
+
 }  // namespace picoforge
@@ -2,14 +2,28 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 #include "../core/code_generator.h"
 
 namespace picoforge {
 
+class DependencySet;
+class ModuleStore;
+
 class MainGenerator : public ICodeGenerator {
 public:
     GeneratedCode generate(const ModuleList& modules) const override;
+    // Same output from contiguous storage, with statically bound module calls.
+    GeneratedCode generate(const ModuleStore& modules) const;
+
+    // Combines per-module fragments exactly as generate() does; `deps` holds
+    // the modules' dependencies(), which decide the #include <...> set.
+    static GeneratedCode assemble(const std::vector<const ModuleFragment*>& fragments, const DependencySet& deps);
+
+    // Wraps generated headers/body into a complete main.cpp with the
+    // standard [USER_CODE] blocks ("includes", "main_loop").
+    static std::string composeMainSource(const GeneratedCode& code);
 };
 
 }  // namespace picoforge
@@ -1,24 +1,197 @@
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "config/config_parser.h"
-#include "generators/main_generator.h"
+#include "core/batch_runner.h"
+#ifdef PICOFORGE_HAS_DAEMON
+#include "core/daemon.h"
+#endif
+#include "core/generation_cache.h"
+#include "core/generation_pipeline.h"
+#include "core/thread_pool.h"
+#include "utils/profiler.h"
+
+namespace {
+void print_usage() {
+    std::cerr << "Usage: pico-forge <config.json> [-o DIR [--incremental]] [cache options]\n"
+              << "       pico-forge --batch <manifest.txt> [-j N] [--incremental] [cache options]\n"
+              << "       pico-forge --serve [--socket PATH] [--root DIR] [--max-clients N] [-j N] [--max-queue N]\n"
+              << "                          [cache options]\n"
+              << "Cache options: --cache-dir DIR [--cache-max-mb N]\n"
+              << "Build options: --ninja, --ccache or --launcher PROG, --unity, --pch, --presets, --sdk-cache DIR\n"
+              << "  (--ninja writes CMakePresets.json with the Ninja generator; configure with --preset default)\n"
+              << "Any mode: --profile TRACE.json writes per-phase timings (Chrome trace format)\n";
+}
+
+void print_cache_stats(const picoforge::GenerationCache* cache) {
+    if (!cache) return;
+    auto s = cache->stats();
+    std::cerr << "cache: " << s.hits << " hits, " << s.misses << " misses, "
+              << s.evictions << " evictions, " << s.entries << " entries ("
+              << s.bytes << " bytes)\n";
+}
+
+int run_single(const std::string& configPath, const std::string& outputDir,
+               const picoforge::GenerationOptions& options) {
+    auto output = picoforge::GenerationPipeline::generateFile(configPath, options, outputDir);
+    if (!outputDir.empty()) {
+        auto files = picoforge::GenerationPipeline::writeProject(output, outputDir);
+        std::cout << output.projectName << ": " << output.moduleCount << " modules ("
+                  << output.modulesReused << " reused), " << files.written << " files written, "
+                  << files.unchanged << " unchanged\n";
+        return 0;
+    }
+
+    std::cout << "// Generated Headers\n" << output.code.headers << "\n";
+    if (!output.code.definitions.empty()) {
+        std::cout << "// Generated Definitions\n" << output.code.definitions << "\n";
+    }
+    std::cout << "// Generated Init Code\n" << output.code.mainBody << "\n";
+    return 0;
+}
+
+int run_batch(const std::string& manifestPath, size_t jobs, const picoforge::GenerationOptions& options) {
+    auto entries = picoforge::BatchRunner::readManifest(manifestPath);
+    picoforge::ThreadPool pool(jobs);
+    auto results = picoforge::BatchRunner::run(entries, pool, options);
+    return picoforge::BatchRunner::report(results, std::cout) == 0 ? 0 : 1;
+}
+
+#ifdef PICOFORGE_HAS_DAEMON
+int run_serve(const std::string& socketPath, const picoforge::DaemonOptions& options) {
+    // A client hanging up mid-response must not take the daemon down.
+    std::signal(SIGPIPE, SIG_IGN);
+    picoforge::Daemon daemon(options);
+    if (socketPath.empty()) {
+        daemon.serveStream(0, 1);
+    } else {
+        daemon.serveSocket(socketPath);
+    }
+    return 0;
+}
+#endif
+}  // namespace
 
 int main(int argc, const char* argv[]) {
     if (argc < 2) {
-        std::cerr << "Usage: pico-forge <config.json>\n";
+        print_usage();
         return 1;
     }
 
     try {
-        auto modules = picoforge::ConfigParser::parseFile(argv[1]);
-        picoforge::MainGenerator gen;
-        auto code = gen.generate(modules);
+        std::string manifest;
+        bool serve = false;
+        std::string socketPath;
+        std::string serveRoot;
+        [[maybe_unused]] size_t maxClients = 0;
+        [[maybe_unused]] size_t maxQueue = 0;
+        size_t jobs = 0;
+        std::string config;
+        std::string outputDir;
+        bool incremental = false;
+        std::string cacheDir;
+        std::string profilePath;
+        uint64_t cacheMaxBytes = picoforge::GenerationCache::kDefaultMaxBytes;
+        picoforge::CMakeOptions cmakeOptions;
 
-        std::cout << "// Generated Headers\n" << code.headers << "\n";
-        std::cout << "// Generated Init Code\n" << code.mainBody << "\n";
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--batch" && i + 1 < argc) {
+                manifest = argv[++i];
+            } else if (arg == "--serve") {
+                serve = true;
+            } else if (arg == "--socket" && i + 1 < argc) {
+                socketPath = argv[++i];
+            } else if (arg == "--root" && i + 1 < argc) {
+                serveRoot = argv[++i];
+            } else if (arg == "--max-clients" && i + 1 < argc) {
+                maxClients = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "--max-queue" && i + 1 < argc) {
+                maxQueue = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg == "-j" && i + 1 < argc) {
+                jobs = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (arg.rfind("-j", 0) == 0 && arg.size() > 2) {
+                jobs = static_cast<size_t>(std::strtoul(arg.c_str() + 2, nullptr, 10));
+            } else if ((arg == "-o" || arg == "--out") && i + 1 < argc) {
+                outputDir = argv[++i];
+            } else if (arg == "--incremental") {
+                incremental = true;
+            } else if (arg == "--ninja") {
+                cmakeOptions.generator = "Ninja";
+            } else if (arg == "--ccache") {
+                cmakeOptions.compilerLauncher = "ccache";
+            } else if (arg == "--launcher" && i + 1 < argc) {
+                cmakeOptions.compilerLauncher = argv[++i];
+            } else if (arg == "--unity") {
+                cmakeOptions.unityBuild = true;
+            } else if (arg == "--pch") {
+                cmakeOptions.precompileHeaders = true;
+            } else if (arg == "--presets") {
+                cmakeOptions.presets = true;
+            } else if (arg == "--sdk-cache" && i + 1 < argc) {
+                cmakeOptions.sdkCacheDir = std::filesystem::absolute(argv[++i]).string();
+            } else if (arg == "--profile" && i + 1 < argc) {
+                profilePath = argv[++i];
+            } else if (arg == "--cache-dir" && i + 1 < argc) {
+                cacheDir = argv[++i];
+            } else if (arg == "--cache-max-mb" && i + 1 < argc) {
+                cacheMaxBytes = std::strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+            } else if (config.empty() && arg[0] != '-') {
+                config = arg;
+            } else {
+                print_usage();
+                return 1;
+            }
+        }
 
-        return 0;
+        if (!serve && manifest.empty() && config.empty()) {
+            print_usage();
+            return 1;
+        }
+
+        if (!profilePath.empty()) {
+            picoforge::Profiler::enable();
+        }
+        std::unique_ptr<picoforge::GenerationCache> cache;
+        if (!cacheDir.empty()) {
+            cache = std::make_unique<picoforge::GenerationCache>(cacheDir, cacheMaxBytes);
+        }
+
+        picoforge::GenerationOptions options;
+        options.cache = cache.get();
+        options.incremental = incremental;
+        options.cmake = cmakeOptions;
+
+        int rc = 0;
+        if (serve) {
+#ifdef PICOFORGE_HAS_DAEMON
+            picoforge::DaemonOptions daemonOptions;
+            daemonOptions.jobs = jobs;
+            daemonOptions.maxInFlight = maxQueue;
+            daemonOptions.cache = cache.get();
+            daemonOptions.cmake = cmakeOptions;
+            daemonOptions.maxConnections = maxClients;
+            daemonOptions.root = serveRoot;
+            rc = run_serve(socketPath, daemonOptions);
+#else
+            throw std::runtime_error("--serve is not available on this platform");
+#endif
+        } else {
+            rc = manifest.empty() ? run_single(config, outputDir, options)
+                                  : run_batch(manifest, jobs, options);
+        }
+        print_cache_stats(cache.get());
+        if (!profilePath.empty() && !picoforge::Profiler::writeChromeTrace(profilePath)) {
+            std::cerr << "Error: cannot write profile " << profilePath << "\n";
+            return 1;
+        }
+        return rc;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << "\n";
         return 1;
@@ -1,36 +1,262 @@
 #include "adc_module.h"
 
-#include <sstream>
+#include <algorithm>
+
+#include "../core/config_key.h"
 
 namespace picoforge {
 
 namespace {
 bool is_valid_adc_pin(int pin) { return pin >= 26 && pin <= 29; }
 bool is_valid_samples(int samples) { return samples > 0 && samples <= 1024; }
+
+constexpr int kAdcClockHz = 48000000;
+constexpr int kMaxConversionsPerSecond = 500000;  // one conversion takes 96 ADC clocks
+constexpr int kTemperatureInput = 4;
+
+// adc_set_clkdiv takes 16.8 fixed point; the period is (1 + div) ADC clocks.
+int clkdiv_fixed(int conversionsPerSecond) {
+    double div = static_cast<double>(kAdcClockHz) / conversionsPerSecond - 1.0;
+    return static_cast<int>(div * 256.0 + 0.5);
+}
+
+// Exact decimal text of a 16.8 fixed-point value ("2399.5f").
+std::string fixed_literal(int fixed) {
+    std::string text = std::to_string(fixed / 256) + ".";
+    std::string frac = std::to_string((fixed % 256) * 390625);  // 1e8 / 256
+    frac.insert(0, 8 - frac.size(), '0');
+    frac.erase(frac.find_last_not_of('0') + 1);
+    return text + (frac.empty() ? "0" : frac) + "f";
+}
+
+bool wants_filter(const AdcConfig& cfg) {
+    return cfg.capture.filter.enabled() || cfg.samples > 1;
+}
+}
+
+std::vector<int> AdcModule::captureInputs() const {
+    std::vector<int> inputs = cfg_.capture.inputs;
+    if (inputs.empty()) inputs.push_back(cfg_.temperature ? kTemperatureInput : cfg_.pin - 26);
+    std::sort(inputs.begin(), inputs.end());
+    return inputs;
+}
+
+DmaConfig AdcModule::captureStream() const {
+    DmaConfig dma;
+    dma.channel = cfg_.capture.dma_channel;
+    dma.data_size = 16;
+    dma.stream.src = "adc";
+    dma.stream.dst = "memory";
+    dma.stream.transfer_count = cfg_.capture.block_samples;
+    dma.stream.ping_pong = true;
+    dma.stream.chain_channel = cfg_.capture.chain_channel;
+    dma.stream.irq = true;
+    dma.stream.irq_line = cfg_.capture.irq_line;
+    return dma;
+}
+
+std::optional<FilterDesign> AdcModule::captureFilter() const {
+    if (!wants_filter(cfg_)) return std::nullopt;
+    FilterSpec spec = cfg_.capture.filter;
+    if (!spec.enabled()) spec.type = "average";
+    if (spec.type == "average" && cfg_.samples > 1) spec.length = cfg_.samples;
+    return FilterGenerator::design(spec, cfg_.capture.sample_rate_hz, static_cast<int>(captureInputs().size()));
 }
 
 bool AdcModule::validate() const {
+    if (cfg_.capture.enabled) {
+        const auto& c = cfg_.capture;
+        auto inputs = captureInputs();
+        int count = static_cast<int>(inputs.size());
+        if (inputs.front() < 0 || inputs.back() > kTemperatureInput ||
+            std::adjacent_find(inputs.begin(), inputs.end()) != inputs.end()) {
+            return false;
+        }
+        long long conversions = static_cast<long long>(c.sample_rate_hz) * count;
+        if (c.sample_rate_hz < 1 || conversions > kMaxConversionsPerSecond ||
+            clkdiv_fixed(static_cast<int>(conversions)) >= (1 << 24)) {
+            return false;
+        }
+        if (wants_filter(cfg_) && !captureFilter()) return false;
+        return c.block_samples >= count && c.block_samples % count == 0 && DmaModule::validStream(captureStream());
+    }
     if (cfg_.temperature) {
         return is_valid_samples(cfg_.samples);
     }
     return is_valid_adc_pin(cfg_.pin) && is_valid_samples(cfg_.samples);
 }
 
-std::string AdcModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "adc_init();\n";
-    if (cfg_.temperature) {
-        oss << "adc_set_temp_sensor_enabled(true);\n";
+void AdcModule::emit(CodeWriter& out) const {
+    out << "adc_init();\n";
+    if (!cfg_.capture.enabled) {
+        if (cfg_.temperature) {
+            out << "adc_set_temp_sensor_enabled(true);\n";
+        } else {
+            out << "adc_gpio_init(" << cfg_.pin << ");\n";
+            out << "adc_select_input(" << (cfg_.pin - 26) << ");\n";
+        }
+        return;
+    }
+
+    auto inputs = captureInputs();
+    uint32_t mask = 0;
+    for (int input : inputs) {
+        mask |= 1u << input;
+        if (input == kTemperatureInput) {
+            out << "adc_set_temp_sensor_enabled(true);\n";
+        } else {
+            out << "adc_gpio_init(" << 26 + input << ");\n";
+        }
+    }
+    int conversions = cfg_.capture.sample_rate_hz * static_cast<int>(inputs.size());
+    int div = clkdiv_fixed(conversions);
+    out << "adc_select_input(" << inputs.front() << ");\n";
+    if (inputs.size() > 1) out << "adc_set_round_robin(" << static_cast<unsigned>(mask) << ");\n";
+    out << "adc_fifo_setup(true, true, 1, false, false);\n";
+    out << "adc_set_clkdiv(" << fixed_literal(div) << ");  // "
+        << static_cast<long long>(kAdcClockHz * 256.0 / (256 + div) + 0.5) << " conversions/s\n";
+    std::string dma = id() + "_dma";
+    DmaModule::emitStreamInit(dma, captureStream(), out);
+    out << "adc_run(true);\n";
+}
+
+void AdcModule::emitDefinitions(CodeWriter& out) const {
+    if (!cfg_.capture.enabled) {
+        emitSampleHelper(out);
+        return;
+    }
+    const std::string p = id();
+    const std::string dma = p + "_dma";
+    auto inputs = captureInputs();
+
+    DmaModule::emitStreamDefinitions(dma, captureStream(), out);
+    out << "// " << p << " blocks interleave inputs";
+    for (int input : inputs) out << " " << input;
+    out << " (slot = position in that list), " << cfg_.capture.sample_rate_hz << " Hz each.\n";
+    out << "static const uint " << p << "_inputs = " << static_cast<int>(inputs.size()) << ";\n";
+    out << "static const uint " << p << "_block_samples = " << cfg_.capture.block_samples << ";\n";
+    out << "static uint32_t " << p << "_seen;\n\n";
+
+    out << "// Newest complete block, or nullptr before the first. Valid until two more\n";
+    out << "// blocks complete.\n";
+    out << "static inline const uint16_t* " << p << "_latest_block(void) {\n";
+    out.indent();
+    out << "return " << dma << "_blocks ? " << dma << "_dst[" << dma << "_ready] : nullptr;\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "// True once per completed block; never waits.\n";
+    out << "static inline bool " << p << "_poll_block(const uint16_t** block) {\n";
+    out.indent();
+    out << "uint32_t blocks = " << dma << "_blocks;\n";
+    out << "if (blocks == " << p << "_seen) return false;\n";
+    out << p << "_seen = blocks;\n";
+    out << "*block = " << dma << "_dst[" << dma << "_ready];\n";
+    out << "return true;\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "// Newest sample of one input slot (0 before the first block).\n";
+    out << "static inline uint16_t " << p << "_latest(uint slot) {\n";
+    out.indent();
+    out << "const uint16_t* block = " << p << "_latest_block();\n";
+    out << "return block ? block[" << p << "_block_samples - " << p << "_inputs + slot] : 0;\n";
+    out.dedent();
+    out << "}\n\n";
+
+    auto filter = captureFilter();
+    if (!filter) return;
+    FilterGenerator::emitKernel(p, *filter, out);
+    out << "static " << p << "_filter_t " << p << "_filter_state;\n";
+    out << "static const uint " << p << "_filtered_max = "
+        << FilterGenerator::maxOutput(*filter, cfg_.capture.block_samples) << ";\n\n";
+    out << "// Filters the next complete block into out (room for " << p << "_filtered_max\n";
+    out << "// samples, interleaved like the block). Shares blocks with " << p << "_poll_block;\n";
+    out << "// returns the samples written, 0 if no block is new.\n";
+    out << "static inline uint32_t " << p << "_poll_filtered(uint16_t* out) {\n";
+    out.indent();
+    out << "const uint16_t* block;\n";
+    out << "if (!" << p << "_poll_block(&block)) return 0;\n";
+    out << "return " << p << "_filter_block(&" << p << "_filter_state, block, " << p << "_block_samples, out);\n";
+    out.dedent();
+    out << "}\n\n";
+}
+
+// Blocking read of the configured input, averaged over `samples` conversions.
+void AdcModule::emitSampleHelper(CodeWriter& out) const {
+    const int input = cfg_.temperature ? kTemperatureInput : cfg_.pin - 26;
+    const int n = cfg_.samples;
+    out << "// " << (n > 1 ? "Mean of " + std::to_string(n) + " conversions" : std::string("One conversion"))
+        << " of ADC input " << input << ".\n";
+    out << "static inline uint16_t " << id() << "_sample(void) {\n";
+    out.indent();
+    out << "adc_select_input(" << input << ");\n";
+    if (n > 1) {
+        out << "uint32_t sum = 0;\n";
+        out << "for (int i = 0; i < " << n << "; ++i) sum += adc_read();\n";
+        out << "return " << FilterGenerator::scaled("sum", FilterGenerator::reciprocal(static_cast<uint32_t>(n)))
+            << ";\n";
+    } else {
+        out << "return adc_read();\n";
+    }
+    out.dedent();
+    out << "}\n\n";
+}
+
+void AdcModule::emitHeader(CodeWriter& out) const {
+    if (cfg_.capture.enabled) {
+        DmaModule::emitStreamHeaders(captureStream(), out);
     } else {
-        oss << "adc_gpio_init(" << cfg_.pin << ");\n";
-        oss << "adc_select_input(" << (cfg_.pin - 26) << ");\n";
+        out << "#include <hardware/adc.h>\n";
     }
-    oss << "// ADC sampling x" << cfg_.samples << " will be handled in read helper.\n";
-    return oss.str();
 }
 
-std::string AdcModule::generateHeaderCode() const {
-    return "#include <hardware/adc.h>\n";
+std::vector<Symbol> AdcModule::dependencies() const {
+    static const Symbol adc("hardware/adc");
+    std::vector<Symbol> deps{adc};
+    if (cfg_.capture.enabled) DmaModule::addStreamDependencies(captureStream(), deps);
+    return deps;
+}
+
+std::string AdcModule::configKey() const {
+    const auto& c = cfg_.capture;
+    std::string inputs;
+    for (int input : c.inputs) inputs += (inputs.empty() ? "" : ",") + std::to_string(input);
+    return ConfigKeyBuilder("adc")
+        .field("pin", cfg_.pin)
+        .field("samples", cfg_.samples)
+        .field("temperature", cfg_.temperature)
+        .field("capture", c.enabled)
+        .field("inputs", inputs)
+        .field("sample_rate_hz", c.sample_rate_hz)
+        .field("block_samples", c.block_samples)
+        .field("dma_channel", c.dma_channel)
+        .field("chain_channel", c.chain_channel)
+        .field("irq_line", c.irq_line)
+        .field("filter", c.filter.type)
+        .field("bandwidth_hz", c.filter.bandwidth_hz)
+        .field("decimation", c.filter.decimation)
+        .field("filter_order", c.filter.order)
+        .str();
+}
+
+void AdcModule::claimResources(ResourceClaims& claims) const {
+    if (!cfg_.capture.enabled) {
+        // Each read selects its own input, so polled modules can take turns.
+        claims.claimShared(ResourceKind::Adc, 0, "adc");
+        if (!cfg_.temperature) claims.claim(ResourceKind::Gpio, cfg_.pin, "adc");
+        return;
+    }
+    // Round-robin capture owns the converter for the whole run.
+    claims.claim(ResourceKind::Adc, 0, "adc capture");
+    for (int input : captureInputs()) {
+        if (input != kTemperatureInput) claims.claim(ResourceKind::Gpio, 26 + input, "adc");
+    }
+    const int channels = resourceCapacity(ResourceKind::DmaChannel);
+    for (int channel : {cfg_.capture.dma_channel, cfg_.capture.chain_channel}) {
+        if (channel >= 0) claims.claim(ResourceKind::DmaChannel, channel, "adc capture");
+        else claims.claimAny(ResourceKind::DmaChannel, 0, channels, "adc capture");
+    }
 }
 
 }  // namespace picoforge
@@ -1,37 +1,76 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "../core/module.h"
+#include "../generators/filter_generator.h"
+#include "dma_module.h"
 
 namespace picoforge {
 
+// Free-running capture: the ADC converts `inputs` round-robin into its FIFO,
+// a chained pair of DMA channels drains it into two blocks, and generated
+// accessors hand out the newest complete block without blocking.
+struct AdcCapture {
+    bool enabled = false;
+    std::vector<int> inputs;    // ADC inputs 0-4 (4 = temperature); empty = pin/temperature
+    int sample_rate_hz = 0;     // per input; all inputs together at most 500 ksps
+    int block_samples = 512;    // samples per DMA block, a multiple of inputs.size()
+    int dma_channel = -1;       // -1 for auto
+    int chain_channel = -1;     // -1 for auto
+    int irq_line = 0;           // DMA_IRQ_0 or DMA_IRQ_1
+    FilterSpec filter;          // per-input kernel run over each block by _poll_filtered
+};
+
 struct AdcConfig {
-    int pin;          // GPIO 26-29
-    int samples;      // averaging count
-    bool temperature; // true to read temp sensor (pin ignored)
+    int pin = 0;          // GPIO 26-29
+    int samples = 1;      // averaging count (polled reads; capture: moving average taps)
+    bool temperature = false; // true to read temp sensor (pin ignored)
+    AdcCapture capture;
 };
 
 class AdcModule : public IModule {
 public:
-    AdcModule() : cfg_{0, 1, false} {}
+    static constexpr std::string_view kTypeName = "adc";
+
+    AdcModule() = default;
     explicit AdcModule(AdcConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override {
+    std::string buildId() const override {
+        if (cfg_.capture.enabled) return "adc_capture";
         if (!cfg_.temperature && cfg_.pin == 0) return "adc"; // default
         return cfg_.temperature ? "adc_temp" : "adc_" + std::to_string(cfg_.pin);
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
 
-    std::string generateHeaderCode() const override;
+    void emitDefinitions(CodeWriter& out) const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/adc"}; }
+    std::vector<Symbol> dependencies() const override;
+
+    std::string configKey() const override;
+
+    void claimResources(ResourceClaims& claims) const override;
+
+    const AdcConfig& config() const { return cfg_; }
+    // Captured inputs in conversion (ascending) order.
+    std::vector<int> captureInputs() const;
+    // Round-robin capture's DMA stream (ADC FIFO to two chained blocks).
+    DmaConfig captureStream() const;
+    // Capture filter; `samples` > 1 without a filter type means a moving average.
+    // Nullopt when none is asked for or the request cannot be met.
+    std::optional<FilterDesign> captureFilter() const;
 
 private:
+    void emitSampleHelper(CodeWriter& out) const;
+
     AdcConfig cfg_;
 };
 
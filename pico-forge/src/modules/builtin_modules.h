@@ -0,0 +1,40 @@
+#pragma once
+
+#include "adc_module.h"
+#include "dma_module.h"
+#include "gpio_module.h"
+#include "i2c_module.h"
+#include "multicore_module.h"
+#include "pio_module.h"
+#include "pwm_module.h"
+#include "spi_module.h"
+#include "timer_module.h"
+#include "uart_module.h"
+
+namespace picoforge {
+
+template <typename... Modules>
+struct ModuleTypeList {
+    static constexpr size_t size = sizeof...(Modules);
+
+    // Instantiates T<Modules...>, e.g. std::variant or StaticModuleRegistry.
+    template <template <typename...> class T>
+    using apply = T<Modules...>;
+};
+
+// Every module type compiled into pico-forge. The type registry and
+// ModuleStore's variant are both generated from this one list; adding a
+// module means giving it a kTypeName and appending it here.
+using BuiltinModules = ModuleTypeList<
+    GpioModule,
+    PwmModule,
+    TimerModule,
+    AdcModule,
+    UartModule,
+    I2cModule,
+    SpiModule,
+    PioModule,
+    DmaModule,
+    MulticoreModule>;
+
+}  // namespace picoforge
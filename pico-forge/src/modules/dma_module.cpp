@@ -1,42 +1,373 @@
 #include "dma_module.h"
 
-#include <sstream>
+#include <cctype>
+
+#include "../core/config_key.h"
 
 namespace picoforge {
 
 namespace {
 bool is_valid_channel(int ch) { return ch >= -1 && ch <= 11; }
 bool is_valid_data_size(int sz) { return sz == 8 || sz == 16 || sz == 32; }
+
+constexpr int kMaxStreamBufferBytes = 128 * 1024;
+
+// Parses a trailing decimal index ("uart1" with prefix "uart" -> 1).
+bool parse_index(std::string_view text, std::string_view prefix, int max, int& index) {
+    if (text.substr(0, prefix.size()) != prefix || text.size() != prefix.size() + 1) return false;
+    char c = text.back();
+    index = c - '0';
+    return std::isdigit(static_cast<unsigned char>(c)) && index <= max;
+}
+
+struct Endpoint {
+    enum class Kind { Invalid, Memory, Adc, Uart, Spi, I2c, Pio, Pwm };
+    Kind kind = Kind::Invalid;
+    int index = 0;  // instance, PIO block or PWM slice
+    int sm = 0;     // PIO state machine
+};
+
+Endpoint parse_endpoint(std::string_view text) {
+    Endpoint e;
+    if (text == "memory") e.kind = Endpoint::Kind::Memory;
+    else if (text == "adc") e.kind = Endpoint::Kind::Adc;
+    else if (parse_index(text, "uart", 1, e.index)) e.kind = Endpoint::Kind::Uart;
+    else if (parse_index(text, "spi", 1, e.index)) e.kind = Endpoint::Kind::Spi;
+    else if (parse_index(text, "i2c", 1, e.index)) e.kind = Endpoint::Kind::I2c;
+    else if (parse_index(text, "pwm", 7, e.index)) e.kind = Endpoint::Kind::Pwm;
+    else if (text.size() == 8 && parse_index(text.substr(0, 4), "pio", 1, e.index) &&
+             parse_index(text.substr(4), "_sm", 3, e.sm)) {
+        e.kind = Endpoint::Kind::Pio;
+    }
+    return e;
+}
+
+bool is_memory(const Endpoint& e) { return e.kind == Endpoint::Kind::Memory; }
+
+// Register the channel reads (source) or writes (destination).
+std::string endpoint_address(const Endpoint& e, bool source) {
+    std::string i = std::to_string(e.index);
+    switch (e.kind) {
+        case Endpoint::Kind::Adc:  return "&adc_hw->fifo";
+        case Endpoint::Kind::Uart: return "&uart_get_hw(uart" + i + ")->dr";
+        case Endpoint::Kind::Spi:  return "&spi_get_hw(spi" + i + ")->dr";
+        case Endpoint::Kind::I2c:  return "&i2c_get_hw(i2c" + i + ")->data_cmd";
+        case Endpoint::Kind::Pio:  return "&pio" + i + (source ? "->rxf[" : "->txf[") + std::to_string(e.sm) + "]";
+        case Endpoint::Kind::Pwm:  return "&pwm_hw->slice[" + i + "].cc";
+        default:                   return {};
+    }
+}
+
+// DREQ a peripheral raises when it has data (source) or room (destination).
+std::string endpoint_dreq(const Endpoint& e, bool source) {
+    std::string i = std::to_string(e.index);
+    const char* dir = source ? "_RX" : "_TX";
+    switch (e.kind) {
+        case Endpoint::Kind::Adc:  return "DREQ_ADC";
+        case Endpoint::Kind::Uart: return "DREQ_UART" + i + dir;
+        case Endpoint::Kind::Spi:  return "DREQ_SPI" + i + dir;
+        case Endpoint::Kind::I2c:  return "DREQ_I2C" + i + dir;
+        case Endpoint::Kind::Pio:  return "DREQ_PIO" + i + dir + std::to_string(e.sm);
+        case Endpoint::Kind::Pwm:  return "DREQ_PWM_WRAP" + i;
+        default:                   return {};
+    }
+}
+
+// Config name -> SDK constant ("uart1_rx" -> "DREQ_UART1_RX"). "none" maps to
+// an empty constant (unpaced); false for names the SDK does not define.
+bool dreq_constant(std::string_view name, std::string& out) {
+    out.clear();
+    int i = 0;
+    if (name == "none") return true;
+    if (name == "force") out = "DREQ_FORCE";
+    else if (name == "adc") out = "DREQ_ADC";
+    else if (parse_index(name, "timer", 3, i)) out = "DREQ_DMA_TIMER" + std::to_string(i);
+    else if (parse_index(name, "pwm_wrap", 7, i)) out = "DREQ_PWM_WRAP" + std::to_string(i);
+    if (!out.empty()) return true;
+
+    // "<peripheral>_tx" / "_rx"; PIO puts the state machine last ("pio0_tx1").
+    Endpoint e;
+    std::string_view dir;
+    if (name.size() == 8 && name.substr(0, 3) == "pio" && name[4] == '_') {
+        dir = name.substr(5, 2);
+        if (!parse_index(name.substr(0, 4), "pio", 1, e.index) || !parse_index(name.substr(5), dir, 3, e.sm)) {
+            return false;
+        }
+        e.kind = Endpoint::Kind::Pio;
+    } else {
+        size_t underscore = name.rfind('_');
+        if (underscore == std::string_view::npos) return false;
+        dir = name.substr(underscore + 1);
+        e = parse_endpoint(name.substr(0, underscore));
+        if (e.kind != Endpoint::Kind::Uart && e.kind != Endpoint::Kind::Spi && e.kind != Endpoint::Kind::I2c) {
+            return false;
+        }
+    }
+    if (dir != "tx" && dir != "rx") return false;
+    out = endpoint_dreq(e, dir == "rx");
+    return true;
+}
+
+int element_bytes(const DmaConfig& cfg) { return cfg.data_size / 8; }
+
+const char* element_type(const DmaConfig& cfg) {
+    return cfg.data_size == 8 ? "uint8_t" : cfg.data_size == 16 ? "uint16_t" : "uint32_t";
+}
+
+// The ring wraps the memory end; the source when both ends are memory.
+bool ring_on_source(const DmaConfig& cfg) { return parse_endpoint(cfg.stream.src).kind == Endpoint::Kind::Memory; }
+
+// Elements per memory buffer: the ring if it wraps this end, else one trigger's worth.
+long long buffer_elements(const DmaConfig& cfg, bool source) {
+    const auto& s = cfg.stream;
+    bool ringed = s.ring_bits > 0 && ring_on_source(cfg) == source;
+    return ringed ? (1 << s.ring_bits) / element_bytes(cfg) : s.transfer_count;
+}
+
+int buffer_count(const DmaConfig& cfg) { return cfg.stream.ping_pong ? 2 : 1; }
+
+// Pacing: explicit dreq, else the peripheral end (the source if both are).
+std::string stream_dreq(const DmaConfig& cfg) {
+    std::string explicit_dreq;
+    if (dreq_constant(cfg.dreq, explicit_dreq) && !explicit_dreq.empty()) return explicit_dreq;
+    Endpoint src = parse_endpoint(cfg.stream.src);
+    if (!is_memory(src)) return endpoint_dreq(src, true);
+    Endpoint dst = parse_endpoint(cfg.stream.dst);
+    return is_memory(dst) ? std::string() : endpoint_dreq(dst, false);
+}
+
+// A fixed channel was checked for conflicts at generation time; only an
+// unplaced one is claimed at boot.
+void emit_channel_claim(std::string_view prefix, int slot, int channel, CodeWriter& out) {
+    out << prefix << "_chan[" << slot << "] = ";
+    if (channel >= 0) {
+        out << channel << ";\n";
+    } else {
+        out << "dma_claim_unused_channel(true);\n";
+    }
+}
+}  // namespace
+
+bool DmaModule::validStream(const DmaConfig& cfg) {
+    const auto& s = cfg.stream;
+    Endpoint src = parse_endpoint(s.src);
+    Endpoint dst = parse_endpoint(s.dst);
+    std::string dreq;
+    if (!is_valid_data_size(cfg.data_size) || src.kind == Endpoint::Kind::Invalid || dst.kind == Endpoint::Kind::Invalid ||
+        src.kind == Endpoint::Kind::Pwm || dst.kind == Endpoint::Kind::Adc ||
+        !dreq_constant(cfg.dreq, dreq) || s.transfer_count < 1 || (s.irq_line != 0 && s.irq_line != 1)) {
+        return false;
+    }
+    if (s.ring_bits != 0) {
+        bool memoryEnd = is_memory(src) || is_memory(dst);
+        if (!memoryEnd || s.ring_bits < 1 || s.ring_bits > 15 || (1 << s.ring_bits) < element_bytes(cfg)) return false;
+    }
+    // Without a ring wrapping the buffers, only the IRQ can rewind a ping-pong channel.
+    if (s.ping_pong && s.ring_bits == 0 && !s.irq) return false;
+    if (s.ping_pong && (!is_valid_channel(s.chain_channel) || (s.chain_channel >= 0 && s.chain_channel == cfg.channel))) {
+        return false;
+    }
+    long long elements = (is_memory(src) ? buffer_elements(cfg, true) : 0) + (is_memory(dst) ? buffer_elements(cfg, false) : 0);
+    return elements * element_bytes(cfg) * buffer_count(cfg) <= kMaxStreamBufferBytes;
 }
 
 bool DmaModule::validate() const {
-    return is_valid_channel(cfg_.channel) && is_valid_data_size(cfg_.data_size);
+    if (!is_valid_channel(cfg_.channel) || !is_valid_data_size(cfg_.data_size)) return false;
+    return !cfg_.stream.enabled() || validStream(cfg_);
 }
 
-std::string DmaModule::generateInitCode() const {
-    std::ostringstream oss;
-    
+void DmaModule::emitStreamDefinitions(std::string_view prefix, const DmaConfig& cfg, CodeWriter& out) {
+    const auto& s = cfg.stream;
+    Endpoint src = parse_endpoint(s.src);
+    Endpoint dst = parse_endpoint(s.dst);
+    int buffers = buffer_count(cfg);
+
+    out << "// " << prefix << ": " << s.src << " -> " << s.dst << ", " << s.transfer_count << " x "
+        << cfg.data_size << "-bit transfers" << (s.ping_pong ? " per buffer, ping-pong" : "") << "\n";
+    auto buffer = [&](bool source) {
+        out << "static " << element_type(cfg) << " " << prefix << (source ? "_src[" : "_dst[") << buffers << "]["
+            << buffer_elements(cfg, source) << "]";
+        if (s.ring_bits > 0 && ring_on_source(cfg) == source) out << " __attribute__((aligned(" << (1 << s.ring_bits) << ")))";
+        out << ";\n";
+    };
+    if (is_memory(src)) buffer(true);
+    if (is_memory(dst)) buffer(false);
+    out << "static uint " << prefix << "_chan[" << buffers << "];\n";
+    if (!s.irq) {
+        out << "\n";
+        return;
+    }
+
+    const std::string irq = std::to_string(s.irq_line);
+    out << "static volatile uint32_t " << prefix << "_blocks;  // buffers completed\n";
+    out << "static volatile uint8_t " << prefix << "_ready;    // newest completed buffer\n\n";
+    out << "static void " << prefix << "_irq(void) {\n";
+    out.indent();
+    out << "for (uint i = 0; i < " << buffers << "; ++i) {\n";
+    out.indent();
+    out << "if (!dma_channel_get_irq" << irq << "_status(" << prefix << "_chan[i])) continue;\n";
+    out << "dma_channel_acknowledge_irq" << irq << "(" << prefix << "_chan[i]);\n";
+    if (s.ping_pong && s.ring_bits == 0) {
+        // The chained partner is already running; rewind this one for its next turn.
+        if (is_memory(src)) out << "dma_channel_set_read_addr(" << prefix << "_chan[i], " << prefix << "_src[i], false);\n";
+        if (is_memory(dst)) out << "dma_channel_set_write_addr(" << prefix << "_chan[i], " << prefix << "_dst[i], false);\n";
+    }
+    out << prefix << "_ready = (uint8_t)i;\n";
+    out << "++" << prefix << "_blocks;\n";
+    out.dedent();
+    out << "}\n";
+    out.dedent();
+    out << "}\n\n";
+}
+
+void DmaModule::emitStreamInit(std::string_view prefix, const DmaConfig& cfg, CodeWriter& out) {
+    const auto& s = cfg.stream;
+    Endpoint src = parse_endpoint(s.src);
+    Endpoint dst = parse_endpoint(s.dst);
+    const std::string p(prefix);
+    const char* i = s.ping_pong ? "i" : "0";
+    const std::string irq = std::to_string(s.irq_line);
+
+    out << "// " << prefix << ": " << s.src << " -> " << s.dst << "\n";
+    emit_channel_claim(prefix, 0, cfg.channel, out);
+    if (s.ping_pong) emit_channel_claim(prefix, 1, s.chain_channel, out);
+    if (s.ping_pong) {
+        out << "for (uint i = 0; i < 2; ++i) {\n";
+    } else {
+        out << "{\n";
+    }
+    out.indent();
+    out << "dma_channel_config c = dma_channel_get_default_config(" << p << "_chan[" << i << "]);\n";
+    out << "channel_config_set_transfer_data_size(&c, DMA_SIZE_" << cfg.data_size << ");\n";
+    out << "channel_config_set_read_increment(&c, " << (is_memory(src) ? "true" : "false") << ");\n";
+    out << "channel_config_set_write_increment(&c, " << (is_memory(dst) ? "true" : "false") << ");\n";
+    std::string dreq = stream_dreq(cfg);
+    if (!dreq.empty()) out << "channel_config_set_dreq(&c, " << dreq << ");\n";
+    if (s.ring_bits > 0) {
+        out << "channel_config_set_ring(&c, " << (ring_on_source(cfg) ? "false" : "true") << ", " << s.ring_bits << ");\n";
+    }
+    if (s.ping_pong) out << "channel_config_set_chain_to(&c, " << p << "_chan[1 - i]);\n";
+
+    std::string write = is_memory(dst) ? p + "_dst[" + i + "]" : endpoint_address(dst, false);
+    std::string read = is_memory(src) ? p + "_src[" + i + "]" : endpoint_address(src, true);
+    out << "dma_channel_configure(" << p << "_chan[" << i << "], &c, " << write << ", " << read << ", "
+        << s.transfer_count << ", false);\n";
+    if (s.irq) out << "dma_channel_set_irq" << irq << "_enabled(" << p << "_chan[" << i << "], true);\n";
+    out.dedent();
+    out << "}\n";
+
+    if (s.irq) {
+        out << "irq_add_shared_handler(DMA_IRQ_" << irq << ", " << p
+            << "_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);\n";
+        out << "irq_set_enabled(DMA_IRQ_" << irq << ", true);\n";
+    }
+    if (s.ping_pong || !is_memory(src)) {
+        out << "dma_channel_start(" << p << "_chan[0]);\n";
+    } else {
+        // A one-shot send would only push out the zeroed buffer; the caller starts it.
+        out << "// send: dma_channel_set_read_addr(" << p << "_chan[0], " << p << "_src[0], true);\n";
+    }
+}
+
+void DmaModule::emit(CodeWriter& out) const {
+    if (cfg_.stream.enabled()) {
+        emitStreamInit(id(), cfg_, out);
+        return;
+    }
     if (cfg_.channel < 0) {
-        oss << "int dma_chan = dma_claim_unused_channel(true);\n";
+        out << "int dma_chan = dma_claim_unused_channel(true);\n";
     } else {
-        oss << "int dma_chan = " << cfg_.channel << ";\n";
-        oss << "dma_channel_claim(dma_chan);\n";
+        out << "int dma_chan = " << cfg_.channel << ";\n";
     }
-    
-    oss << "dma_channel_config c = dma_channel_get_default_config(dma_chan);\n";
-    oss << "channel_config_set_transfer_data_size(&c, DMA_SIZE_" << cfg_.data_size << ");\n";
-    oss << "channel_config_set_read_increment(&c, " << (cfg_.src_inc ? "true" : "false") << ");\n";
-    oss << "channel_config_set_write_increment(&c, " << (cfg_.dst_inc ? "true" : "false") << ");\n";
-    
-    if (!cfg_.dreq.empty() && cfg_.dreq != "none") {
-        oss << "// DREQ: " << cfg_.dreq << " (configure manually)\n";
+
+    out << "dma_channel_config c = dma_channel_get_default_config(dma_chan);\n";
+    out << "channel_config_set_transfer_data_size(&c, DMA_SIZE_" << cfg_.data_size << ");\n";
+    out << "channel_config_set_read_increment(&c, " << (cfg_.src_inc ? "true" : "false") << ");\n";
+    out << "channel_config_set_write_increment(&c, " << (cfg_.dst_inc ? "true" : "false") << ");\n";
+
+    std::string dreq;
+    if (!dreq_constant(cfg_.dreq, dreq)) {
+        out << "// DREQ: " << cfg_.dreq << " (configure manually)\n";
+    } else if (!dreq.empty()) {
+        out << "channel_config_set_dreq(&c, " << dreq << ");\n";
     }
-    
-    return oss.str();
 }
 
-std::string DmaModule::generateHeaderCode() const {
-    return "#include <hardware/dma.h>\n";
+void DmaModule::emitDefinitions(CodeWriter& out) const {
+    if (cfg_.stream.enabled()) emitStreamDefinitions(id(), cfg_, out);
+}
+
+void DmaModule::emitStreamHeaders(const DmaConfig& cfg, CodeWriter& out) {
+    std::vector<Symbol> deps;
+    addStreamDependencies(cfg, deps);
+    for (Symbol dep : deps) out << "#include <" << dep.str() << ".h>\n";
+}
+
+void DmaModule::addStreamDependencies(const DmaConfig& cfg, std::vector<Symbol>& deps) {
+    static const Symbol dma("hardware/dma"), irq("hardware/irq"), adc("hardware/adc"), uart("hardware/uart"),
+        spi("hardware/spi"), i2c("hardware/i2c"), pio("hardware/pio"), pwm("hardware/pwm");
+    auto add = [&deps](Symbol dep) {
+        for (Symbol d : deps) {
+            if (d == dep) return;
+        }
+        deps.push_back(dep);
+    };
+    add(dma);
+    if (!cfg.stream.enabled()) return;
+    if (cfg.stream.irq) add(irq);
+    for (const std::string* end : {&cfg.stream.src, &cfg.stream.dst}) {
+        switch (parse_endpoint(*end).kind) {
+            case Endpoint::Kind::Adc:  add(adc); break;
+            case Endpoint::Kind::Uart: add(uart); break;
+            case Endpoint::Kind::Spi:  add(spi); break;
+            case Endpoint::Kind::I2c:  add(i2c); break;
+            case Endpoint::Kind::Pio:  add(pio); break;
+            case Endpoint::Kind::Pwm:  add(pwm); break;
+            default: break;
+        }
+    }
+}
+
+void DmaModule::emitHeader(CodeWriter& out) const {
+    emitStreamHeaders(cfg_, out);
+}
+
+std::vector<Symbol> DmaModule::dependencies() const {
+    std::vector<Symbol> deps;
+    addStreamDependencies(cfg_, deps);
+    return deps;
+}
+
+std::string DmaModule::configKey() const {
+    const auto& s = cfg_.stream;
+    return ConfigKeyBuilder("dma")
+        .field("channel", cfg_.channel)
+        .field("data_size", cfg_.data_size)
+        .field("src_inc", cfg_.src_inc)
+        .field("dst_inc", cfg_.dst_inc)
+        .field("dreq", cfg_.dreq)
+        .field("src", s.src)
+        .field("dst", s.dst)
+        .field("transfer_count", s.transfer_count)
+        .field("ring_bits", s.ring_bits)
+        .field("ping_pong", s.ping_pong)
+        .field("chain_channel", s.chain_channel)
+        .field("irq", s.irq)
+        .field("irq_line", s.irq_line)
+        .str();
+}
+
+void DmaModule::claimResources(ResourceClaims& claims) const {
+    const int channels = resourceCapacity(ResourceKind::DmaChannel);
+    auto claim = [&](int channel, const char* role) {
+        if (channel >= 0) {
+            claims.claim(ResourceKind::DmaChannel, channel, role);
+        } else {
+            claims.claimAny(ResourceKind::DmaChannel, 0, channels, role);
+        }
+    };
+    claim(cfg_.channel, "dma");
+    if (cfg_.stream.enabled() && cfg_.stream.ping_pong) claim(cfg_.stream.chain_channel, "dma chain");
 }
 
 }  // namespace picoforge
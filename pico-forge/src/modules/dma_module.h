@@ -1,37 +1,75 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "../core/module.h"
 
 namespace picoforge {
 
+// A complete transfer pipeline. Endpoints are "memory" or a peripheral:
+// "adc" (source only), "uart0", "spi1", "i2c0", "pio0_sm2" (RX FIFO as source,
+// TX FIFO as destination) or "pwm3" (slice compare, destination only).
+struct DmaStream {
+    std::string src;
+    std::string dst;
+    int transfer_count = 0;   // transfers per trigger
+    int ring_bits = 0;        // memory end wraps on a 2^ring_bits byte buffer (1-15); 0 = off
+    bool ping_pong = false;   // two channels chained to each other, one buffer each
+    int chain_channel = -1;   // second channel for ping_pong (-1 for auto)
+    bool irq = false;         // completion IRQ: counts buffers, re-arms ping-pong addresses
+    int irq_line = 0;         // DMA_IRQ_0 or DMA_IRQ_1
+
+    bool enabled() const { return !src.empty() || !dst.empty(); }
+};
+
 struct DmaConfig {
-    int channel;      // -1 for auto-claim
-    int data_size;    // 8, 16, 32
-    bool src_inc;
-    bool dst_inc;
-    std::string dreq; // e.g., "pio0_tx0", "none"
+    int channel = 0;      // -1 for auto-claim
+    int data_size = 32;   // 8, 16, 32
+    bool src_inc = false;
+    bool dst_inc = false;
+    std::string dreq = "none"; // e.g., "pio0_tx0", "adc", "timer0", "force", "none"
+    DmaStream stream;     // when enabled, replaces the bare channel setup above
 };
 
 class DmaModule : public IModule {
 public:
-    DmaModule() : cfg_{0, 32, false, false, "none"} {}
+    static constexpr std::string_view kTypeName = "dma";
+
+    DmaModule() = default;
     explicit DmaModule(DmaConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override {
-        if (cfg_.channel == 0 && cfg_.dreq == "none") return "dma"; // default
+    std::string buildId() const override {
+        if (cfg_.channel == 0 && cfg_.dreq == "none" && !cfg_.stream.enabled()) return "dma"; // default
         return cfg_.channel >= 0 ? "dma_" + std::to_string(cfg_.channel) : "dma_auto";
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    void emitDefinitions(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override;
+
+    std::string configKey() const override;
+
+    void claimResources(ResourceClaims& claims) const override;
 
-    std::string generateHeaderCode() const override;
+    const DmaConfig& config() const { return cfg_; }
 
-    std::vector<std::string> dependencies() const override { return {"hardware/dma"}; }
+    // Stream code for `cfg` under the name prefix `prefix` (buffers are
+    // prefix_src / prefix_dst, channels prefix_chan). Also used by modules that
+    // run their own DMA stream.
+    static bool validStream(const DmaConfig& cfg);
+    static void emitStreamDefinitions(std::string_view prefix, const DmaConfig& cfg, CodeWriter& out);
+    static void emitStreamInit(std::string_view prefix, const DmaConfig& cfg, CodeWriter& out);
+    // #include lines / dependencies the stream's endpoints need.
+    static void emitStreamHeaders(const DmaConfig& cfg, CodeWriter& out);
+    static void addStreamDependencies(const DmaConfig& cfg, std::vector<Symbol>& deps);
 
 private:
     DmaConfig cfg_;
@@ -1,6 +1,6 @@
 #include "gpio_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -18,20 +18,30 @@ bool GpioModule::validate() const {
     return is_valid_pin(cfg_.pin) && is_valid_direction(cfg_.direction) && is_valid_pull(cfg_.pull);
 }
 
-std::string GpioModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "gpio_init(" << cfg_.pin << ");\n";
-    oss << "gpio_set_dir(" << cfg_.pin << ", " << (cfg_.direction == "output" ? "true" : "false") << ");\n";
+void GpioModule::emit(CodeWriter& out) const {
+    out << "gpio_init(" << cfg_.pin << ");\n";
+    out << "gpio_set_dir(" << cfg_.pin << ", " << (cfg_.direction == "output" ? "true" : "false") << ");\n";
     if (cfg_.pull == "up") {
-        oss << "gpio_pull_up(" << cfg_.pin << ");\n";
+        out << "gpio_pull_up(" << cfg_.pin << ");\n";
     } else if (cfg_.pull == "down") {
-        oss << "gpio_pull_down(" << cfg_.pin << ");\n";
+        out << "gpio_pull_down(" << cfg_.pin << ");\n";
     }
-    return oss.str();
 }
 
-std::string GpioModule::generateHeaderCode() const {
-    return "#include <hardware/gpio.h>\n";
+void GpioModule::emitHeader(CodeWriter& out) const {
+    out << "#include <hardware/gpio.h>\n";
+}
+
+std::string GpioModule::configKey() const {
+    return ConfigKeyBuilder("gpio")
+        .field("pin", cfg_.pin)
+        .field("direction", cfg_.direction)
+        .field("pull", cfg_.pull)
+        .str();
+}
+
+void GpioModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::Gpio, cfg_.pin, "pin");
 }
 
 }  // namespace picoforge
@@ -8,28 +8,37 @@
 namespace picoforge {
 
 struct GpioConfig {
-    int pin;
-    std::string direction;  // "input" or "output"
-    std::string pull;       // "up", "down", "none"
+    int pin = 0;
+    std::string direction = "output";  // "input" or "output"
+    std::string pull = "none";         // "up", "down", "none"
 };
 
 class GpioModule : public IModule {
 public:
-    GpioModule() : cfg_{0, "output", "none"} {}
+    static constexpr std::string_view kTypeName = "gpio";
+
+    GpioModule() = default;
     explicit GpioModule(GpioConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.pin == 0 && cfg_.direction == "output") return "gpio"; // default
         return "gpio_" + std::to_string(cfg_.pin); 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("hardware/gpio");
+        return {dep};
+    }
 
-    std::string generateHeaderCode() const override;
+    std::string configKey() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/gpio"}; }
+    void claimResources(ResourceClaims& claims) const override;
 
 private:
     GpioConfig cfg_;
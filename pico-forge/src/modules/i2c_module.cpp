@@ -1,6 +1,6 @@
 #include "i2c_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -15,20 +15,34 @@ bool I2cModule::validate() const {
            is_valid_pin(cfg_.scl) && is_valid_speed(cfg_.speed_hz);
 }
 
-std::string I2cModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "i2c_init(i2c" << cfg_.id << ", " << cfg_.speed_hz << ");\n";
-    oss << "gpio_set_function(" << cfg_.sda << ", GPIO_FUNC_I2C);\n";
-    oss << "gpio_set_function(" << cfg_.scl << ", GPIO_FUNC_I2C);\n";
+void I2cModule::emit(CodeWriter& out) const {
+    out << "i2c_init(i2c" << cfg_.id << ", " << cfg_.speed_hz << ");\n";
+    out << "gpio_set_function(" << cfg_.sda << ", GPIO_FUNC_I2C);\n";
+    out << "gpio_set_function(" << cfg_.scl << ", GPIO_FUNC_I2C);\n";
     if (cfg_.pullups) {
-        oss << "gpio_pull_up(" << cfg_.sda << ");\n";
-        oss << "gpio_pull_up(" << cfg_.scl << ");\n";
+        out << "gpio_pull_up(" << cfg_.sda << ");\n";
+        out << "gpio_pull_up(" << cfg_.scl << ");\n";
     }
-    return oss.str();
 }
 
-std::string I2cModule::generateHeaderCode() const {
-    return "#include <hardware/i2c.h>\n";
+void I2cModule::emitHeader(CodeWriter& out) const {
+    out << "#include <hardware/i2c.h>\n";
+}
+
+std::string I2cModule::configKey() const {
+    return ConfigKeyBuilder("i2c")
+        .field("id", cfg_.id)
+        .field("sda", cfg_.sda)
+        .field("scl", cfg_.scl)
+        .field("speed_hz", cfg_.speed_hz)
+        .field("pullups", cfg_.pullups)
+        .str();
+}
+
+void I2cModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::I2c, cfg_.id, "i2c");
+    claims.claim(ResourceKind::Gpio, cfg_.sda, "sda");
+    claims.claim(ResourceKind::Gpio, cfg_.scl, "scl");
 }
 
 }  // namespace picoforge
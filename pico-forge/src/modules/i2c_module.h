@@ -8,30 +8,39 @@
 namespace picoforge {
 
 struct I2cConfig {
-    int id;        // 0 or 1
-    int sda;
-    int scl;
-    int speed_hz;
-    bool pullups;
+    int id = 0;        // 0 or 1
+    int sda = 0;
+    int scl = 1;
+    int speed_hz = 100000;
+    bool pullups = false;
 };
 
 class I2cModule : public IModule {
 public:
-    I2cModule() : cfg_{0, 0, 1, 100000, false} {}
+    static constexpr std::string_view kTypeName = "i2c";
+
+    I2cModule() = default;
     explicit I2cModule(I2cConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.id == 0 && cfg_.speed_hz == 100000) return "i2c"; // default
         return "i2c_" + std::to_string(cfg_.id); 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("hardware/i2c");
+        return {dep};
+    }
 
-    std::string generateHeaderCode() const override;
+    std::string configKey() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/i2c"}; }
+    void claimResources(ResourceClaims& claims) const override;
 
 private:
     I2cConfig cfg_;
@@ -1,6 +1,6 @@
 #include "multicore_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -8,14 +8,19 @@ bool MulticoreModule::validate() const {
     return cfg_.enable && !cfg_.core1_entry.empty();
 }
 
-std::string MulticoreModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "multicore_launch_core1(" << cfg_.core1_entry << ");\n";
-    return oss.str();
+void MulticoreModule::emit(CodeWriter& out) const {
+    out << "multicore_launch_core1(" << cfg_.core1_entry << ");\n";
 }
 
-std::string MulticoreModule::generateHeaderCode() const {
-    return "#include <pico/multicore.h>\n";
+void MulticoreModule::emitHeader(CodeWriter& out) const {
+    out << "#include <pico/multicore.h>\n";
+}
+
+std::string MulticoreModule::configKey() const {
+    return ConfigKeyBuilder("multicore")
+        .field("enable", cfg_.enable)
+        .field("core1_entry", cfg_.core1_entry)
+        .str();
 }
 
 }  // namespace picoforge
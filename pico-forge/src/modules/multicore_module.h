@@ -8,24 +8,31 @@
 namespace picoforge {
 
 struct MulticoreConfig {
-    bool enable;
-    std::string core1_entry; // function name for core1 main
+    bool enable = true;
+    std::string core1_entry = "core1_entry"; // function name for core1 main
 };
 
 class MulticoreModule : public IModule {
 public:
-    MulticoreModule() : cfg_{true, "core1_entry"} {}
+    static constexpr std::string_view kTypeName = "multicore";
+
+    MulticoreModule() = default;
     explicit MulticoreModule(MulticoreConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { return "multicore"; }
+    std::string buildId() const override { return "multicore"; }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
 
-    std::string generateHeaderCode() const override;
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("pico/multicore");
+        return {dep};
+    }
 
-    std::vector<std::string> dependencies() const override { return {"pico/multicore"}; }
+    std::string configKey() const override;
 
 private:
     MulticoreConfig cfg_;
@@ -1,43 +1,345 @@
 #include "pio_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
 namespace {
+constexpr int kInstructionWords = 32;
+
 bool is_valid_pin(int pin) { return pin >= 0 && pin <= 29; }
 bool is_valid_sm_count(int count) { return count > 0 && count <= 4; }
 bool is_valid_preset(const std::string& preset) {
     return preset.empty() || preset == "ws2812" || preset == "uart" || 
            preset == "spi" || preset == "i2c";
 }
+
+// Sizes of the matching pico-examples programs (uart is tx + rx, i2c includes set_scl_sda).
+int preset_length(const std::string& preset) {
+    if (preset == "ws2812") return 4;
+    if (preset == "uart") return 8;
+    if (preset == "spi") return 2;
+    if (preset == "i2c") return 22;
+    return 0;
+}
+
+// Whether the program writes its pins (so they start as outputs) or only reads them.
+bool drives_pins(const PioProgram& program) {
+    if (program.sideset_bits > 0) return true;
+    for (uint16_t word : program.instructions) {
+        int op = word >> 13;
+        int dst = (word >> 5) & 7;
+        if ((op == 3 || op == 7) && (dst == 0 || dst == 4)) return true;  // out/set pins, pindirs
+        if (op == 5 && dst == 0) return true;                              // mov pins
+    }
+    return false;
+}
+
+// pico-examples ws2812.pio: T1 + T2 + T3 cycles per bit, side-set drives the line.
+constexpr const char* kWs2812Source = R"(
+.program ws2812
+.side_set 1
+.define public T1 3
+.define public T2 3
+.define public T3 4
+.wrap_target
+bitloop:
+    out x, 1       side 0 [T3 - 1]
+    jmp !x do_zero side 1 [T1 - 1]
+do_one:
+    jmp  bitloop   side 1 [T2 - 1]
+do_zero:
+    nop            side 0 [T2 - 1]
+.wrap
+)";
+
+const PioProgram& ws2812_program() {
+    static const PioAssembly assembly = PioAssembler::assemble(kWs2812Source);
+    return assembly.programs.front();
+}
+
+constexpr int kWs2812ResetUs = 280;    // WS2812B low time that latches a frame
+constexpr int kJoinedTxFifoWords = 8;
+
+// DMA completes with the FIFO and shift register still full; the latch starts
+// once they drain.
+int ws2812_latch_us(const PioConfig& c) {
+    long long bits = static_cast<long long>(kJoinedTxFifoWords + 1) * (c.rgbw ? 32 : 24);
+    return static_cast<int>((bits * 1000000 + c.freq_hz - 1) / c.freq_hz) + kWs2812ResetUs;
+}
+
+bool is_valid_ws2812(const PioConfig& c) {
+    if (c.led_count == 0) return true;
+    return c.preset == "ws2812" && c.sm_count == 1 && c.led_count > 0 && c.led_count <= 4096 && c.freq_hz > 0 &&
+           c.freq_hz <= 1000000 && c.dma_channel >= -1 && c.dma_channel < 12 && (c.irq_line == 0 || c.irq_line == 1);
+}
+
+bool is_valid_placement(const PioConfig& c, int length) {
+    if (c.block < -1 || c.block > 1) return false;
+    if (c.sm < -1 || (c.sm >= 0 && c.sm + c.sm_count > 4)) return false;
+    if (c.program_length < 0 || length > kInstructionWords) return false;
+    return c.offset == -1 || (c.offset >= 0 && c.offset + length <= kInstructionWords);
+}
+}
+
+PioModule::PioModule(PioConfig cfg) : cfg_(std::move(cfg)) {
+    if (cfg_.program.empty()) return;
+    assembly_ = std::make_shared<const PioAssembly>(PioAssembler::assemble(cfg_.program));
+    // `.origin` fixes the load offset like `offset` does.
+    if (const PioProgram* p = program(); p && p->origin >= 0 && cfg_.offset < 0) cfg_.offset = p->origin;
+}
+
+const PioProgram* PioModule::program() const {
+    if (!assembly_ || !assembly_->ok() || assembly_->programs.size() != 1) return nullptr;
+    return &assembly_->programs.front();
+}
+
+int PioModule::programLength() const {
+    if (assembly_ && !assembly_->programs.empty()) return assembly_->programs.front().length();
+    return cfg_.program_length > 0 ? cfg_.program_length : preset_length(cfg_.preset);
 }
 
 bool PioModule::validate() const {
+    if (!cfg_.program.empty()) {
+        const PioProgram* p = program();
+        if (!p || !cfg_.preset.empty() || (p->origin >= 0 && p->origin != cfg_.offset)) return false;
+    }
     return !cfg_.name.empty() && is_valid_sm_count(cfg_.sm_count) &&
-           is_valid_pin(cfg_.data_pin) && is_valid_preset(cfg_.preset);
+           is_valid_pin(cfg_.data_pin) && is_valid_preset(cfg_.preset) &&
+           is_valid_placement(cfg_, programLength()) && is_valid_ws2812(cfg_);
 }
 
-std::string PioModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "// PIO program: " << cfg_.name << "\n";
-    oss << "PIO pio = pio0;\n";
-    oss << "uint sm = pio_claim_unused_sm(pio, true);\n";
+// Scoped so every PIO module can declare its own pio, sm and offset in main().
+void PioModule::emit(CodeWriter& out) const {
+    out << "// PIO program: " << cfg_.name << "\n";
+    out << "{\n";
+    out.indent();
+    if (placed()) {
+        // Fixed at generation time, where conflicts were already ruled out, so
+        // boot skips the claim bookkeeping.
+        out << "PIO pio = pio" << cfg_.block << ";\n";
+        out << "const uint sm = " << cfg_.sm << ";\n";
+        if (cfg_.offset >= 0 && programLength() > 0) {
+            out << "// Program at instruction words " << cfg_.offset << "-"
+                << cfg_.offset + programLength() - 1 << "\n";
+        }
+    } else {
+        out << "PIO pio = pio0;\n";
+        out << "uint sm = pio_claim_unused_sm(pio, true);\n";
+    }
     
     if (cfg_.preset == "ws2812") {
-        oss << "// WS2812 preset on pin " << cfg_.data_pin << "\n";
-        oss << "pio_gpio_init(pio, " << cfg_.data_pin << ");\n";
+        out << "// WS2812 preset on pin " << cfg_.data_pin << "\n";
+        out << "pio_gpio_init(pio, " << cfg_.data_pin << ");\n";
+        emitWs2812Init(out);
     } else if (!cfg_.preset.empty()) {
-        oss << "// Preset: " << cfg_.preset << " on pin " << cfg_.data_pin << "\n";
+        out << "// Preset: " << cfg_.preset << " on pin " << cfg_.data_pin << "\n";
+    } else if (const PioProgram* p = program()) {
+        emitProgramInit(*p, out);
+    } else if (assembly_) {
+        for (const auto& error : assembly_->errors) out << "// pio assembler: " << error << "\n";
     } else {
-        oss << "// Custom PIO program init placeholder\n";
+        out << "// Custom PIO program init placeholder\n";
     }
-    
-    return oss.str();
+    out.dedent();
+    out << "}\n";
 }
 
-std::string PioModule::generateHeaderCode() const {
-    return "#include <hardware/pio.h>\n";
+// Declares `offset` for the code that follows.
+void PioModule::emitProgramLoad(const PioProgram& p, CodeWriter& out) const {
+    const std::string prog = p.name + "_program";
+    if (placed() && cfg_.offset >= 0) {
+        // A program shared with another module is already there.
+        out << "const uint offset = " << cfg_.offset << ";\n";
+        out << "if (pio_can_add_program_at_offset(pio, &" << prog << ", offset)) {\n";
+        out.indent();
+        out << "pio_add_program_at_offset(pio, &" << prog << ", offset);\n";
+        out.dedent();
+        out << "}\n";
+    } else {
+        out << "uint offset = pio_add_program(pio, &" << prog << ");\n";
+    }
+}
+
+// Loads the program and starts its state machines with data_pin as every pin
+// base; programs spanning several pins need their own init on top.
+void PioModule::emitProgramInit(const PioProgram& p, CodeWriter& out) const {
+    const std::string prog = p.name + "_program";
+    const int pin = cfg_.data_pin;
+    emitProgramLoad(p, out);
+    out << "pio_gpio_init(pio, " << pin << ");\n";
+    out << "pio_sm_config c = " << prog << "_get_default_config(offset);\n";
+    out << "sm_config_set_out_pins(&c, " << pin << ", 1);\n";
+    out << "sm_config_set_set_pins(&c, " << pin << ", 1);\n";
+    out << "sm_config_set_in_pins(&c, " << pin << ");\n";
+    if (p.sideset_bits > 0) out << "sm_config_set_sideset_pins(&c, " << pin << ");\n";
+    const bool output = drives_pins(p);
+    if (placed() && cfg_.sm_count > 1) {
+        out << "for (uint i = 0; i < " << cfg_.sm_count << "; ++i) {\n";
+        out.indent();
+        out << "pio_sm_set_consecutive_pindirs(pio, sm + i, " << pin << ", 1, " << (output ? "true" : "false") << ");\n";
+        out << "pio_sm_init(pio, sm + i, offset, &c);\n";
+        out.dedent();
+        out << "}\n";
+        out << "pio_set_sm_mask_enabled(pio, " << ((1 << cfg_.sm_count) - 1) << "u << sm, true);\n";
+    } else {
+        out << "pio_sm_set_consecutive_pindirs(pio, sm, " << pin << ", 1, " << (output ? "true" : "false") << ");\n";
+        out << "pio_sm_init(pio, sm, offset, &c);\n";
+        out << "pio_sm_set_enabled(pio, sm, true);\n";
+    }
+}
+
+// Side-set output at the bit rate; with a frame buffer, one DMA channel streams
+// the shown frame into the joined TX FIFO.
+void PioModule::emitWs2812Init(CodeWriter& out) const {
+    const int pin = cfg_.data_pin;
+    const std::string p = id();
+    const std::string irq = std::to_string(cfg_.irq_line);
+    emitProgramLoad(ws2812_program(), out);
+    out << "pio_sm_set_consecutive_pindirs(pio, sm, " << pin << ", 1, true);\n";
+    out << "pio_sm_config c = ws2812_program_get_default_config(offset);\n";
+    out << "sm_config_set_sideset_pins(&c, " << pin << ");\n";
+    out << "sm_config_set_out_shift(&c, false, true, " << (cfg_.rgbw ? 32 : 24) << ");\n";
+    out << "sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);\n";
+    out << "sm_config_set_clkdiv(&c, clock_get_hz(clk_sys) / (" << cfg_.freq_hz
+        << ".0f * (ws2812_T1 + ws2812_T2 + ws2812_T3)));\n";
+    out << "pio_sm_init(pio, sm, offset, &c);\n";
+    out << "pio_sm_set_enabled(pio, sm, true);\n";
+    if (drivesLeds()) {
+        if (cfg_.dma_channel >= 0) {
+            out << p << "_dma_chan = " << cfg_.dma_channel << ";\n";
+        } else {
+            out << p << "_dma_chan = dma_claim_unused_channel(true);\n";
+        }
+        out << "dma_channel_config d = dma_channel_get_default_config(" << p << "_dma_chan);\n";
+        out << "channel_config_set_transfer_data_size(&d, DMA_SIZE_32);\n";
+        out << "channel_config_set_read_increment(&d, true);\n";
+        out << "channel_config_set_write_increment(&d, false);\n";
+        out << "channel_config_set_dreq(&d, pio_get_dreq(pio, sm, true));\n";
+        out << "dma_channel_configure(" << p << "_dma_chan, &d, &pio->txf[sm], " << p << "_frames[0], "
+            << cfg_.led_count << ", false);\n";
+        out << "dma_channel_set_irq" << irq << "_enabled(" << p << "_dma_chan, true);\n";
+        out << "irq_add_shared_handler(DMA_IRQ_" << irq << ", " << p
+            << "_dma_irq, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);\n";
+        out << "irq_set_enabled(DMA_IRQ_" << irq << ", true);\n";
+    }
+}
+
+void PioModule::emitWs2812Definitions(CodeWriter& out) const {
+    const std::string p = id();
+    const std::string irq = std::to_string(cfg_.irq_line);
+    const int n = cfg_.led_count;
+    out << "// " << p << ": " << n << " WS2812 pixels (" << (cfg_.rgbw ? "GRBW" : "GRB") << ") on GPIO "
+        << cfg_.data_pin << ", double-buffered. Draw into " << p << "_pixels(),\n";
+    out << "// then " << p << "_show(); DMA feeds the PIO and an alarm frees the frame once latched.\n";
+    out << "static uint32_t " << p << "_frames[2][" << n << "];\n";
+    out << "static uint " << p << "_dma_chan;\n";
+    out << "static volatile uint8_t " << p << "_back;  // buffer being drawn\n";
+    out << "static volatile bool " << p << "_busy;     // a frame is sending or latching\n\n";
+
+    out << "static int64_t " << p << "_latched(alarm_id_t id, void* user) {\n";
+    out.indent();
+    out << "(void)id;\n";
+    out << "(void)user;\n";
+    out << p << "_busy = false;\n";
+    out << "return 0;\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "static void " << p << "_dma_irq(void) {\n";
+    out.indent();
+    out << "if (!dma_channel_get_irq" << irq << "_status(" << p << "_dma_chan)) return;\n";
+    out << "dma_channel_acknowledge_irq" << irq << "(" << p << "_dma_chan);\n";
+    out << "// FIFO and shift register drain, then " << kWs2812ResetUs << " us low latches the frame.\n";
+    out << "add_alarm_in_us(" << ws2812_latch_us(cfg_) << ", " << p << "_latched, nullptr, true);\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "static inline uint32_t* " << p << "_pixels(void) {\n";
+    out.indent();
+    out << "return " << p << "_frames[" << p << "_back];\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "static inline void " << p << "_set_pixel(uint i, uint8_t r, uint8_t g, uint8_t b"
+        << (cfg_.rgbw ? ", uint8_t w" : "") << ") {\n";
+    out.indent();
+    out << p << "_frames[" << p << "_back][i] = ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8)"
+        << (cfg_.rgbw ? " | w" : "") << ";\n";
+    out.dedent();
+    out << "}\n\n";
+
+    out << "// Sends the drawn frame and flips buffers; false while the last frame is\n";
+    out << "// still going out. The next draw buffer holds the frame before last.\n";
+    out << "static inline bool " << p << "_show(void) {\n";
+    out.indent();
+    out << "if (" << p << "_busy) return false;\n";
+    out << p << "_busy = true;\n";
+    out << "dma_channel_set_read_addr(" << p << "_dma_chan, " << p << "_frames[" << p << "_back], true);\n";
+    out << p << "_back ^= 1;\n";
+    out << "return true;\n";
+    out.dedent();
+    out << "}\n\n";
+}
+
+void PioModule::emitDefinitions(CodeWriter& out) const {
+    const PioProgram* p = cfg_.preset == "ws2812" ? &ws2812_program() : cfg_.preset.empty() ? program() : nullptr;
+    if (!p) return;
+    // Modules running the same program share one copy.
+    out << "#ifndef " << p->name << "_wrap_target\n";
+    PioAssembler::emitProgram(*p, out);
+    out << "#endif  // " << p->name << "_wrap_target\n\n";
+    if (drivesLeds()) emitWs2812Definitions(out);
+}
+
+void PioModule::emitHeader(CodeWriter& out) const {
+    for (Symbol dep : dependencies()) out << "#include <" << dep.str() << ".h>\n";
+}
+
+std::vector<Symbol> PioModule::dependencies() const {
+    static const Symbol pio("hardware/pio"), clocks("hardware/clocks"), dma("hardware/dma"), irq("hardware/irq"),
+        time("pico/time");
+    if (drivesLeds()) return {pio, clocks, dma, irq, time};
+    if (cfg_.preset == "ws2812") return {pio, clocks};
+    return {pio};
+}
+
+std::string PioModule::configKey() const {
+    return ConfigKeyBuilder("pio")
+        .field("name", cfg_.name)
+        .field("preset", cfg_.preset)
+        .field("sm_count", cfg_.sm_count)
+        .field("data_pin", cfg_.data_pin)
+        .field("block", cfg_.block)
+        .field("sm", cfg_.sm)
+        .field("offset", cfg_.offset)
+        .field("program_length", cfg_.program_length)
+        .field("program", cfg_.program)
+        .field("led_count", cfg_.led_count)
+        .field("rgbw", cfg_.rgbw)
+        .field("freq_hz", cfg_.freq_hz)
+        .field("dma_channel", cfg_.dma_channel)
+        .field("irq_line", cfg_.irq_line)
+        .str();
+}
+
+void PioModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::Gpio, cfg_.data_pin, "data");
+    for (int i = 0; i < cfg_.sm_count; ++i) {
+        if (placed()) {
+            claims.claim(ResourceKind::PioStateMachine, cfg_.block * 4 + cfg_.sm + i, "sm");
+        } else if (cfg_.block >= 0) {
+            claims.claimAny(ResourceKind::PioStateMachine, cfg_.block * 4, 4, "sm");
+        } else {
+            claims.claimAny(ResourceKind::PioStateMachine, 0, resourceCapacity(ResourceKind::PioStateMachine), "sm");
+        }
+    }
+    if (!drivesLeds()) return;
+    if (cfg_.dma_channel >= 0) {
+        claims.claim(ResourceKind::DmaChannel, cfg_.dma_channel, "ws2812 frame");
+    } else {
+        claims.claimAny(ResourceKind::DmaChannel, 0, resourceCapacity(ResourceKind::DmaChannel), "ws2812 frame");
+    }
 }
 
 }  // namespace picoforge
@@ -1,39 +1,80 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "../core/module.h"
+#include "../pio/pio_assembler.h"
 
 namespace picoforge {
 
 struct PioConfig {
-    std::string name;
+    std::string name = "pio0";
     std::string preset; // ws2812, uart, spi, i2c, or empty for custom
-    int sm_count;
-    int data_pin;
+    int sm_count = 1;
+    int data_pin = 0;
+    // Placement; -1 leaves it to ResourceAllocator. State machines sm..sm+sm_count-1
+    // of pio<block> run the program loaded at instruction word `offset`.
+    int block = -1;
+    int sm = -1;
+    int offset = -1;
+    int program_length = 0;  // instruction words; 0 uses the preset's length
+    std::string program{};   // custom .pio source (one .program), assembled at generation time
+    // ws2812 preset: a double-buffered frame of `led_count` pixels fed to the TX
+    // FIFO by DMA; 0 only starts the state machine (pixels via pio_sm_put_blocking).
+    int led_count = 0;
+    bool rgbw = false;       // 32-bit GRBW pixels instead of 24-bit GRB
+    int freq_hz = 800000;    // bit rate
+    int dma_channel = -1;    // -1 for auto
+    int irq_line = 0;        // DMA_IRQ_0 or DMA_IRQ_1
 };
 
 class PioModule : public IModule {
 public:
-    PioModule() : cfg_{"pio0", "", 1, 0} {}
-    explicit PioModule(PioConfig cfg) : cfg_(std::move(cfg)) {}
+    static constexpr std::string_view kTypeName = "pio";
 
-    std::string id() const override { 
+    PioModule() = default;
+    explicit PioModule(PioConfig cfg);
+
+    std::string buildId() const override { 
         if (cfg_.name == "pio0" && cfg_.preset.empty()) return "pio"; // default
         return "pio_" + cfg_.name; 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    void emitDefinitions(CodeWriter& out) const override;
 
-    std::string generateHeaderCode() const override;
+    std::vector<Symbol> dependencies() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/pio"}; }
+    std::string configKey() const override;
+
+    void claimResources(ResourceClaims& claims) const override;
+
+    const PioConfig& config() const { return cfg_; }
+    // Instruction words the program occupies (0 for a custom program of unknown size).
+    int programLength() const;
+    bool placed() const { return cfg_.block >= 0 && cfg_.sm >= 0; }
+    // ws2812 strip with a DMA-fed frame buffer.
+    bool drivesLeds() const { return cfg_.preset == "ws2812" && cfg_.led_count > 0; }
+    // Assembled `program` source; null without one. Check ok() before use.
+    const PioAssembly* assembly() const { return assembly_.get(); }
+    // The one assembled program, or nullptr if there is none or it has errors.
+    const PioProgram* program() const;
 
 private:
+    void emitProgramLoad(const PioProgram& program, CodeWriter& out) const;
+    void emitProgramInit(const PioProgram& program, CodeWriter& out) const;
+    void emitWs2812Init(CodeWriter& out) const;
+    void emitWs2812Definitions(CodeWriter& out) const;
+
     PioConfig cfg_;
+    std::shared_ptr<const PioAssembly> assembly_;  // shared by copies; assembled once
 };
 
 }  // namespace picoforge
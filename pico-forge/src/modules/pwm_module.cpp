@@ -1,6 +1,6 @@
 #include "pwm_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -14,19 +14,32 @@ bool PwmModule::validate() const {
     return is_valid_pin(cfg_.pin) && is_valid_freq(cfg_.freq_hz) && is_valid_duty(cfg_.duty_pct);
 }
 
-std::string PwmModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "gpio_set_function(" << cfg_.pin << ", GPIO_FUNC_PWM);\n";
-    oss << "uint slice = pwm_gpio_to_slice_num(" << cfg_.pin << ");\n";
-    oss << "pwm_set_clkdiv(slice, 1.0f);\n";
-    oss << "pwm_set_wrap(slice, 125000000 / " << cfg_.freq_hz << ");\n";
-    oss << "pwm_set_chan_level(slice, pwm_gpio_to_channel(" << cfg_.pin << "), (uint16_t)((" << cfg_.duty_pct << "f/100.0f) * pwm_get_wrap(slice)));\n";
-    oss << "pwm_set_enabled(slice, true);\n";
-    return oss.str();
+void PwmModule::emit(CodeWriter& out) const {
+    out << "gpio_set_function(" << cfg_.pin << ", GPIO_FUNC_PWM);\n";
+    out << "uint slice = pwm_gpio_to_slice_num(" << cfg_.pin << ");\n";
+    out << "pwm_set_clkdiv(slice, 1.0f);\n";
+    out << "pwm_set_wrap(slice, 125000000 / " << cfg_.freq_hz << ");\n";
+    out << "pwm_set_chan_level(slice, pwm_gpio_to_channel(" << cfg_.pin << "), (uint16_t)((" << cfg_.duty_pct << "f/100.0f) * pwm_get_wrap(slice)));\n";
+    out << "pwm_set_enabled(slice, true);\n";
 }
 
-std::string PwmModule::generateHeaderCode() const {
-    return "#include <hardware/pwm.h>\n";
+void PwmModule::emitHeader(CodeWriter& out) const {
+    out << "#include <hardware/pwm.h>\n";
+}
+
+std::string PwmModule::configKey() const {
+    return ConfigKeyBuilder("pwm")
+        .field("pin", cfg_.pin)
+        .field("freq_hz", cfg_.freq_hz)
+        .field("duty_pct", cfg_.duty_pct)
+        .str();
+}
+
+void PwmModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::Gpio, cfg_.pin, "pwm");
+    // emit() sets the wrap and divider for the whole slice, so both of its
+    // channels belong to one module.
+    if (cfg_.pin >= 0) claims.claim(ResourceKind::PwmSlice, (cfg_.pin >> 1) & 7, "pwm");
 }
 
 }  // namespace picoforge
@@ -8,28 +8,37 @@
 namespace picoforge {
 
 struct PwmConfig {
-    int pin;
-    int freq_hz;
-    double duty_pct;  // 0-100
+    int pin = 0;
+    int freq_hz = 1000;
+    double duty_pct = 50.0;  // 0-100
 };
 
 class PwmModule : public IModule {
 public:
-    PwmModule() : cfg_{0, 1000, 50} {}
+    static constexpr std::string_view kTypeName = "pwm";
+
+    PwmModule() = default;
     explicit PwmModule(PwmConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.pin == 0 && cfg_.freq_hz == 1000) return "pwm"; // default
         return "pwm_" + std::to_string(cfg_.pin); 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("hardware/pwm");
+        return {dep};
+    }
 
-    std::string generateHeaderCode() const override;
+    std::string configKey() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/pwm"}; }
+    void claimResources(ResourceClaims& claims) const override;
 
 private:
     PwmConfig cfg_;
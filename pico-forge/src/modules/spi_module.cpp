@@ -1,6 +1,6 @@
 #include "spi_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -17,18 +17,34 @@ bool SpiModule::validate() const {
            is_valid_speed(cfg_.speed_hz) && is_valid_mode(cfg_.mode);
 }
 
-std::string SpiModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "spi_init(spi" << cfg_.id << ", " << cfg_.speed_hz << ");\n";
-    oss << "gpio_set_function(" << cfg_.sck << ", GPIO_FUNC_SPI);\n";
-    oss << "gpio_set_function(" << cfg_.mosi << ", GPIO_FUNC_SPI);\n";
-    oss << "gpio_set_function(" << cfg_.miso << ", GPIO_FUNC_SPI);\n";
-    oss << "spi_set_format(spi" << cfg_.id << ", 8, " << cfg_.mode << ", SPI_MSB_FIRST, false);\n";
-    return oss.str();
+void SpiModule::emit(CodeWriter& out) const {
+    out << "spi_init(spi" << cfg_.id << ", " << cfg_.speed_hz << ");\n";
+    out << "gpio_set_function(" << cfg_.sck << ", GPIO_FUNC_SPI);\n";
+    out << "gpio_set_function(" << cfg_.mosi << ", GPIO_FUNC_SPI);\n";
+    out << "gpio_set_function(" << cfg_.miso << ", GPIO_FUNC_SPI);\n";
+    out << "spi_set_format(spi" << cfg_.id << ", 8, " << cfg_.mode << ", SPI_MSB_FIRST, false);\n";
 }
 
-std::string SpiModule::generateHeaderCode() const {
-    return "#include <hardware/spi.h>\n";
+void SpiModule::emitHeader(CodeWriter& out) const {
+    out << "#include <hardware/spi.h>\n";
+}
+
+std::string SpiModule::configKey() const {
+    return ConfigKeyBuilder("spi")
+        .field("id", cfg_.id)
+        .field("sck", cfg_.sck)
+        .field("mosi", cfg_.mosi)
+        .field("miso", cfg_.miso)
+        .field("speed_hz", cfg_.speed_hz)
+        .field("mode", cfg_.mode)
+        .str();
+}
+
+void SpiModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::Spi, cfg_.id, "spi");
+    claims.claim(ResourceKind::Gpio, cfg_.sck, "sck");
+    claims.claim(ResourceKind::Gpio, cfg_.mosi, "mosi");
+    claims.claim(ResourceKind::Gpio, cfg_.miso, "miso");
 }
 
 }  // namespace picoforge
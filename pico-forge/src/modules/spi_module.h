@@ -8,31 +8,40 @@
 namespace picoforge {
 
 struct SpiConfig {
-    int id;       // 0 or 1
-    int sck;
-    int mosi;
-    int miso;
-    int speed_hz;
-    int mode;     // 0-3
+    int id = 0;       // 0 or 1
+    int sck = 18;
+    int mosi = 19;
+    int miso = 16;
+    int speed_hz = 1000000;
+    int mode = 0;     // 0-3
 };
 
 class SpiModule : public IModule {
 public:
-    SpiModule() : cfg_{0, 18, 19, 16, 1000000, 0} {}
+    static constexpr std::string_view kTypeName = "spi";
+
+    SpiModule() = default;
     explicit SpiModule(SpiConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.id == 0 && cfg_.speed_hz == 1000000) return "spi"; // default
         return "spi_" + std::to_string(cfg_.id); 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("hardware/spi");
+        return {dep};
+    }
 
-    std::string generateHeaderCode() const override;
+    std::string configKey() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/spi"}; }
+    void claimResources(ResourceClaims& claims) const override;
 
 private:
     SpiConfig cfg_;
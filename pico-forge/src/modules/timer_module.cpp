@@ -1,6 +1,6 @@
 #include "timer_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -13,15 +13,22 @@ bool TimerModule::validate() const {
     return is_non_empty(cfg_.id) && is_valid_interval(cfg_.interval_ms) && is_non_empty(cfg_.callback);
 }
 
-std::string TimerModule::generateInitCode() const {
-    std::ostringstream oss;
+void TimerModule::emit(CodeWriter& out) const {
     const auto type = cfg_.periodic ? "true" : "false";
-    oss << "add_alarm_in_ms(" << cfg_.interval_ms << ", " << cfg_.callback << ", nullptr, " << type << ");\n";
-    return oss.str();
+    out << "add_alarm_in_ms(" << cfg_.interval_ms << ", " << cfg_.callback << ", nullptr, " << type << ");\n";
 }
 
-std::string TimerModule::generateHeaderCode() const {
-    return "#include <pico/time.h>\n";
+void TimerModule::emitHeader(CodeWriter& out) const {
+    out << "#include <pico/time.h>\n";
+}
+
+std::string TimerModule::configKey() const {
+    return ConfigKeyBuilder("timer")
+        .field("id", cfg_.id)
+        .field("interval_ms", cfg_.interval_ms)
+        .field("periodic", cfg_.periodic)
+        .field("callback", cfg_.callback)
+        .str();
 }
 
 }  // namespace picoforge
@@ -8,29 +8,36 @@
 namespace picoforge {
 
 struct TimerConfig {
-    std::string id;
-    int interval_ms;
-    bool periodic;
+    std::string id = "timer0";
+    int interval_ms = 1000;
+    bool periodic = false;
     std::string callback;
 };
 
 class TimerModule : public IModule {
 public:
-    TimerModule() : cfg_{"timer0", 1000, false, ""} {}
+    static constexpr std::string_view kTypeName = "timer";
+
+    TimerModule() = default;
     explicit TimerModule(TimerConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.id == "timer0") return "timer"; // default
         return "timer_" + cfg_.id; 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
 
-    std::string generateHeaderCode() const override;
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("pico/time.h");
+        return {dep};
+    }
 
-    std::vector<std::string> dependencies() const override { return {"pico/time.h"}; }
+    std::string configKey() const override;
 
 private:
     TimerConfig cfg_;
@@ -1,6 +1,6 @@
 #include "uart_module.h"
 
-#include <sstream>
+#include "../core/config_key.h"
 
 namespace picoforge {
 
@@ -19,20 +19,34 @@ bool UartModule::validate() const {
            is_valid_parity(cfg_.parity);
 }
 
-std::string UartModule::generateInitCode() const {
-    std::ostringstream oss;
-    oss << "uart_init(uart" << cfg_.id << ", " << cfg_.baud << ");\n";
-    oss << "gpio_set_function(" << cfg_.tx_pin << ", GPIO_FUNC_UART);\n";
-    oss << "gpio_set_function(" << cfg_.rx_pin << ", GPIO_FUNC_UART);\n";
+void UartModule::emit(CodeWriter& out) const {
+    out << "uart_init(uart" << cfg_.id << ", " << cfg_.baud << ");\n";
+    out << "gpio_set_function(" << cfg_.tx_pin << ", GPIO_FUNC_UART);\n";
+    out << "gpio_set_function(" << cfg_.rx_pin << ", GPIO_FUNC_UART);\n";
     if (cfg_.parity != "none") {
-        oss << "uart_set_format(uart" << cfg_.id << ", 8, 1, UART_PARITY_" 
+        out << "uart_set_format(uart" << cfg_.id << ", 8, 1, UART_PARITY_" 
             << (cfg_.parity == "even" ? "EVEN" : "ODD") << ");\n";
     }
-    return oss.str();
 }
 
-std::string UartModule::generateHeaderCode() const {
-    return "#include <hardware/uart.h>\n";
+void UartModule::emitHeader(CodeWriter& out) const {
+    out << "#include <hardware/uart.h>\n";
+}
+
+std::string UartModule::configKey() const {
+    return ConfigKeyBuilder("uart")
+        .field("id", cfg_.id)
+        .field("baud", cfg_.baud)
+        .field("tx_pin", cfg_.tx_pin)
+        .field("rx_pin", cfg_.rx_pin)
+        .field("parity", cfg_.parity)
+        .str();
+}
+
+void UartModule::claimResources(ResourceClaims& claims) const {
+    claims.claim(ResourceKind::Uart, cfg_.id, "uart");
+    claims.claim(ResourceKind::Gpio, cfg_.tx_pin, "tx");
+    claims.claim(ResourceKind::Gpio, cfg_.rx_pin, "rx");
 }
 
 }  // namespace picoforge
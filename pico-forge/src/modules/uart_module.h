@@ -8,30 +8,39 @@
 namespace picoforge {
 
 struct UartConfig {
-    int id;           // 0 or 1
-    int baud;
-    int tx_pin;
-    int rx_pin;
-    std::string parity; // "none", "even", "odd"
+    int id = 0;           // 0 or 1
+    int baud = 115200;
+    int tx_pin = 0;
+    int rx_pin = 1;
+    std::string parity = "none"; // "none", "even", "odd"
 };
 
 class UartModule : public IModule {
 public:
-    UartModule() : cfg_{0, 115200, 0, 1, "none"} {}
+    static constexpr std::string_view kTypeName = "uart";
+
+    UartModule() = default;
     explicit UartModule(UartConfig cfg) : cfg_(std::move(cfg)) {}
 
-    std::string id() const override { 
+    std::string buildId() const override { 
         if (cfg_.id == 0 && cfg_.baud == 115200) return "uart"; // default
         return "uart_" + std::to_string(cfg_.id); 
     }
 
     bool validate() const override;
 
-    std::string generateInitCode() const override;
+    void emit(CodeWriter& out) const override;
+
+    void emitHeader(CodeWriter& out) const override;
+
+    std::vector<Symbol> dependencies() const override {
+        static const Symbol dep("hardware/uart");
+        return {dep};
+    }
 
-    std::string generateHeaderCode() const override;
+    std::string configKey() const override;
 
-    std::vector<std::string> dependencies() const override { return {"hardware/uart"}; }
+    void claimResources(ResourceClaims& claims) const override;
 
 private:
     UartConfig cfg_;
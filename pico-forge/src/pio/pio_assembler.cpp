@@ -0,0 +1,383 @@
+#include "pio_assembler.h"
+
+#include <cctype>
+#include <cstdio>
+#include <memory>
+
+#include "pio_lexer.h"
+
+namespace picoforge {
+
+using pio_detail::AsmError;
+using pio_detail::Evaluator;
+using pio_detail::SymbolMap;
+using pio_detail::Tokens;
+using pio_detail::lower;
+using pio_detail::strip_comment;
+using pio_detail::tokenize;
+using pio_detail::trim;
+
+namespace {
+constexpr int kMaxInstructions = 32;
+constexpr int kDelaySideSetBits = 5;
+
+int keyword_index(Tokens& t, std::initializer_list<std::pair<const char*, int>> table, const char* what) {
+    for (const auto& [name, code] : table) {
+        if (t.accept(name)) return code;
+    }
+    throw AsmError(std::string("expected ") + what + t.near());
+}
+
+struct PendingInstruction {
+    int line;
+    std::vector<std::string> tokens;
+};
+
+// Accumulates one .program; instructions are encoded once all its labels are known.
+class ProgramBuilder {
+public:
+    ProgramBuilder(std::string name, const SymbolMap& globals) : globals_(globals) { program_.name = std::move(name); }
+
+    PioProgram& program() { return program_; }
+    SymbolMap& symbols() { return locals_; }
+    int count() const { return static_cast<int>(pending_.size()); }
+
+    void addLabel(const std::string& name, bool isPublic) {
+        if (locals_.count(name)) throw AsmError("duplicate symbol '" + name + "'");
+        locals_[name] = count();
+        if (isPublic) program_.public_labels.emplace_back(name, count());
+    }
+
+    void addInstruction(int line, std::vector<std::string> tokens, std::string listing) {
+        pending_.push_back({line, std::move(tokens)});
+        program_.listing.push_back(std::move(listing));
+    }
+
+    PioProgram finish(std::vector<std::string>& errors) {
+        for (const auto& p : pending_) {
+            try {
+                program_.instructions.push_back(encode(p.tokens));
+            } catch (const AsmError& e) {
+                errors.push_back("line " + std::to_string(p.line) + ": " + e.what());
+                program_.instructions.push_back(0);
+            }
+        }
+        const std::string where = "program '" + program_.name + "'";
+        if (program_.instructions.empty()) errors.push_back(where + " has no instructions");
+        if (program_.length() > kMaxInstructions) {
+            errors.push_back(where + " is " + std::to_string(program_.length()) +
+                             " instructions; PIO memory holds " + std::to_string(kMaxInstructions));
+        }
+        if (program_.origin >= 0 && program_.origin + program_.length() > kMaxInstructions) {
+            errors.push_back(where + " does not fit at .origin " + std::to_string(program_.origin));
+        }
+        if (program_.wrap_target > program_.wrapEnd() && !program_.instructions.empty()) {
+            errors.push_back(where + " has .wrap_target after .wrap");
+        }
+        return std::move(program_);
+    }
+
+private:
+    long long value(Tokens& t, long long lo, long long hi, const char* what) {
+        long long v = Evaluator(t, globals_, locals_).expression();
+        if (v < lo || v > hi) {
+            throw AsmError(std::string(what) + " " + std::to_string(v) + " is outside " + std::to_string(lo) + "-" +
+                           std::to_string(hi));
+        }
+        return v;
+    }
+
+    int jmp_condition(Tokens& t) {
+        if (t.accept("!")) return keyword_index(t, {{"x", 1}, {"y", 3}, {"osre", 7}}, "x, y or osre after '!'");
+        if ((t.peekIs("x") || t.peekIs("y")) && t.peekIs("--", 1)) {
+            int cond = t.peekIs("x") ? 2 : 4;
+            t.next();
+            t.next();
+            return cond;
+        }
+        if (t.peekIs("x") && t.peekIs("!=", 1) && t.peekIs("y", 2)) {
+            for (int i = 0; i < 3; ++i) t.next();
+            return 5;
+        }
+        if (t.peekIs("pin") && !locals_.count(t.peek()) && !globals_.count(t.peek())) {
+            t.next();
+            return 6;
+        }
+        return 0;
+    }
+
+    uint16_t encode_base(Tokens& t) {
+        std::string op = lower(t.next());
+        if (op == ".word") return static_cast<uint16_t>(value(t, 0, 0xFFFF, "word"));
+        if (op == "nop") return 0xA042;  // mov y, y
+        if (op == "jmp") {
+            int cond = jmp_condition(t);
+            t.accept(",");
+            return static_cast<uint16_t>(cond << 5 | value(t, 0, kMaxInstructions - 1, "jump target"));
+        }
+        if (op == "wait") {
+            long long polarity = 1;
+            if (!t.peekIs("gpio") && !t.peekIs("pin") && !t.peekIs("irq")) polarity = value(t, 0, 1, "polarity");
+            int source = keyword_index(t, {{"gpio", 0}, {"pin", 1}, {"irq", 2}}, "gpio, pin or irq");
+            t.accept(",");
+            long long index = value(t, 0, source == 2 ? 7 : 31, "wait index");
+            if (source == 2 && t.accept("rel")) index |= 0x10;
+            return static_cast<uint16_t>(0x2000 | polarity << 7 | source << 5 | index);
+        }
+        if (op == "in" || op == "out") {
+            int reg = op == "in"
+                ? keyword_index(t, {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"isr", 6}, {"osr", 7}}, "in source")
+                : keyword_index(t, {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"pindirs", 4}, {"pc", 5},
+                                    {"isr", 6}, {"exec", 7}}, "out destination");
+            t.expect(",");
+            long long bits = value(t, 1, 32, "bit count");
+            return static_cast<uint16_t>((op == "in" ? 0x4000 : 0x6000) | reg << 5 | (bits & 31));
+        }
+        if (op == "push" || op == "pull") {
+            bool pull = op == "pull";
+            int flags = 1 << 5;  // block unless told otherwise
+            for (bool more = true; more;) {
+                if (t.accept(pull ? "ifempty" : "iffull")) flags |= 1 << 6;
+                else if (t.accept("block")) flags |= 1 << 5;
+                else if (t.accept("noblock")) flags &= ~(1 << 5);
+                else more = false;
+            }
+            return static_cast<uint16_t>(0x8000 | (pull ? 0x80 : 0) | flags);
+        }
+        if (op == "mov") {
+            int dst = keyword_index(t, {{"pins", 0}, {"x", 1}, {"y", 2}, {"exec", 4}, {"pc", 5}, {"isr", 6},
+                                        {"osr", 7}}, "mov destination");
+            t.expect(",");
+            int op2 = (t.accept("!") || t.accept("~")) ? 1 : (t.accept("::") ? 2 : 0);  // invert, reverse
+            int src = keyword_index(t, {{"pins", 0}, {"x", 1}, {"y", 2}, {"null", 3}, {"status", 5}, {"isr", 6},
+                                        {"osr", 7}}, "mov source");
+            return static_cast<uint16_t>(0xA000 | dst << 5 | op2 << 3 | src);
+        }
+        if (op == "irq") {
+            int mode = 0;
+            if (t.accept("wait")) mode = 1 << 5;
+            else if (t.accept("clear")) mode = 1 << 6;
+            else if (!t.accept("set")) t.accept("nowait");
+            long long index = value(t, 0, 7, "irq index");
+            if (t.accept("rel")) index |= 0x10;
+            return static_cast<uint16_t>(0xC000 | mode | index);
+        }
+        if (op == "set") {
+            int dst = keyword_index(t, {{"pins", 0}, {"x", 1}, {"y", 2}, {"pindirs", 4}}, "set destination");
+            t.expect(",");
+            return static_cast<uint16_t>(0xE000 | dst << 5 | value(t, 0, 31, "set value"));
+        }
+        throw AsmError("unknown instruction '" + op + "'");
+    }
+
+    uint16_t encode(const std::vector<std::string>& tokens) {
+        Tokens t(tokens);
+        bool raw = t.peekIs(".word");
+        uint16_t word = encode_base(t);
+        const int sideBits = program_.sideset_bits + (program_.sideset_optional ? 1 : 0);
+        const int delayBits = kDelaySideSetBits - sideBits;
+        long long side = -1;
+        long long delay = 0;
+        while (!t.done()) {
+            if (t.accept("side") || t.accept("sideset") || t.accept("side_set")) {
+                if (program_.sideset_bits == 0) throw AsmError("'side' without .side_set");
+                side = value(t, 0, (1 << program_.sideset_bits) - 1, "side-set value");
+            } else if (t.accept("[")) {
+                delay = value(t, 0, (1 << delayBits) - 1, "delay");
+                t.expect("]");
+            } else {
+                throw AsmError("unexpected '" + t.peek() + "'");
+            }
+        }
+        if (raw) return word;
+        if (side < 0 && program_.sideset_bits > 0 && !program_.sideset_optional) {
+            throw AsmError("'side' is required (.side_set is not opt)");
+        }
+        int field = static_cast<int>(delay);
+        if (side >= 0) {
+            field |= static_cast<int>(side) << delayBits;
+            if (program_.sideset_optional) field |= 1 << 4;
+        }
+        return static_cast<uint16_t>(word | field << 8);
+    }
+
+    const SymbolMap& globals_;
+    SymbolMap locals_;
+    PioProgram program_;
+    std::vector<PendingInstruction> pending_;
+};
+
+void directive(Tokens& t, const std::string& name, ProgramBuilder* b, SymbolMap& globals) {
+    if (name == ".define") {
+        bool isPublic = t.accept("public");
+        std::string symbol = t.next();
+        SymbolMap& scope = b ? b->symbols() : globals;
+        long long v = Evaluator(t, globals, b ? b->symbols() : globals).expression();
+        if (scope.count(symbol)) throw AsmError("duplicate symbol '" + symbol + "'");
+        scope[symbol] = v;
+        if (isPublic && b) b->program().public_defines.emplace_back(symbol, static_cast<int>(v));
+        return;
+    }
+    if (name == ".lang_opt") return;  // options for other output languages
+    if (!b) throw AsmError(name + " outside .program");
+    auto& p = b->program();
+    if (name == ".side_set") {
+        if (b->count() > 0) throw AsmError(".side_set after the first instruction");
+        long long bits = Evaluator(t, globals, b->symbols()).expression();
+        p.sideset_optional = t.accept("opt");
+        p.sideset_pindirs = t.accept("pindirs");
+        if (bits < 0 || bits + (p.sideset_optional ? 1 : 0) > kDelaySideSetBits) {
+            throw AsmError(".side_set needs " + std::to_string(bits) + " bits; 5 are available");
+        }
+        p.sideset_bits = static_cast<int>(bits);
+    } else if (name == ".wrap_target") {
+        p.wrap_target = b->count();
+    } else if (name == ".wrap") {
+        if (b->count() == 0) throw AsmError(".wrap before any instruction");
+        p.wrap = b->count() - 1;
+    } else if (name == ".origin") {
+        long long origin = Evaluator(t, globals, b->symbols()).expression();
+        if (origin < 0 || origin >= kMaxInstructions) throw AsmError(".origin outside 0-31");
+        p.origin = static_cast<int>(origin);
+    } else {
+        throw AsmError("unsupported directive " + name);
+    }
+    if (!t.done()) throw AsmError("unexpected '" + t.peek() + "'");
+}
+
+// Instruction text for listings: comment and label stripped, spaces collapsed.
+std::string listing_text(std::string_view code) {
+    std::string out;
+    for (char c : trim(code)) {
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            if (!out.empty() && out.back() != ' ') out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+}  // namespace
+
+PioAssembly PioAssembler::assemble(std::string_view source) {
+    PioAssembly result;
+    SymbolMap globals;
+    std::unique_ptr<ProgramBuilder> current;
+    bool inPassthrough = false;
+    bool keepPassthrough = false;
+
+    auto finish = [&] {
+        if (current) result.programs.push_back(current->finish(result.errors));
+        current.reset();
+    };
+
+    int lineNo = 0;
+    size_t pos = 0;
+    while (pos <= source.size()) {
+        size_t end = source.find('\n', pos);
+        if (end == std::string_view::npos) end = source.size();
+        std::string_view raw = source.substr(pos, end - pos);
+        pos = end + 1;
+        ++lineNo;
+
+        if (inPassthrough) {
+            if (trim(raw).substr(0, 2) == "%}") inPassthrough = false;
+            else if (keepPassthrough) current->program().sdk_code.append(raw).append("\n");
+            continue;
+        }
+        try {
+            if (trim(raw).substr(0, 1) == "%") {
+                // % <language> { ... %}
+                auto lang = trim(trim(raw).substr(1));
+                if (lang.empty() || lang.back() != '{') throw AsmError("expected '% <language> {'");
+                lang = trim(lang.substr(0, lang.size() - 1));
+                keepPassthrough = lang == "c-sdk";
+                if (keepPassthrough && !current) throw AsmError("c-sdk block outside .program");
+                inPassthrough = true;
+                continue;
+            }
+            std::string_view code = strip_comment(raw);
+            Tokens t(tokenize(code));
+            if (t.done()) continue;
+
+            if (t.peekIs(".program")) {
+                t.next();
+                std::string name = t.next();
+                finish();
+                current = std::make_unique<ProgramBuilder>(name, globals);
+                continue;
+            }
+            if (t.peek()[0] == '.' && !t.peekIs(".word")) {
+                std::string name = lower(t.next());
+                directive(t, name, current.get(), globals);
+                continue;
+            }
+            if (!current) throw AsmError("instruction outside .program");
+
+            // [PUBLIC] label: [instruction]
+            bool isPublic = t.peekIs("public") && t.peek(2) == ":";
+            if (isPublic || t.peek(1) == ":") {
+                if (isPublic) t.next();
+                current->addLabel(t.next(), isPublic);
+                t.next();
+                code = code.substr(code.find(':') + 1);
+            }
+            std::vector<std::string> rest = tokenize(code);
+            if (!rest.empty()) current->addInstruction(lineNo, std::move(rest), listing_text(code));
+        } catch (const AsmError& e) {
+            result.errors.push_back("line " + std::to_string(lineNo) + ": " + e.what());
+        }
+    }
+    if (inPassthrough) result.errors.push_back("line " + std::to_string(lineNo) + ": unterminated % block");
+    finish();
+    if (result.programs.empty() && result.errors.empty()) result.errors.push_back("no .program in source");
+    return result;
+}
+
+void PioAssembler::emitProgram(const PioProgram& p, CodeWriter& out) {
+    const std::string& n = p.name;
+    const std::string rule(n.size(), '-');
+    out << "// " << rule << " //\n// " << n << " //\n// " << rule << " //\n\n";
+    out << "#define " << n << "_wrap_target " << p.wrap_target << "\n";
+    out << "#define " << n << "_wrap " << p.wrapEnd() << "\n";
+    for (const auto& [name, value] : p.public_defines) out << "#define " << n << "_" << name << " " << value << "\n";
+    for (const auto& [name, index] : p.public_labels) out << "#define " << n << "_offset_" << name << " " << index << "u\n";
+    out << "\n";
+
+    out << "static const uint16_t " << n << "_program_instructions[] = {\n";
+    out.indent();
+    for (int i = 0; i < p.length(); ++i) {
+        if (i == p.wrap_target) out << "        //     .wrap_target\n";
+        char word[24];
+        std::snprintf(word, sizeof word, "0x%04x, // %2d: ", p.instructions[i], i);
+        out << word << p.listing[i] << "\n";
+        if (i == p.wrapEnd()) out << "        //     .wrap\n";
+    }
+    out.dedent();
+    out << "};\n\n";
+
+    out << "#if !PICO_NO_HARDWARE\n";
+    out << "static const struct pio_program " << n << "_program = {\n";
+    out.indent();
+    out << ".instructions = " << n << "_program_instructions,\n";
+    out << ".length = " << p.length() << ",\n";
+    out << ".origin = " << p.origin << ",\n";
+    out.dedent();
+    out << "};\n\n";
+
+    out << "static inline pio_sm_config " << n << "_program_get_default_config(uint offset) {\n";
+    out.indent();
+    out << "pio_sm_config c = pio_get_default_sm_config();\n";
+    out << "sm_config_set_wrap(&c, offset + " << n << "_wrap_target, offset + " << n << "_wrap);\n";
+    if (p.sideset_bits > 0) {
+        out << "sm_config_set_sideset(&c, " << p.sideset_bits + (p.sideset_optional ? 1 : 0) << ", "
+            << (p.sideset_optional ? "true" : "false") << ", " << (p.sideset_pindirs ? "true" : "false") << ");\n";
+    }
+    out << "return c;\n";
+    out.dedent();
+    out << "}\n";
+    if (!p.sdk_code.empty()) out << "\n" << p.sdk_code;
+    out << "#endif\n\n";
+}
+
+}  // namespace picoforge
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../core/code_writer.h"
+
+namespace picoforge {
+
+// One `.program` of a .pio source, assembled to RP2040 instruction words.
+// Jump targets are relative to the program start, as pio_add_program expects.
+struct PioProgram {
+    std::string name;
+    std::vector<uint16_t> instructions;
+    std::vector<std::string> listing;  // source text of each instruction
+    int origin = -1;                   // `.origin`; -1 loads anywhere
+    int wrap_target = 0;
+    int wrap = -1;                     // -1: wraps after the last instruction
+    int sideset_bits = 0;              // value bits, without the enable bit
+    bool sideset_optional = false;
+    bool sideset_pindirs = false;
+    std::vector<std::pair<std::string, int>> public_defines;
+    std::vector<std::pair<std::string, int>> public_labels;  // label -> instruction index
+    std::string sdk_code;              // `% c-sdk { ... %}` blocks, verbatim
+
+    int length() const { return static_cast<int>(instructions.size()); }
+    int wrapEnd() const { return wrap >= 0 ? wrap : length() - 1; }
+};
+
+struct PioAssembly {
+    std::vector<PioProgram> programs;
+    std::vector<std::string> errors;  // "line N: ..."
+
+    bool ok() const { return errors.empty() && !programs.empty(); }
+};
+
+// pioasm-compatible assembler: directives (.program, .side_set [opt] [pindirs],
+// .wrap_target, .wrap, .origin, .define [PUBLIC], .word), labels, all nine
+// instructions with `side` and `[delay]`, and integer expressions.
+class PioAssembler {
+public:
+    static PioAssembly assemble(std::string_view source);
+
+    // What `pioasm -o c-sdk` writes for the program: wrap and PUBLIC
+    // #defines, the instruction array, the pio_program and
+    // `<name>_program_get_default_config`, then any c-sdk passthrough code.
+    static void emitProgram(const PioProgram& program, CodeWriter& out);
+};
+
+}  // namespace picoforge
@@ -0,0 +1,114 @@
+#include "pio_lexer.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace picoforge {
+namespace pio_detail {
+
+namespace {
+bool is_ident_char(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'; }
+
+int precedence(const std::string& op) {
+    if (op == "|") return 1;
+    if (op == "^") return 2;
+    if (op == "&") return 3;
+    if (op == "<<" || op == ">>") return 4;
+    if (op == "+" || op == "-") return 5;
+    if (op == "*" || op == "/" || op == "%") return 6;
+    return 0;
+}
+
+long long number(const std::string& token) {
+    std::string digits = lower(token);
+    int base = 10;
+    if (digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'b')) {
+        base = digits[1] == 'x' ? 16 : 2;
+        digits.erase(0, 2);
+    }
+    size_t used = 0;
+    long long value = 0;
+    try {
+        value = std::stoll(digits, &used, base);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != digits.size()) throw AsmError("bad number '" + token + "'");
+    return value;
+}
+}  // namespace
+
+std::string lower(std::string_view text) {
+    std::string out(text);
+    for (auto& c : out) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return out;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+    while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+    return s;
+}
+
+std::string_view strip_comment(std::string_view line) {
+    return line.substr(0, std::min(line.find(';'), line.find("//")));
+}
+
+std::vector<std::string> tokenize(std::string_view line) {
+    static constexpr std::string_view kPairs[] = {"--", "!=", "::", "<<", ">>"};
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < line.size()) {
+        if (std::isspace(static_cast<unsigned char>(line[i]))) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        if (is_ident_char(line[i])) {
+            while (i < line.size() && is_ident_char(line[i])) ++i;
+        } else {
+            bool pair = std::find(std::begin(kPairs), std::end(kPairs), line.substr(start, 2)) != std::end(kPairs);
+            i += pair ? 2 : 1;
+        }
+        tokens.emplace_back(line.substr(start, i - start));
+    }
+    return tokens;
+}
+
+long long Evaluator::binary(int minPrecedence) {
+    long long lhs = unary();
+    for (int p; (p = precedence(t_.peek())) > minPrecedence;) {
+        std::string op = t_.next();
+        long long rhs = binary(p);
+        if ((op == "/" || op == "%") && rhs == 0) throw AsmError("division by zero");
+        if (op == "|") lhs |= rhs;
+        else if (op == "^") lhs ^= rhs;
+        else if (op == "&") lhs &= rhs;
+        else if (op == "<<") lhs <<= rhs;
+        else if (op == ">>") lhs >>= rhs;
+        else if (op == "+") lhs += rhs;
+        else if (op == "-") lhs -= rhs;
+        else if (op == "*") lhs *= rhs;
+        else if (op == "/") lhs /= rhs;
+        else lhs %= rhs;
+    }
+    return lhs;
+}
+
+long long Evaluator::unary() {
+    if (t_.accept("-")) return -unary();
+    if (t_.accept("~")) return ~unary();
+    if (t_.accept("(")) {
+        long long value = expression();
+        t_.expect(")");
+        return value;
+    }
+    std::string token = t_.next();
+    if (std::isdigit(static_cast<unsigned char>(token[0]))) return number(token);
+    if (auto it = locals_.find(token); it != locals_.end()) return it->second;
+    if (auto it = globals_.find(token); it != globals_.end()) return it->second;
+    throw AsmError("unknown symbol '" + token + "'");
+}
+
+}  // namespace pio_detail
+}  // namespace picoforge
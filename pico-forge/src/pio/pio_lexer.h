@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace picoforge {
+
+// Line-level pieces of PioAssembler; not part of its interface.
+namespace pio_detail {
+
+using SymbolMap = std::unordered_map<std::string, long long>;
+
+struct AsmError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+std::string lower(std::string_view text);
+std::string_view trim(std::string_view s);
+// Drops a `;` or `//` comment.
+std::string_view strip_comment(std::string_view line);
+// Identifiers/numbers/directives, the pairs -- != :: << >>, else single characters.
+std::vector<std::string> tokenize(std::string_view line);
+
+// Cursor over one line's tokens. Keywords compare case-insensitively.
+class Tokens {
+public:
+    explicit Tokens(std::vector<std::string> tokens) : tokens_(std::move(tokens)) {}
+
+    bool done() const { return pos_ >= tokens_.size(); }
+    const std::string& peek(size_t ahead = 0) const {
+        static const std::string kEnd;
+        return pos_ + ahead < tokens_.size() ? tokens_[pos_ + ahead] : kEnd;
+    }
+    bool peekIs(std::string_view keyword, size_t ahead = 0) const { return lower(peek(ahead)) == keyword; }
+    std::string next() {
+        if (done()) throw AsmError("unexpected end of line");
+        return tokens_[pos_++];
+    }
+    bool accept(std::string_view keyword) {
+        if (!peekIs(keyword)) return false;
+        ++pos_;
+        return true;
+    }
+    void expect(std::string_view keyword) {
+        if (!accept(keyword)) throw AsmError("expected '" + std::string(keyword) + "'" + near());
+    }
+    std::string near() const { return done() ? " at end of line" : " near '" + peek() + "'"; }
+
+private:
+    std::vector<std::string> tokens_;
+    size_t pos_ = 0;
+};
+
+// Integer expressions: | ^ & << >> + - * / %, unary - ~, parentheses. Stops
+// at the first token that does not continue the expression.
+class Evaluator {
+public:
+    Evaluator(Tokens& t, const SymbolMap& globals, const SymbolMap& locals)
+        : t_(t), globals_(globals), locals_(locals) {}
+
+    long long expression() { return binary(0); }
+
+private:
+    long long binary(int minPrecedence);
+    long long unary();
+
+    Tokens& t_;
+    const SymbolMap& globals_;
+    const SymbolMap& locals_;
+};
+
+}  // namespace pio_detail
+}  // namespace picoforge
@@ -1,34 +1,303 @@
 #include "file_utils.h"
 
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+
+// POSIX gets mmap, fsync'd atomic writes and mode preservation; elsewhere (or
+// with PICOFORGE_PORTABLE_IO) the same interface runs on std::filesystem and
+// fstream, without mapping or fsync.
+#if !defined(PICOFORGE_PORTABLE_IO) && (defined(__unix__) || defined(__APPLE__))
+#define PICOFORGE_POSIX_IO 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define PICOFORGE_POSIX_IO 0
 #include <fstream>
-#include <sstream>
+#include <random>
+#endif
+
+#include "profiler.h"
 
 namespace picoforge {
 
+namespace fs = std::filesystem;
+
+namespace {
+#if PICOFORGE_POSIX_IO
+unsigned long process_tag() { return static_cast<unsigned long>(::getpid()); }
+
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor() { if (fd_ >= 0) ::close(fd_); }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    int get() const { return fd_; }
+    bool close() {
+        int fd = fd_;
+        fd_ = -1;
+        return ::close(fd) == 0;
+    }
+
+private:
+    int fd_;
+};
+
+// Reads to EOF straight into `out`. `expected` is the size fstat reported (0 if
+// unknown); one spare byte lets a regular file finish without growing the string.
+bool read_all(int fd, std::string& out, size_t expected) {
+    size_t used = 0;
+    out.resize(expected > 0 ? expected + 1 : 4096);
+    for (;;) {
+        if (used == out.size()) out.resize(out.size() * 2);
+        ssize_t n = ::read(fd, &out[used], out.size() - used);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            out.clear();
+            return false;
+        }
+        if (n == 0) break;
+        used += static_cast<size_t>(n);
+    }
+    out.resize(used);
+    return true;
+}
+
+bool write_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t n = ::write(fd, data.data(), data.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data.remove_prefix(static_cast<size_t>(n));
+    }
+    return true;
+}
+
+// Makes a rename durable; best effort, some filesystems refuse to fsync a directory.
+void sync_directory(const std::string& filepath) {
+    FileDescriptor dir(::open(FileUtils::getDirectory(filepath).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dir.get() >= 0) ::fsync(dir.get());
+}
+#else
+unsigned long process_tag() {
+    static const unsigned long tag = std::random_device{}();
+    return tag;
+}
+
+std::string read_stream(const std::string& filepath, bool& ok) {
+    std::ifstream in(filepath, std::ios::binary);
+    std::string content;
+    ok = in.is_open();
+    if (ok) content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return content;
+}
+#endif
+
+std::string temp_path_for(const std::string& filepath) {
+    static std::atomic<uint64_t> counter{0};
+    return filepath + ".tmp." + std::to_string(process_tag()) + "." + std::to_string(counter.fetch_add(1));
+}
+
+// A symlinked output (say a main.cpp the user linked elsewhere) is written
+// through: the temp file and rename go next to the file it points at.
+std::string write_target(const std::string& filepath) {
+    std::error_code ec;
+    if (!fs::is_symlink(filepath, ec)) return filepath;
+    fs::path resolved = fs::weakly_canonical(filepath, ec);
+    return ec ? filepath : resolved.string();
+}
+}  // namespace
+
+bool MappedFile::canMap() {
+    return PICOFORGE_POSIX_IO;
+}
+
+#if PICOFORGE_POSIX_IO
+
+MappedFile::MappedFile(const std::string& filepath) {
+    PF_PROFILE_SCOPE_DETAIL("read_file", filepath);
+    FileDescriptor fd(::open(filepath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) return;
+
+    struct stat st;
+    if (::fstat(fd.get(), &st) != 0) return;
+    size_t size = static_cast<size_t>(st.st_size);
+    if (S_ISREG(st.st_mode) && size >= kMapThreshold) {
+        void* p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+        if (p != MAP_FAILED) {
+            ::madvise(p, size, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(p);
+            size_ = size;
+            open_ = mapped_ = true;
+            return;
+        }
+    }
+
+    if (!read_all(fd.get(), buffer_, S_ISREG(st.st_mode) ? size : 0)) return;
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    open_ = true;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) return *this;
+    release();
+    buffer_ = std::move(other.buffer_);
+    size_ = other.size_;
+    open_ = other.open_;
+    mapped_ = other.mapped_;
+    // A moved std::string may change address (small-string buffer); re-point at ours.
+    data_ = mapped_ ? other.data_ : buffer_.data();
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = other.mapped_ = false;
+    return *this;
+}
+
+void MappedFile::release() {
+    if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    open_ = mapped_ = false;
+    buffer_.clear();
+}
+
 std::string FileUtils::readFile(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    PF_PROFILE_SCOPE_DETAIL("read_file", filepath);
+    FileDescriptor fd(::open(filepath.c_str(), O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) {
         return "";
     }
-    
-    std::ostringstream ss;
-    ss << file.rdbuf();
-    return ss.str();
+
+    std::string content;
+    struct stat st;
+    bool regular = ::fstat(fd.get(), &st) == 0 && S_ISREG(st.st_mode);
+    read_all(fd.get(), content, regular ? static_cast<size_t>(st.st_size) : 0);
+    return content;
+}
+
+bool FileUtils::writeFile(const std::string& path, std::string_view content, bool sync) {
+    const std::string filepath = write_target(path);
+    const std::string tmp = temp_path_for(filepath);
+    struct stat st;
+    bool existed = ::stat(filepath.c_str(), &st) == 0;
+
+    FileDescriptor fd(::open(tmp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666));
+    if (fd.get() < 0) {
+        return false;
+    }
+    bool ok = (!existed || ::fchmod(fd.get(), st.st_mode & 07777) == 0) &&
+              write_all(fd.get(), content) &&
+              (!sync || ::fsync(fd.get()) == 0);
+    ok = fd.close() && ok;
+    if (!ok || ::rename(tmp.c_str(), filepath.c_str()) != 0) {
+        ::unlink(tmp.c_str());
+        return false;
+    }
+    if (sync) sync_directory(filepath);
+    return true;
+}
+
+bool FileUtils::fileExists(const std::string& filepath) {
+    struct stat st;
+    return ::stat(filepath.c_str(), &st) == 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filepath) {
+    PF_PROFILE_SCOPE_DETAIL("read_file", filepath);
+    buffer_ = read_stream(filepath, open_);
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) return *this;
+    buffer_ = std::move(other.buffer_);
+    data_ = buffer_.data();
+    size_ = other.size_;
+    open_ = other.open_;
+    mapped_ = false;
+    other.release();
+    return *this;
+}
+
+void MappedFile::release() {
+    data_ = nullptr;
+    size_ = 0;
+    open_ = mapped_ = false;
+    buffer_.clear();
 }
 
-bool FileUtils::writeFile(const std::string& filepath, const std::string& content) {
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
+std::string FileUtils::readFile(const std::string& filepath) {
+    PF_PROFILE_SCOPE_DETAIL("read_file", filepath);
+    bool ok = false;
+    return read_stream(filepath, ok);
+}
+
+// No fsync without POSIX, but readers still never see a half-written file.
+bool FileUtils::writeFile(const std::string& path, std::string_view content, bool /*sync*/) {
+    const std::string filepath = write_target(path);
+    const std::string tmp = temp_path_for(filepath);
+    std::error_code ec;
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        out.close();
+        if (!out) {
+            fs::remove(tmp, ec);
+            return false;
+        }
+    }
+    auto existing = fs::status(filepath, ec);
+    if (!ec && fs::exists(existing)) fs::permissions(tmp, existing.permissions(), ec);
+    fs::rename(tmp, filepath, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
         return false;
     }
-    
-    file << content;
-    return file.good();
+    return true;
 }
 
 bool FileUtils::fileExists(const std::string& filepath) {
-    std::ifstream file(filepath);
-    return file.good();
+    std::error_code ec;
+    return fs::exists(filepath, ec);
+}
+
+#endif
+
+WriteStatus FileUtils::writeFileIfChanged(const std::string& filepath, std::string_view content) {
+    {
+        MappedFile existing(filepath);
+        if (existing.isOpen() && existing.view() == content) {
+            return WriteStatus::Unchanged;
+        }
+    }
+    return writeFile(filepath, content) ? WriteStatus::Written : WriteStatus::Failed;
 }
 
 std::string FileUtils::getDirectory(const std::string& filepath) {
@@ -1,13 +1,66 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 namespace picoforge {
 
+enum class WriteStatus {
+    Written,
+    Unchanged,  // existing file already held these bytes; left untouched (mtime kept)
+    Failed
+};
+
+// Read-only view of a whole file. Files of kMapThreshold bytes or more are
+// mmap'd on POSIX; smaller ones (and all files elsewhere) are read into an
+// owned buffer, which is cheaper than setting up a mapping. The view stays
+// valid for the object's lifetime.
+class MappedFile {
+public:
+    static constexpr size_t kMapThreshold = 64 * 1024;
+    // False on the portable (non-POSIX) file layer, where every file is buffered.
+    static bool canMap();
+
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filepath);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return open_; }
+    bool isMapped() const { return mapped_; }
+    std::string_view view() const { return {data_, size_}; }
+    size_t size() const { return size_; }
+
+private:
+    void release();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+    bool mapped_ = false;
+    std::string buffer_;
+};
+
 class FileUtils {
 public:
+    // Whole file in one read (empty string if it cannot be opened).
     static std::string readFile(const std::string& filepath);
-    static bool writeFile(const std::string& filepath, const std::string& content);
+    static MappedFile mapFile(const std::string& filepath) { return MappedFile(filepath); }
+
+    // Atomic replace: writes a temp file next to `filepath`, fsyncs it (unless
+    // `sync` is false), then renames it over the target. Readers see either the
+    // old or the new content, never a mix. An existing file's mode is kept, and
+    // a symlinked `filepath` has its target replaced. Without POSIX there is no
+    // fsync and `sync` is ignored.
+    static bool writeFile(const std::string& filepath, std::string_view content, bool sync = true);
+    // Skips the write when the file already holds exactly `content`.
+    static WriteStatus writeFileIfChanged(const std::string& filepath, std::string_view content);
+
     static bool fileExists(const std::string& filepath);
     static std::string getDirectory(const std::string& filepath);
     static std::string getFilename(const std::string& filepath);
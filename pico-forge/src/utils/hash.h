@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// 64-bit FNV-1a. Not cryptographic; used for content keys and change detection.
+class Hasher {
+public:
+    Hasher& add(std::string_view bytes) {
+        for (unsigned char c : bytes) {
+            state_ = (state_ ^ c) * kPrime;
+        }
+        return *this;
+    }
+
+    uint64_t value() const { return state_; }
+
+    std::string hex() const { return toHex(state_); }
+
+    static uint64_t hash(std::string_view bytes) { return Hasher().add(bytes).value(); }
+
+    static std::string toHex(uint64_t v) {
+        static const char* digits = "0123456789abcdef";
+        std::string out(16, '0');
+        for (int i = 15; i >= 0; --i) {
+            out[static_cast<size_t>(i)] = digits[v & 0xF];
+            v >>= 4;
+        }
+        return out;
+    }
+
+private:
+    static constexpr uint64_t kOffset = 14695981039346656037ULL;
+    static constexpr uint64_t kPrime = 1099511628211ULL;
+    uint64_t state_ = kOffset;
+};
+
+}  // namespace picoforge
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// Minimal streaming JSON builder. Commas are inserted automatically; callers are
+// responsible for balancing begin/end calls and pairing key() with a value.
+class JsonWriter {
+public:
+    JsonWriter& beginObject() { separate(); out_ += '{'; first_ = true; return *this; }
+    JsonWriter& endObject() { out_ += '}'; first_ = false; return *this; }
+    JsonWriter& beginArray() { separate(); out_ += '['; first_ = true; return *this; }
+    JsonWriter& endArray() { out_ += ']'; first_ = false; return *this; }
+
+    JsonWriter& key(std::string_view name) {
+        separate();
+        appendString(name);
+        out_ += ':';
+        afterKey_ = true;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view text) { separate(); appendString(text); return *this; }
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool b) { separate(); out_ += b ? "true" : "false"; return *this; }
+    JsonWriter& value(uint64_t n) { separate(); out_ += std::to_string(n); return *this; }
+    JsonWriter& value(int64_t n) { separate(); out_ += std::to_string(n); return *this; }
+    JsonWriter& value(int n) { return value(static_cast<int64_t>(n)); }
+    // Shortest round-trip form; NaN and infinities have no JSON spelling and become null.
+    JsonWriter& value(double d) {
+        if (!std::isfinite(d)) return null();
+        separate();
+        char buf[32];
+        auto result = std::to_chars(buf, buf + sizeof(buf), d);
+        out_.append(buf, result.ptr);
+        return *this;
+    }
+    JsonWriter& null() { separate(); out_ += "null"; return *this; }
+    // Splices already-encoded JSON (e.g. a value echoed back from a request).
+    JsonWriter& raw(std::string_view json) { separate(); out_ += json; return *this; }
+
+    const std::string& str() const { return out_; }
+    std::string take() { return std::move(out_); }
+
+private:
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+        } else if (!first_) {
+            out_ += ',';
+        }
+        first_ = false;
+    }
+
+    void appendString(std::string_view text) {
+        static const char* hex = "0123456789abcdef";
+        out_ += '"';
+        for (unsigned char c : text) {
+            switch (c) {
+                case '"': out_ += "\\\""; break;
+                case '\\': out_ += "\\\\"; break;
+                case '\n': out_ += "\\n"; break;
+                case '\r': out_ += "\\r"; break;
+                case '\t': out_ += "\\t"; break;
+                default:
+                    if (c < 0x20) {
+                        out_ += "\\u00";
+                        out_ += hex[c >> 4];
+                        out_ += hex[c & 0xF];
+                    } else {
+                        out_ += static_cast<char>(c);
+                    }
+            }
+        }
+        out_ += '"';
+    }
+
+    std::string out_;
+    bool first_ = true;
+    bool afterKey_ = false;
+};
+
+}  // namespace picoforge
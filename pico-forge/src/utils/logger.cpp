@@ -1,43 +1,213 @@
 #include "logger.h"
 
+#include <array>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 namespace picoforge {
 
-LogLevel Logger::currentLevel_ = LogLevel::Info;
+std::atomic<LogLevel> Logger::currentLevel_{LogLevel::Info};
 
-void Logger::setLevel(LogLevel level) {
-    currentLevel_ = level;
-}
+namespace {
+// Bounded multi-producer, single-consumer ring (per-slot sequence numbers).
+// Producers claim a slot with one CAS on tail_; the consumer owns head_.
+class LogRing {
+public:
+    static constexpr size_t kCapacity = 1024;
+
+    LogRing() {
+        for (size_t i = 0; i < kCapacity; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    bool tryPush(std::string& line) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & (kCapacity - 1)];
+            size_t seq = slot.seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.line = std::move(line);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(std::string& line) {
+        Slot& slot = slots_[head_ & (kCapacity - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        line = std::move(slot.line);
+        slot.line.clear();
+        slot.seq.store(head_ + kCapacity, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Number of records pushed so far.
+    size_t pushed() const { return tail_.load(std::memory_order_acquire); }
+
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> seq;
+        std::string line;
+    };
+
+    std::array<Slot, kCapacity> slots_;
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) size_t head_ = 0;
+};
+
+class Backend {
+public:
+    Backend() : thread_([this] { run(); }) {}
+
+    ~Backend() {
+        stop_.store(true, std::memory_order_seq_cst);
+        wake();
+        thread_.join();
+    }
+
+    void push(std::string line) {
+        while (!ring_.tryPush(line)) {
+            wake();
+            std::this_thread::yield();
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed)) wake();
+    }
+
+    void flush() {
+        size_t target = ring_.pushed();
+        while (written_.load(std::memory_order_acquire) < target) {
+            wake();
+            std::this_thread::yield();
+        }
+    }
+
+    void setOutput(std::ostream* out) {
+        flush();
+        out_.store(out ? out : &std::cerr, std::memory_order_release);
+    }
 
-void Logger::debug(const std::string& message) {
-    log(LogLevel::Debug, message);
+private:
+    void wake() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_.notify_one();
+    }
+
+    // Writes whatever is queued; true if anything was.
+    bool drain() {
+        std::ostream& out = *out_.load(std::memory_order_acquire);
+        std::string line;
+        size_t count = 0;
+        while (ring_.tryPop(line)) {
+            out << line;
+            ++count;
+        }
+        if (count == 0) return false;
+        out.flush();
+        written_.fetch_add(count, std::memory_order_release);
+        return true;
+    }
+
+    void run() {
+        for (;;) {
+            if (drain()) continue;
+            if (stop_.load(std::memory_order_seq_cst)) {
+                drain();
+                return;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleeping_.store(true, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!drainPending() && !stop_.load(std::memory_order_seq_cst)) {
+                cv_.wait_for(lock, std::chrono::milliseconds(100));
+            }
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    bool drainPending() const { return ring_.pushed() != written_.load(std::memory_order_relaxed); }
+
+    LogRing ring_;
+    std::atomic<size_t> written_{0};
+    std::atomic<std::ostream*> out_{&std::cerr};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stop_{false};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread thread_;  // last: started once everything above exists
+};
+
+Backend& backend() {
+    static Backend b;
+    return b;
 }
 
-void Logger::info(const std::string& message) {
-    log(LogLevel::Info, message);
+const char* level_prefix(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "[DEBUG] ";
+        case LogLevel::Info:    return "[INFO]  ";
+        case LogLevel::Warning: return "[WARN]  ";
+        case LogLevel::Error:   return "[ERROR] ";
+    }
+    return "";
 }
 
-void Logger::warning(const std::string& message) {
-    log(LogLevel::Warning, message);
+bool needs_quotes(std::string_view value) {
+    if (value.empty()) return true;
+    for (char c : value) {
+        if (c == ' ' || c == '=' || c == '"' || c == '\n' || c == '\t') return true;
+    }
+    return false;
 }
 
-void Logger::error(const std::string& message) {
-    log(LogLevel::Error, message);
+void append_value(std::string& line, std::string_view value) {
+    if (!needs_quotes(value)) {
+        line += value;
+        return;
+    }
+    line += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') line += '\\';
+        if (c == '\n') {
+            line += "\\n";
+            continue;
+        }
+        line += c;
+    }
+    line += '"';
 }
+}  // namespace
 
-void Logger::log(LogLevel level, const std::string& message) {
-    if (level < currentLevel_) return;
-    
-    const char* prefix = "";
-    switch (level) {
-        case LogLevel::Debug:   prefix = "[DEBUG] "; break;
-        case LogLevel::Info:    prefix = "[INFO]  "; break;
-        case LogLevel::Warning: prefix = "[WARN]  "; break;
-        case LogLevel::Error:   prefix = "[ERROR] "; break;
+void Logger::write(LogLevel level, std::string_view message, std::initializer_list<LogField> fields) {
+    std::string line = level_prefix(level);
+    line += message;
+    for (const auto& field : fields) {
+        line += ' ';
+        line += field.key();
+        line += '=';
+        append_value(line, field.value());
     }
-    
-    std::cerr << prefix << message << "\n";
+    line += '\n';
+    backend().push(std::move(line));
+}
+
+void Logger::flush() {
+    backend().flush();
+}
+
+void Logger::setOutput(std::ostream* out) {
+    backend().setOutput(out);
 }
 
 }  // namespace picoforge
@@ -1,6 +1,24 @@
 #pragma once
 
+#include <atomic>
+#include <charconv>
+#include <cstddef>
+#include <initializer_list>
+#include <iosfwd>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Levels below this are compiled out (0 debug .. 3 error). Release builds
+// (NDEBUG) drop debug logging unless the build says otherwise.
+#ifndef PICOFORGE_MIN_LOG_LEVEL
+#ifdef NDEBUG
+#define PICOFORGE_MIN_LOG_LEVEL 1
+#else
+#define PICOFORGE_MIN_LOG_LEVEL 0
+#endif
+#endif
 
 namespace picoforge {
 
@@ -11,17 +29,84 @@ enum class LogLevel {
     Error
 };
 
+// One structured key=value pair. Numbers are formatted into the field itself
+// and strings are viewed, so building fields does not allocate.
+class LogField {
+public:
+    LogField(std::string_view key, std::string_view value) : key_(key), data_(value.data()), size_(value.size()) {}
+    LogField(std::string_view key, const char* value) : LogField(key, std::string_view(value)) {}
+    LogField(std::string_view key, const std::string& value) : LogField(key, std::string_view(value)) {}
+    LogField(std::string_view key, bool value) : LogField(key, std::string_view(value ? "true" : "false")) {}
+
+    template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    LogField(std::string_view key, T value) : key_(key) {
+        size_ = static_cast<size_t>(std::to_chars(buffer_, buffer_ + sizeof(buffer_), value).ptr - buffer_);
+    }
+
+    std::string_view key() const { return key_; }
+    std::string_view value() const { return data_ ? std::string_view(data_, size_) : std::string_view(buffer_, size_); }
+
+private:
+    std::string_view key_;
+    const char* data_ = nullptr;  // null: value lives in buffer_
+    size_t size_ = 0;
+    char buffer_[24];
+};
+
+// Records are formatted on the calling thread and pushed onto a lock-free
+// MPSC ring; a background thread writes them out, so logging from pool workers
+// never serialises on the output stream. Pending records are written at exit
+// or by flush(). When the ring is full the caller waits for space rather than
+// dropping records.
+//
+// A message is a string or a callable returning one; the callable only runs
+// when the level is enabled.
 class Logger {
 public:
-    static void setLevel(LogLevel level);
-    static void debug(const std::string& message);
-    static void info(const std::string& message);
-    static void warning(const std::string& message);
-    static void error(const std::string& message);
+    static constexpr LogLevel kMinLevel = static_cast<LogLevel>(PICOFORGE_MIN_LOG_LEVEL);
+
+    static void setLevel(LogLevel level) { currentLevel_.store(level, std::memory_order_relaxed); }
+    static LogLevel level() { return currentLevel_.load(std::memory_order_relaxed); }
+    static bool enabled(LogLevel level) { return level >= kMinLevel && level >= Logger::level(); }
+
+    template <typename Message>
+    static void debug(Message&& message, std::initializer_list<LogField> fields = {}) {
+        log<LogLevel::Debug>(std::forward<Message>(message), fields);
+    }
+    template <typename Message>
+    static void info(Message&& message, std::initializer_list<LogField> fields = {}) {
+        log<LogLevel::Info>(std::forward<Message>(message), fields);
+    }
+    template <typename Message>
+    static void warning(Message&& message, std::initializer_list<LogField> fields = {}) {
+        log<LogLevel::Warning>(std::forward<Message>(message), fields);
+    }
+    template <typename Message>
+    static void error(Message&& message, std::initializer_list<LogField> fields = {}) {
+        log<LogLevel::Error>(std::forward<Message>(message), fields);
+    }
+
+    // Blocks until everything logged before the call has been written.
+    static void flush();
+    // Destination for records (std::cerr when null). Flushes first.
+    static void setOutput(std::ostream* out);
 
 private:
-    static LogLevel currentLevel_;
-    static void log(LogLevel level, const std::string& message);
+    template <LogLevel L, typename Message>
+    static void log(Message&& message, std::initializer_list<LogField> fields) {
+        if constexpr (L >= kMinLevel) {
+            if (L < level()) return;
+            if constexpr (std::is_invocable_v<Message&>) {
+                write(L, message(), fields);
+            } else {
+                write(L, std::string_view(message), fields);
+            }
+        }
+    }
+
+    static void write(LogLevel level, std::string_view message, std::initializer_list<LogField> fields);
+
+    static std::atomic<LogLevel> currentLevel_;
 };
 
 }  // namespace picoforge
@@ -0,0 +1,119 @@
+#include "profiler.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "file_utils.h"
+#include "json_writer.h"
+
+namespace picoforge {
+
+std::atomic<bool> Profiler::enabled_{false};
+
+namespace {
+struct Event {
+    const char* name;
+    std::string detail;
+    uint64_t startNs;
+    uint64_t durationNs;
+};
+
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::mutex mutex;  // uncontended except while a trace is being exported
+    std::vector<Event> events;
+};
+
+// Buffers are owned here rather than by their threads so events from pool
+// workers that have already exited still make it into the trace.
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+ThreadBuffer& thread_buffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = r.buffers.back().get();
+        buffer->tid = static_cast<uint32_t>(r.buffers.size());
+    }
+    return *buffer;
+}
+}  // namespace
+
+uint64_t Profiler::now() {
+    auto elapsed = std::chrono::steady_clock::now() - registry().epoch;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void Profiler::record(const char* name, std::string detail, uint64_t startNs, uint64_t endNs) {
+    auto& buffer = thread_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back(Event{name, std::move(detail), startNs, endNs - startNs});
+}
+
+std::string Profiler::chromeTrace() {
+    JsonWriter w;
+    w.beginObject().key("displayTimeUnit").value("ms").key("traceEvents").beginArray();
+
+    auto& r = registry();
+    std::lock_guard<std::mutex> registryLock(r.mutex);
+    for (const auto& buffer : r.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for (const auto& e : buffer->events) {
+            // Complete ("X") events; timestamps are microseconds.
+            w.beginObject()
+             .key("name").value(e.name)
+             .key("cat").value("picoforge")
+             .key("ph").value("X")
+             .key("ts").value(static_cast<double>(e.startNs) / 1000.0)
+             .key("dur").value(static_cast<double>(e.durationNs) / 1000.0)
+             .key("pid").value(1)
+             .key("tid").value(static_cast<int>(buffer->tid));
+            if (!e.detail.empty()) {
+                w.key("args").beginObject().key("detail").value(e.detail).endObject();
+            }
+            w.endObject();
+        }
+    }
+
+    w.endArray().endObject();
+    return w.take();
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    return FileUtils::writeFile(path, chromeTrace() + "\n", false);
+}
+
+size_t Profiler::eventCount() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> registryLock(r.mutex);
+    size_t count = 0;
+    for (const auto& buffer : r.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+void Profiler::reset() {
+    auto& r = registry();
+    std::lock_guard<std::mutex> registryLock(r.mutex);
+    for (const auto& buffer : r.buffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+}  // namespace picoforge
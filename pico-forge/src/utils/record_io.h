@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdlib>
+#include <string>
+
+namespace picoforge {
+
+// Length-prefixed text records used by on-disk state files:
+//   <name> <byte-count>\n<bytes>\n
+// Values may contain anything, including newlines.
+inline void appendRecord(std::string& out, const char* name, const std::string& value) {
+    out += name;
+    out += ' ';
+    out += std::to_string(value.size());
+    out += '\n';
+    out += value;
+    out += '\n';
+}
+
+inline bool readRecord(const std::string& in, size_t& pos, const char* name, std::string& value) {
+    std::string prefix = std::string(name) + " ";
+    if (in.compare(pos, prefix.size(), prefix) != 0) return false;
+    pos += prefix.size();
+
+    size_t eol = in.find('\n', pos);
+    if (eol == std::string::npos) return false;
+    char* end = nullptr;
+    size_t len = std::strtoull(in.c_str() + pos, &end, 10);
+    if (end != in.c_str() + eol) return false;
+    pos = eol + 1;
+    if (pos + len + 1 > in.size()) return false;
+    value.assign(in, pos, len);
+    pos += len + 1;
+    return true;
+}
+
+}  // namespace picoforge
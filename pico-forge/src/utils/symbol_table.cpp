@@ -0,0 +1,79 @@
+#include "symbol_table.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace picoforge {
+
+namespace {
+// Strings live in fixed-size chunks that never move, so str() can index them
+// without a lock and the lookup map can key on views of them.
+constexpr size_t kChunkBits = 12;
+constexpr size_t kChunkSize = size_t{1} << kChunkBits;
+constexpr size_t kMaxChunks = 1024;
+
+struct Table {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string_view, uint32_t> handles;
+    std::array<std::atomic<std::string*>, kMaxChunks> chunks{};
+    std::vector<std::unique_ptr<std::string[]>> owned;
+    uint32_t count = 0;
+};
+
+Table& table() {
+    static Table t;
+    return t;
+}
+}  // namespace
+
+Symbol::Symbol(std::string_view text) : Symbol(SymbolTable::intern(text)) {}
+
+const std::string& Symbol::str() const {
+    static const std::string empty;
+    if (handle_ == 0) return empty;
+    size_t index = handle_ - 1;
+    return table().chunks[index >> kChunkBits].load(std::memory_order_acquire)[index & (kChunkSize - 1)];
+}
+
+Symbol SymbolTable::find(std::string_view text) {
+    auto& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.handles.find(text);
+    return it == t.handles.end() ? Symbol() : Symbol(it->second);
+}
+
+Symbol SymbolTable::intern(std::string_view text) {
+    if (Symbol existing = find(text); existing.valid()) return existing;
+
+    auto& t = table();
+    std::unique_lock<std::shared_mutex> lock(t.mutex);
+    auto it = t.handles.find(text);
+    if (it != t.handles.end()) return Symbol(it->second);
+
+    size_t index = t.count;
+    if (index >= kChunkSize * kMaxChunks) throw std::runtime_error("symbol table full");
+    size_t chunk = index >> kChunkBits;
+    if (index % kChunkSize == 0) {
+        t.owned.push_back(std::make_unique<std::string[]>(kChunkSize));
+        t.chunks[chunk].store(t.owned.back().get(), std::memory_order_release);
+    }
+    std::string& slot = t.chunks[chunk].load(std::memory_order_relaxed)[index & (kChunkSize - 1)];
+    slot.assign(text);
+    uint32_t handle = ++t.count;
+    t.handles.emplace(slot, handle);
+    return Symbol(handle);
+}
+
+size_t SymbolTable::size() {
+    auto& t = table();
+    std::shared_lock<std::shared_mutex> lock(t.mutex);
+    return t.count;
+}
+
+}  // namespace picoforge
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace picoforge {
+
+// Handle to a string interned in the process-wide SymbolTable. Equal strings
+// get equal handles, so comparing, hashing and de-duplicating symbols never
+// touches the characters. operator< orders by handle (interning order), not
+// alphabetically; sort by str() where output order matters.
+class Symbol {
+public:
+    Symbol() = default;
+    explicit Symbol(std::string_view text);  // interns
+
+    // Interned text; the reference stays valid for the life of the process.
+    const std::string& str() const;
+    uint32_t handle() const { return handle_; }
+    bool valid() const { return handle_ != 0; }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.handle_ == b.handle_; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.handle_ != b.handle_; }
+    friend bool operator<(Symbol a, Symbol b) { return a.handle_ < b.handle_; }
+
+private:
+    friend class SymbolTable;
+    explicit Symbol(uint32_t handle) : handle_(handle) {}
+
+    uint32_t handle_ = 0;  // 0: no symbol (empty str())
+};
+
+// Interning takes a shared lock (exclusive only to add a new string);
+// Symbol::str() is lock-free. Strings are never removed, so only intern names
+// from a bounded set (type and header names), never request data.
+class SymbolTable {
+public:
+    static Symbol intern(std::string_view text);
+    // Existing symbol for `text`, or an invalid one; never adds to the table.
+    static Symbol find(std::string_view text);
+    static size_t size();
+};
+
+}  // namespace picoforge
+
+namespace std {
+template <>
+struct hash<picoforge::Symbol> {
+    size_t operator()(picoforge::Symbol s) const noexcept { return s.handle(); }
+};
+}  // namespace std
@@ -0,0 +1,19 @@
+// avg: 5-tap moving average per input, 10000 Hz. Outputs ramp up over the first 5 frames.
+typedef struct {
+    uint16_t history[2][5];
+    uint32_t sum[2];
+    uint32_t pos;  // history column the next frame replaces
+} avg_filter_t;
+
+static uint32_t avg_filter_block(avg_filter_t* f, const uint16_t* in, uint32_t n, uint16_t* out) {
+    for (uint32_t i = 0; i < n; i += 2) {
+        for (uint32_t s = 0; s < 2; ++s) {
+            f->sum[s] += (uint32_t)in[i + s] - f->history[s][f->pos];
+            f->history[s][f->pos] = in[i + s];
+            out[i + s] = (uint16_t)(((uint64_t)f->sum[s] * 3435973837u + 8589934592ull) >> 34);
+        }
+        if (++f->pos == 5) f->pos = 0;
+    }
+    return n;
+}
+
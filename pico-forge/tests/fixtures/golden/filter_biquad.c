@@ -0,0 +1,30 @@
+// lpf: 2nd-order Butterworth low-pass per input, 48000 Hz. Q28 taps, Q16 state.
+static const int32_t lpf_filter_b[3] = {1051227, 2102455, 1051227};
+static const int32_t lpf_filter_a[2] = {-487301911, 223071364};
+
+typedef struct {
+    int32_t x1[1];
+    int32_t x2[1];
+    int32_t y1[1];
+    int32_t y2[1];
+} lpf_filter_t;
+
+static uint32_t lpf_filter_block(lpf_filter_t* f, const uint16_t* in, uint32_t n, uint16_t* out) {
+    for (uint32_t i = 0; i < n; i += 1) {
+        for (uint32_t s = 0; s < 1; ++s) {
+            int32_t x = (int32_t)in[i + s] << 16;
+            int64_t acc = (int64_t)lpf_filter_b[0] * x + (int64_t)lpf_filter_b[1] * f->x1[s]
+                        + (int64_t)lpf_filter_b[2] * f->x2[s] - (int64_t)lpf_filter_a[0] * f->y1[s]
+                        - (int64_t)lpf_filter_a[1] * f->y2[s];
+            int32_t y = (int32_t)(acc >> 28);
+            int32_t r = (y + 32768) >> 16;
+            f->x2[s] = f->x1[s];
+            f->x1[s] = x;
+            f->y2[s] = f->y1[s];
+            f->y1[s] = y;
+            out[i + s] = (uint16_t)(r < 0 ? 0 : r > 65535 ? 65535 : r);
+        }
+    }
+    return n;
+}
+
@@ -0,0 +1,29 @@
+// cic: 3-stage CIC decimator per input, R = 16 (100000 Hz -> 6250 Hz).
+typedef struct {
+    uint32_t integrator[1][3];  // wraps mod 2^32; the combs undo it
+    uint32_t comb[1][3];        // previous input of each comb
+    uint32_t phase;  // frames since the last output
+} cic_filter_t;
+
+static uint32_t cic_filter_block(cic_filter_t* f, const uint16_t* in, uint32_t n, uint16_t* out) {
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < n; i += 1) {
+        for (uint32_t s = 0; s < 1; ++s) {
+            uint32_t acc = in[i + s];
+            for (uint32_t k = 0; k < 3; ++k) acc = f->integrator[s][k] += acc;
+        }
+        if (++f->phase < 16) continue;
+        f->phase = 0;
+        for (uint32_t s = 0; s < 1; ++s) {
+            uint32_t acc = f->integrator[s][2];
+            for (uint32_t k = 0; k < 3; ++k) {
+                uint32_t prev = f->comb[s][k];
+                f->comb[s][k] = acc;
+                acc -= prev;
+            }
+            out[written++] = (uint16_t)((acc + 2048u) >> 12);
+        }
+    }
+    return written;
+}
+
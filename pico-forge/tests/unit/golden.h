@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#ifndef FIXTURES_PATH
+#define FIXTURES_PATH "tests/fixtures"
+#endif
+
+// Compares generated text against tests/fixtures/golden/<name>. With
+// PICOFORGE_UPDATE_GOLDEN set, rewrites the file instead.
+inline void checkGolden(const std::string& name, const std::string& actual) {
+    std::string path = std::string(FIXTURES_PATH) + "/golden/" + name;
+    if (std::getenv("PICOFORGE_UPDATE_GOLDEN")) {
+        std::ofstream(path, std::ios::binary) << actual;
+        return;
+    }
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream expected;
+    expected << in.rdbuf();
+    if (expected.str() != actual) {
+        std::cerr << "golden mismatch: " << path << "\n--- actual ---\n" << actual;
+    }
+    assert(expected.str() == actual);
+}
+
+// Headers, file-scope definitions and init code of one module, in one text.
+template <typename Module>
+std::string renderModule(const Module& m) {
+    return "// headers\n" + m.generateHeaderCode() + "// definitions\n" + m.generateDefinitionsCode() +
+           "// init\n" + m.generateInitCode();
+}
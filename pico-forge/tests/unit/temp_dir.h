@@ -0,0 +1,18 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <random>
+#include <string>
+
+// Empty directory under the system temp dir, unique per call so parallel test
+// runs never share one. Callers remove it when done.
+inline std::filesystem::path freshTempDir(const std::string& name) {
+    static std::atomic<unsigned> counter{0};
+    static const unsigned run = std::random_device{}();
+    auto dir = std::filesystem::temp_directory_path() /
+               (name + "_" + std::to_string(run) + "_" + std::to_string(counter++));
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    return dir;
+}
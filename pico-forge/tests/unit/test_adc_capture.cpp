@@ -0,0 +1,92 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/config/config_validator.h"
+#include "../../src/core/resource_allocator.h"
+#include "../../src/modules/adc_module.h"
+#include "golden.h"
+
+using namespace picoforge;
+
+void testAdcCaptureGolden() {
+    auto project = ConfigParser::parseProjectString(R"({
+        "name": "scope",
+        "adc": [ { "mode": "capture", "inputs": [2, 0, 4], "sample_rate": 100000, "block_samples": 768,
+                   "dma_channel": 6, "chain_channel": 7 } ]
+    })");
+    const auto& adc = static_cast<const AdcModule&>(*project.modules[0]);
+    assert(adc.validate());
+    assert((adc.captureInputs() == std::vector<int>{0, 2, 4}));
+    checkGolden("adc_capture.txt", renderModule(adc));
+    std::cout << "✓ ADC round-robin capture matches golden output\n";
+}
+
+void testAdcCaptureValidationAndAllocation() {
+    auto capture = [](AdcCapture c) {
+        c.enabled = true;
+        AdcConfig cfg;
+        cfg.pin = 27;
+        cfg.capture = std::move(c);
+        return AdcModule(cfg);
+    };
+    AdcCapture ok;
+    ok.sample_rate_hz = 500000;
+    assert(capture(ok).validate());  // pin 27 alone at the full rate
+    assert(capture(ok).generateInitCode().find("adc_set_clkdiv(95.0f);  // 500000 conversions/s") != std::string::npos);
+
+    AdcCapture tooFast = ok;
+    tooFast.inputs = {0, 1};  // 2 x 500 ksps
+    assert(!capture(tooFast).validate());
+    AdcCapture tooSlow = ok;
+    tooSlow.sample_rate_hz = 500;  // divider beyond 16 integer bits
+    assert(!capture(tooSlow).validate());
+    AdcCapture ragged = ok;
+    ragged.inputs = {0, 1, 3};
+    ragged.sample_rate_hz = 1000;
+    ragged.block_samples = 512;  // not a multiple of 3 inputs
+    assert(!capture(ragged).validate());
+    AdcCapture badInput = ok;
+    badInput.inputs = {5};
+    assert(!capture(badInput).validate());
+
+    // Capture inputs claim their GPIOs, and the allocator fixes both DMA channels.
+    AdcCapture pins = ok;
+    pins.inputs = {0, 1};
+    pins.sample_rate_hz = 1000;
+    ModuleList modules{std::make_shared<AdcModule>(capture(pins))};
+    auto project = ConfigParser::parseProjectString(R"({ "gpio": [ { "pin": 27 } ], "dma": [ { "channel": 0 } ] })");
+    modules.insert(modules.end(), project.modules.begin(), project.modules.end());
+    auto report = ConfigValidator::validateAll(modules);
+    assert(!report.ok() && report.diagnostics.size() == 1 && report.diagnostics[0].index == 27);
+
+    modules.erase(modules.begin() + 1);
+    auto allocated = ResourceAllocator::allocate(modules);
+    assert(allocated.ok());
+    [[maybe_unused]] const auto& cfg = static_cast<const AdcModule&>(*allocated.modules[0]).config().capture;
+    assert(cfg.dma_channel == 1 && cfg.chain_channel == 2);
+    std::cout << "✓ ADC capture rate limits, block shape and channel allocation\n";
+}
+
+void testAdcCaptureOwnsConverter() {
+    [[maybe_unused]] auto conflicts = [](const char* json) {
+        auto report = ConfigValidator::validateAll(ConfigParser::parseProjectString(json).modules);
+        size_t found = 0;
+        for (const auto& d : report.diagnostics) {
+            if (d.kind == ResourceDiagnostic::Kind::Conflict && d.resource == ResourceKind::Adc) ++found;
+        }
+        return found;
+    };
+    // One converter: a second capture, or a polled read that re-selects its
+    // input mid round-robin, cannot share it with a capture.
+    assert(conflicts(R"({ "adc": [ { "mode": "capture", "inputs": [0], "sample_rate": 1000 },
+                                   { "mode": "capture", "inputs": [1], "sample_rate": 1000 } ] })") == 1);
+    assert(conflicts(R"({ "adc": [ { "mode": "capture", "inputs": [0], "sample_rate": 1000 },
+                                   { "pin": 28 } ] })") == 1);
+    assert(conflicts(R"({ "adc": [ { "pin": 28 }, { "mode": "capture", "inputs": [0], "sample_rate": 1000 } ] })") == 1);
+    // Polled reads take turns.
+    auto polled = ConfigParser::parseProjectString(R"({ "adc": [ { "pin": 26 }, { "pin": 27 }, { "temperature": true } ] })");
+    assert(ConfigValidator::validateAll(polled.modules).ok());
+    std::cout << "✓ ADC capture holds the converter against other ADC modules\n";
+}
@@ -0,0 +1,109 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/generators/filter_generator.h"
+#include "../../src/modules/adc_module.h"
+#include "golden.h"
+
+using namespace picoforge;
+
+namespace {
+std::string kernel(const std::string& prefix, const FilterDesign& d) {
+    CodeWriter out;
+    FilterGenerator::emitKernel(prefix, d, out);
+    return out.take();
+}
+
+FilterSpec spec(const char* type, int bandwidth = 0) {
+    FilterSpec s;
+    s.type = type;
+    s.bandwidth_hz = bandwidth;
+    return s;
+}
+}  // namespace
+
+// The kernels below are compiled and run as C by test_filter_kernels.c.
+void testFilterKernelGoldens() {
+    FilterSpec avg = spec("average");
+    avg.length = 5;
+    auto average = FilterGenerator::design(avg, 10000, 2);
+    assert(average && average->length == 5);
+    checkGolden("filter_average.c", kernel("avg", *average));
+
+    FilterSpec c = spec("cic");
+    c.decimation = 16;
+    auto cic = FilterGenerator::design(c, 100000);
+    assert(cic && cic->order == 3 && cic->outputRateHz() == 6250);
+    checkGolden("filter_cic.c", kernel("cic", *cic));
+
+    auto lpf = FilterGenerator::design(spec("biquad", 1000), 48000);
+    assert(lpf);
+    checkGolden("filter_biquad.c", kernel("lpf", *lpf));
+    std::cout << "✓ Average, CIC and biquad kernels match golden output\n";
+}
+
+void testFilterDesignMath() {
+    // Constant division: powers of two shift, the rest multiply; both round to nearest.
+    [[maybe_unused]] auto five = FilterGenerator::reciprocal(5);
+    assert(five.multiplier != 1 && five.shift == 34);
+    for ([[maybe_unused]] uint64_t x : {0ull, 2ull, 3ull, 12ull, 13ull, 20475ull}) {
+        assert(((x * five.multiplier + (1ull << (five.shift - 1))) >> five.shift) == (x * 2 + 5) / 10);
+    }
+    assert(FilterGenerator::reciprocal(4096).multiplier == 1 && FilterGenerator::reciprocal(4096).shift == 12);
+    assert(FilterGenerator::scaled("sum", FilterGenerator::reciprocal(8)) == "(uint16_t)((sum + 4u) >> 3)");
+
+    // Derived from bandwidth: boxcar taps at 0.443 fs / bw, CIC output rate 4x bw.
+    assert(FilterGenerator::design(spec("average", 443), 100000)->length == 100);
+    [[maybe_unused]] auto cic = FilterGenerator::design(spec("cic", 1000), 64000);
+    assert(cic->decimation == 16 && cic->gain.shift == 12 && cic->gain.multiplier == 1);
+    assert(FilterGenerator::maxOutput(*cic, 40) == 3);  // a partial period may finish in any block
+
+    // Biquad taps sum to unity DC gain exactly, and the poles sit inside the unit circle.
+    [[maybe_unused]] auto lpf = FilterGenerator::design(spec("biquad", 1000), 48000);
+    [[maybe_unused]] const int64_t one = int64_t{1} << FilterDesign::kBiquadShift;
+    assert(int64_t{lpf->b[0]} + lpf->b[1] + lpf->b[2] == one + lpf->a[0] + lpf->a[1]);
+    assert(lpf->a[1] > 0 && lpf->a[1] < one && std::abs(lpf->a[0]) < one + lpf->a[1]);
+
+    assert(!FilterGenerator::design(spec("biquad", 24000), 48000));  // at Nyquist
+    assert(!FilterGenerator::design(spec("biquad", 1), 1000000));    // taps round to zero
+    assert(!FilterGenerator::design(spec("cic", 1), 500000));       // R^3 * 4096 past 32 bits
+    assert(!FilterGenerator::design(spec("median", 100), 1000));
+    std::cout << "✓ Filter lengths, decimation, gain shifts and biquad taps\n";
+}
+
+void testAdcFilterHooks() {
+    auto project = ConfigParser::parseProjectString(R"({
+        "adc": [ { "mode": "capture", "inputs": [0, 1], "sample_rate": 8000, "block_samples": 256,
+                   "filter": "cic", "bandwidth_hz": 250, "filter_order": 2 },
+                 { "pin": 28, "samples": 12 } ]
+    })");
+    const auto& capture = static_cast<const AdcModule&>(*project.modules[0]);
+    assert(capture.validate());
+    [[maybe_unused]] auto design = capture.captureFilter();
+    assert(design && design->slots == 2 && design->decimation == 8 && design->order == 2);
+    std::string defs = capture.generateDefinitionsCode();
+    assert(defs.find("static adc_capture_filter_t adc_capture_filter_state;") != std::string::npos);
+    assert(defs.find("static const uint adc_capture_filtered_max = 32;") != std::string::npos);
+    assert(defs.find("static inline uint32_t adc_capture_poll_filtered(uint16_t* out) {") != std::string::npos);
+
+    // `samples` on a polled input averages inside the generated read helper.
+    const auto& polled = static_cast<const AdcModule&>(*project.modules[1]);
+    std::string helper = polled.generateDefinitionsCode();
+    assert(helper.find("static inline uint16_t adc_28_sample(void) {") != std::string::npos);
+    assert(helper.find("for (int i = 0; i < 12; ++i) sum += adc_read();") != std::string::npos);
+    assert(polled.generateInitCode().find("read helper") == std::string::npos);
+
+    // `samples` in capture mode is a moving average; an unmeetable filter fails validation.
+    AdcConfig cfg;
+    cfg.pin = 26;
+    cfg.samples = 4;
+    cfg.capture.enabled = true;
+    cfg.capture.sample_rate_hz = 1000;
+    assert(AdcModule(cfg).captureFilter()->kind == FilterKind::MovingAverage);
+    cfg.capture.filter = spec("biquad", 600);
+    assert(!AdcModule(cfg).validate());
+    std::cout << "✓ ADC capture filters and averaged polled reads\n";
+}
@@ -0,0 +1,95 @@
+#include <atomic>
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../../src/core/batch_runner.h"
+#include "../../src/core/thread_pool.h"
+#include "../../src/utils/file_utils.h"
+#include "temp_dir.h"
+
+using namespace picoforge;
+
+void testThreadPoolRunsAllTasks() {
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&pool, &count]() {
+            // Nested submissions land on the worker's own queue.
+            pool.submit([&count]() { count.fetch_add(1); });
+            count.fetch_add(1);
+        });
+    }
+    pool.waitIdle();
+    assert(count.load() == 2000);
+
+    std::cout << "✓ Thread pool runs all tasks\n";
+}
+
+void testBatchManifestParsing() {
+    auto entries = BatchRunner::parseManifest(
+        "# board variants\n"
+        "\n"
+        "boards/a/forge.json\n"
+        "  boards/b/forge.json   out/b  \n"
+        "/abs/c.json /abs/out\n",
+        "/manifests");
+
+    assert(entries.size() == 3);
+    assert(entries[0].configPath == "/manifests/boards/a/forge.json");
+    assert(entries[0].outputDir == "/manifests/boards/a/forge");
+    assert(entries[0].line == 3);
+    assert(entries[1].outputDir == "/manifests/out/b");
+    assert(entries[2].configPath == "/abs/c.json");
+    assert(entries[2].outputDir == "/abs/out");
+
+    // Two configs in one directory no longer write the same main.cpp.
+    auto siblings = BatchRunner::parseManifest("a/x.json\na/y.json\n", "/m");
+    assert(siblings[0].outputDir == "/m/a/x" && siblings[1].outputDir == "/m/a/y");
+    std::string error;
+    try {
+        BatchRunner::parseManifest("a/x.json out\n# same target\nb/y.json ./out/\n", "/m");
+    } catch (const std::runtime_error& e) {
+        error = e.what();
+    }
+    assert(error == "manifest line 3: output directory /m/out/ is already used by line 1");
+
+    std::cout << "✓ Batch manifest parsing\n";
+}
+
+void testBatchRunOrderAndErrors() {
+    auto tmp = freshTempDir("picoforge_batch_test");
+
+    std::string fixtures = FIXTURES_PATH;
+    std::vector<BatchEntry> entries;
+    for (int i = 0; i < 8; ++i) {
+        BatchEntry e;
+        e.configPath = fixtures + (i % 2 ? "/sample_forge_comms.json" : "/sample_forge_basic.json");
+        e.outputDir = (tmp / ("p" + std::to_string(i))).string();
+        e.line = static_cast<size_t>(i + 1);
+        entries.push_back(e);
+    }
+    entries[5].configPath = fixtures + "/missing.json";
+
+    ThreadPool pool(3);
+    auto results = BatchRunner::run(entries, pool);
+
+    assert(results.size() == entries.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        assert(results[i].entry.outputDir == entries[i].outputDir);
+        assert(results[i].ok == (i != 5));
+    }
+    assert(results[5].error.find("missing.json") != std::string::npos);
+    assert(results[0].projectName == "sample_project");
+    assert(FileUtils::readFile(entries[0].outputDir + "/main.cpp").find("gpio_init(15)") != std::string::npos);
+    assert(FileUtils::readFile(entries[1].outputDir + "/CMakeLists.txt").find("project(sample_uart_i2c_spi") != std::string::npos);
+
+    std::ostringstream report;
+    assert(BatchRunner::report(results, report) == 1);
+    assert(report.str().find("7/8 projects generated") != std::string::npos);
+
+    std::filesystem::remove_all(tmp);
+    std::cout << "✓ Batch run keeps manifest order and per-entry errors\n";
+}
@@ -4,6 +4,8 @@
 
 #include "../../src/generators/cmake_generator.h"
 #include "../../src/modules/gpio_module.h"
+#include "../../src/modules/multicore_module.h"
+#include "../../src/modules/pio_module.h"
 #include "../../src/modules/uart_module.h"
 
 using namespace picoforge;
@@ -23,3 +25,97 @@ void testCMakeGenerator() {
     
     std::cout << "✓ CMake Generator test passed\n";
 }
+
+void testCMakeLibrariesAndPrecompiledHeaders() {
+    ModuleList modules;
+    modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "none"}));
+    modules.push_back(std::make_shared<PioModule>(PioConfig{"leds", "ws2812", 1, 22}));
+    modules.push_back(std::make_shared<MulticoreModule>(MulticoreConfig{true, "core1_main"}));
+
+    auto plain = CMakeGenerator::generate("pch_project", modules);
+    // hardware_pio links hardware_gpio itself; multicore needs its own library.
+    assert(plain.find("    hardware_pio\n    pico_multicore\n)") != std::string::npos);
+    assert(plain.find("hardware_gpio\n") == std::string::npos);
+    assert(plain.find("target_precompile_headers") == std::string::npos);
+
+    CMakeOptions options;
+    options.precompileHeaders = true;
+    auto cmake = CMakeGenerator::generate("pch_project", modules, options);
+    [[maybe_unused]] auto pch = cmake.find("target_precompile_headers(pch_project PRIVATE");
+    assert(pch != std::string::npos);
+    assert(cmake.find("\"$<$<COMPILE_LANGUAGE:CXX>:<pico/stdlib.h$<ANGLE-R>>\"", pch) != std::string::npos);
+    assert(cmake.find("<hardware/gpio.h$<ANGLE-R>>", pch) != std::string::npos);
+    assert(cmake.find("<pico/multicore.h$<ANGLE-R>>", pch) != std::string::npos);
+    assert(pch < cmake.find("pico_add_extra_outputs"));
+    assert(options.key() != CMakeOptions().key());
+
+    std::cout << "✓ CMake libraries and precompiled headers come from the dependency graph\n";
+}
+
+void testCMakeBuildSpeedOptions() {
+    ModuleList modules;
+    modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "none"}));
+
+    auto plain = CMakeGenerator::generate("fast", modules);
+    assert(plain.find("COMPILER_LAUNCHER") == std::string::npos);
+    assert(plain.find("UNITY_BUILD") == std::string::npos);
+
+    CMakeOptions options;
+    options.generator = "Ninja";
+    options.compilerLauncher = "ccache";
+    options.unityBuild = true;
+    auto cmake = CMakeGenerator::generate("fast", modules, options);
+    // Launchers must be set before project() enables the languages.
+    assert(cmake.find("find_program(PICOFORGE_COMPILER_LAUNCHER \"ccache\")") < cmake.find("project(fast"));
+    assert(cmake.find("set(CMAKE_CXX_COMPILER_LAUNCHER ${PICOFORGE_COMPILER_LAUNCHER})") != std::string::npos);
+    assert(cmake.find("UNITY_BUILD ON") != std::string::npos);
+    assert(cmake.find("UNITY_BUILD_BATCH_SIZE 16") != std::string::npos);
+    assert(cmake.find("PROPERTIES SKIP_UNITY_BUILD_INCLUSION ON") < cmake.find("UNITY_BUILD ON"));
+
+    options.compilerLauncher = "/opt/my tools/ccache";
+    assert(CMakeGenerator::generate("fast", modules, options)
+               .find("find_program(PICOFORGE_COMPILER_LAUNCHER \"/opt/my tools/ccache\")") != std::string::npos);
+
+    assert(options.wantsPresets());
+    auto presets = CMakeGenerator::presets("fast", options);
+    assert(presets.find("\"generator\": \"Ninja\"") != std::string::npos);
+    assert(presets.find("\"binaryDir\": \"${sourceDir}/build\"") != std::string::npos);
+    assert(presets.find("\"configurePreset\": \"default\"") != std::string::npos);
+
+    assert(options.key() != CMakeOptions().key());
+
+    std::cout << "✓ CMake build-speed options and presets\n";
+}
+
+void testCMakePrebuiltSdkCache() {
+    ModuleList modules;
+    modules.push_back(std::make_shared<PioModule>(PioConfig{"leds", "ws2812", 1, 22}));
+    modules.push_back(std::make_shared<MulticoreModule>(MulticoreConfig{true, "core1_main"}));
+    modules.push_back(std::make_shared<UartModule>(UartConfig{0, 115200, 0, 1, "none"}));
+
+    CMakeOptions options;
+    options.sdkCacheDir = "/var/cache/pico sdk";
+    auto cmake = CMakeGenerator::generate("cached", modules, options);
+
+    // Drivers come from the shared archive; pico_* libraries, and the drivers
+    // pico_stdlib compiles in anyway, are still compiled here.
+    assert(cmake.find("target_link_libraries(cached\n    pico_stdlib\n    hardware_clocks\n    hardware_uart\n"
+                      "    pico_multicore\n)") != std::string::npos);
+    assert(cmake.find("set(PICOFORGE_SDK_LIBS hardware_pio)") != std::string::npos);
+    assert(cmake.find("\"/var/cache/pico sdk\"") != std::string::npos);
+    assert(cmake.find("${PICO_SDK_VERSION_STRING}/${PICO_BOARD}/${PICOFORGE_SDK_KEY}") != std::string::npos);
+    assert(cmake.find("add_library(picoforge_sdk STATIC IMPORTED)") != std::string::npos);
+    // The key covers the toolchain and definitions, and is checked before import.
+    assert(cmake.find("${CMAKE_C_COMPILER} ${CMAKE_C_COMPILER_ID}") != std::string::npos);
+    assert(cmake.find("${PICOFORGE_DIR_DEFINITIONS}") != std::string::npos);
+    assert(cmake.find("if(PICOFORGE_SDK_STORED_KEY STREQUAL PICOFORGE_SDK_KEY_TEXT)") != std::string::npos);
+    // Temp names come from string(RANDOM), not the project name.
+    assert(cmake.find("string(RANDOM LENGTH 12 PICOFORGE_SDK_TMP)") != std::string::npos);
+    assert(cmake.find(".cached\"") == std::string::npos);
+    assert(cmake.find("target_link_libraries(cached picoforge_sdk ${PICOFORGE_SDK_HEADERS})") != std::string::npos);
+    assert(cmake.find("add_library(picoforge_sdk") > cmake.find("add_executable(cached"));
+
+    assert(CMakeGenerator::generate("cached", modules).find("picoforge_sdk") == std::string::npos);
+
+    std::cout << "✓ CMake imports prebuilt SDK drivers from a shared cache\n";
+}
@@ -38,9 +38,76 @@ void testCodeInjection() {
 }
 
 void testMultipleBlocks() {
+    std::string generated =
+        "// [USER_CODE] A\n"
+        "a0\n"
+        "// [USER_CODE] END\n"
+        "middle\n"
+        "// [USER_CODE] B\n"
+        "b0\n"
+        "// [USER_CODE] END\n"
+        "tail\n";
+
+    std::map<std::string, std::string> blocks = {{"A", "alpha\nalpha2\n"}, {"B", ""}, {"C", "lost\n"}};
+    std::vector<InjectionDiagnostic> diagnostics;
+    auto injected = CodeInjector::injectUserBlocks(generated, blocks, &diagnostics);
+
+    assert(injected ==
+        "// [USER_CODE] A\n"
+        "alpha\nalpha2\n"
+        "// [USER_CODE] END\n"
+        "middle\n"
+        "// [USER_CODE] B\n"
+        "// [USER_CODE] END\n"
+        "tail\n");
+    assert(diagnostics.size() == 1);
+    assert(diagnostics[0].kind == InjectionDiagnostic::Kind::MissingTarget);
+    assert(diagnostics[0].tag == "C");
+
+    // Round trip: extracting from the injected text yields the user blocks again.
+    auto extracted = CodeInjector::extractUserBlocks(injected);
+    assert(extracted.size() == 2);
+    assert(extracted["A"] == "alpha\nalpha2\n");
+    assert(extracted["B"].empty());
+
     std::cout << "✓ Multiple blocks test passed\n";
 }
 
 void testNestedBlocks() {
+    std::string source =
+        "// [USER_CODE] outer\n"
+        "x();\n"
+        "// [USER_CODE] inner\n"
+        "y();\n"
+        "// [USER_CODE] END\n"
+        "// [USER_CODE] END\n"
+        "// [USER_CODE] tail\n"
+        "z();\n";
+
+    auto scan = CodeInjector::scanUserBlocks(source);
+    assert(scan.blocks.size() == 1);
+    assert(scan.blocks["outer"].find("y();") != std::string::npos);
+    assert(scan.diagnostics.size() == 3);
+    assert(scan.diagnostics[0].kind == InjectionDiagnostic::Kind::NestedBlock);
+    assert(scan.diagnostics[0].line == 3);
+    assert(scan.diagnostics[1].kind == InjectionDiagnostic::Kind::UnmatchedEnd);
+    assert(scan.diagnostics[1].line == 6);
+    assert(scan.diagnostics[2].kind == InjectionDiagnostic::Kind::UnterminatedBlock);
+    assert(scan.diagnostics[2].tag == "tail");
+    assert(scan.diagnostics[2].line == 7);
+
     std::cout << "✓ Nested blocks test passed\n";
 }
+
+void testLargeSourceScan() {
+    // Pathological input for a backtracking regex: many starts, no END.
+    std::string source;
+    for (int i = 0; i < 20000; ++i) {
+        source += "// [USER_CODE] b" + std::to_string(i) + "\nline\n";
+    }
+    auto scan = CodeInjector::scanUserBlocks(source);
+    assert(scan.blocks.empty());
+    assert(scan.diagnostics.size() == 20000);
+
+    std::cout << "✓ Large source scan test passed\n";
+}
@@ -0,0 +1,76 @@
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "../../src/core/code_writer.h"
+#include "../../src/generators/main_generator.h"
+#include "../../src/modules/gpio_module.h"
+#include "../../src/modules/pwm_module.h"
+#include "../../src/modules/uart_module.h"
+
+using namespace picoforge;
+
+void testCodeWriterFormatting() {
+    CodeWriter out;
+    out << "x=" << -42 << " y=" << 7u << " z=" << 1234567890123LL << "\n";
+    assert(out.view() == "x=-42 y=7 z=1234567890123\n");
+
+    // Doubles must match std::ostream's default output byte for byte.
+    for (double d : {50.0, 7.5, 0.1, 25.125, 99.99999, 1e-7, 123456789.0}) {
+        std::ostringstream oss;
+        oss << d;
+        CodeWriter w;
+        w << d;
+        assert(w.view() == oss.str());
+    }
+
+    std::cout << "✓ CodeWriter number formatting\n";
+}
+
+void testCodeWriterIndentation() {
+    CodeWriter out;
+    out << "int main() {\n";
+    out.indent();
+    out << "a();\n\nb(";
+    out << 1 << ");\n";
+    out.indent();
+    out << "c();\n";
+    out.dedent();
+    out.dedent();
+    out << "}\n";
+    assert(out.view() == "int main() {\n    a();\n\n    b(1);\n        c();\n}\n");
+
+    std::string taken = out.take();
+    assert(out.size() == 0);
+    assert(!taken.empty());
+
+    std::cout << "✓ CodeWriter indentation\n";
+}
+
+void testEmitMatchesStringAdapters() {
+    ModuleList modules;
+    for (int pin = 0; pin < 30; ++pin) {
+        modules.push_back(std::make_shared<GpioModule>(GpioConfig{pin, "output", pin % 2 ? "up" : "none"}));
+    }
+    modules.push_back(std::make_shared<PwmModule>(PwmConfig{2, 1000, 33.3}));
+    modules.push_back(std::make_shared<UartModule>(UartConfig{1, 9600, 4, 5, "odd"}));
+
+    // Reference: the pre-CodeWriter composition through the string adapters.
+    std::set<std::string> headerSet;
+    std::string body;
+    for (const auto& m : modules) {
+        headerSet.insert(m->generateHeaderCode());
+        body += m->generateInitCode();
+    }
+    std::string headers;
+    for (const auto& h : headerSet) headers += h;
+
+    MainGenerator gen;
+    auto code = gen.generate(modules);
+    assert(code.mainBody == body);
+    assert(code.headers == headers);
+
+    std::cout << "✓ emit() path matches string adapters\n";
+}
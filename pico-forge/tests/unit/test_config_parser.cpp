@@ -23,3 +23,85 @@ void testConfigParser() {
 
     std::cout << "✓ Config Parser test passed\n";
 }
+
+void testConfigParserReadsValues() {
+    std::string json = R"({
+        "project_name": "values",
+        "pwm": [ { "pin": 7, "freq_hz": 2000, "duty_pct": 25.5 } ],
+        "uart": { "id": 1, "baud": 9600, "tx_pin": 4, "rx_pin": 5, "parity": "even" },
+        "dma": [ { "channel": 3, "data_size": 16, "src_inc": true, "dst_inc": false, "dreq": "pio0_tx0" } ],
+        "pio": [ { "name": "leds", "preset": "ws2812", "sm_count": 1, "data_pin": 22 } ],
+        "multicore": { "enable": true, "core1_entry": "worker" }
+    })";
+
+    auto project = ConfigParser::parseProjectString(json);
+    assert(project.name == "values");
+    assert(project.modules.size() == 5);
+
+    MainGenerator gen;
+    auto code = gen.generate(project.modules);
+    assert(code.mainBody.find("pwm_gpio_to_slice_num(7)") != std::string::npos);
+    assert(code.mainBody.find("125000000 / 2000") != std::string::npos);
+    assert(code.mainBody.find("uart_init(uart1, 9600)") != std::string::npos);
+    assert(code.mainBody.find("UART_PARITY_EVEN") != std::string::npos);
+    assert(code.mainBody.find("int dma_chan = 3;") != std::string::npos);
+    assert(code.mainBody.find("DMA_SIZE_16") != std::string::npos);
+    assert(code.mainBody.find("pio_gpio_init(pio, 22)") != std::string::npos);
+    assert(code.mainBody.find("multicore_launch_core1(worker)") != std::string::npos);
+
+    std::cout << "✓ Config parser value fidelity test passed\n";
+}
+
+void testConfigParserArrays() {
+    std::string json = "{ \"gpio\": [";
+    for (int pin = 0; pin < 20; ++pin) {
+        if (pin) json += ",";
+        json += "{\"pin\": " + std::to_string(pin) + ", \"direction\": \"input\", \"pull\": \"up\"}";
+    }
+    json += "] }";
+
+    auto modules = ConfigParser::parseString(json);
+    assert(modules.size() == 20);
+    assert(modules[19]->id() == "gpio_19");
+    assert(modules[19]->generateInitCode().find("gpio_pull_up(19)") != std::string::npos);
+
+    std::cout << "✓ Config parser array instances test passed\n";
+}
+
+void testConfigParserTaggedModules() {
+    std::string fixture_path = FIXTURES_PATH;
+    auto project = ConfigParser::parseProjectFile(fixture_path + "/sample_forge.json");
+    assert(project.name == "pico_sample");
+    assert(project.modules.size() == 5);
+    assert(project.modules[0]->id() == "gpio_25");
+    assert(project.modules[2]->id() == "adc_temp");
+
+    // "config" before "type" is still honoured
+    auto modules = ConfigParser::parseString(
+        R"({"modules": [ {"config": {"pin": 9}, "type": "gpio"}, {"type": "unknown"} ]})");
+    assert(modules.size() == 1);
+    assert(modules[0]->id() == "gpio_9");
+
+    std::cout << "✓ Config parser tagged modules test passed\n";
+}
+
+void testConfigParserErrors() {
+    [[maybe_unused]] bool threw = false;
+    try {
+        ConfigParser::parseString("{\n  \"gpio\": [ { \"pin\": 3, } ]\n}");
+    } catch (const ConfigParseError& e) {
+        threw = true;
+        assert(e.line() == 2);
+    }
+    assert(threw);
+
+    threw = false;
+    try {
+        ConfigParser::parseString("{ \"gpio\": [ { \"pin\": \"three\" } ] }");
+    } catch (const ConfigParseError&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Config parser error reporting test passed\n";
+}
@@ -1,6 +1,13 @@
 #include <iostream>
 #include <cassert>
+#include <memory>
 #include "../src/config/config_validator.h"
+#include "../src/modules/dma_module.h"
+#include "../src/modules/gpio_module.h"
+#include "../src/modules/i2c_module.h"
+#include "../src/modules/pio_module.h"
+#include "../src/modules/pwm_module.h"
+#include "../src/modules/uart_module.h"
 
 using namespace picoforge;
 
@@ -47,3 +54,79 @@ void testSpiSpeedValidation() {
     
     std::cout << "✓ SPI speed validation tests passed\n";
 }
+
+void testValidateAllConflicts() {
+    ModuleList modules = {
+        std::make_shared<GpioModule>(GpioConfig{4, "output", "none"}),
+        std::make_shared<UartModule>(UartConfig{0, 115200, 4, 5, "none"}),
+        std::make_shared<UartModule>(UartConfig{0, 9600, 12, 13, "none"}),
+        std::make_shared<PwmModule>(PwmConfig{2, 1000, 50}),
+        std::make_shared<PwmModule>(PwmConfig{18, 1000, 50}),
+        std::make_shared<GpioModule>(GpioConfig{40, "input", "up"}),
+    };
+
+    auto report = ConfigValidator::validateAll(modules);
+    assert(!report.ok());
+    // All problems are reported, in config order: pin 4, uart0, PWM slice 1, pin 40.
+    assert(report.diagnostics.size() == 4);
+
+    [[maybe_unused]] const auto& pin = report.diagnostics[0];
+    assert(pin.kind == ResourceDiagnostic::Kind::Conflict);
+    assert(pin.resource == ResourceKind::Gpio && pin.index == 4);
+    assert(pin.module == 1 && pin.holder == 0);
+    assert(pin.message.find("GPIO 4") != std::string::npos);
+
+    assert(report.diagnostics[1].resource == ResourceKind::Uart);
+    assert(report.diagnostics[1].holderId == modules[1]->id());
+
+    [[maybe_unused]] const auto& pwm = report.diagnostics[2];
+    assert(pwm.resource == ResourceKind::PwmSlice && pwm.index == 1);
+    assert(pwm.message.find("PWM slice 1 is used by both") != std::string::npos);
+
+    assert(report.diagnostics[3].kind == ResourceDiagnostic::Kind::InvalidModule);
+    assert(report.diagnostics[3].moduleId == "gpio_40");
+
+    // GPIO 2 and 3 are channels A and B of slice 1; a second frequency would
+    // silently retune the first.
+    auto sameSlice = ConfigValidator::validateAll({std::make_shared<PwmModule>(PwmConfig{2, 1000, 50}),
+                                                   std::make_shared<PwmModule>(PwmConfig{3, 20000, 50})});
+    assert(sameSlice.diagnostics.size() == 1 && sameSlice.diagnostics[0].resource == ResourceKind::PwmSlice);
+
+    // A negative pin is only an invalid module, not a request for any free GPIO.
+    auto unset = ConfigValidator::validateAll({std::make_shared<GpioModule>(GpioConfig{-1, "output", "none"})});
+    assert(unset.diagnostics.size() == 1 && unset.assignments.empty());
+    assert(unset.diagnostics[0].kind == ResourceDiagnostic::Kind::InvalidModule);
+
+    std::cout << "✓ validateAll reports every resource conflict\n";
+}
+
+void testValidateAllAssignsAndExhausts() {
+    ModuleList modules = {
+        std::make_shared<DmaModule>(DmaConfig{-1, 32, false, false, "none", {}}),
+        std::make_shared<DmaModule>(DmaConfig{0, 32, false, false, "none", {}}),
+        std::make_shared<PioModule>(PioConfig{"pio0", "ws2812", 3, 10, 0}),
+        std::make_shared<PioModule>(PioConfig{"pio0", "", 2, 11, 0}),
+    };
+
+    auto report = ConfigValidator::validateAll(modules);
+    // Fixed channel 0 is placed first, so the auto channel lands on 1.
+    assert(report.assignments.size() == 5);
+    assert(report.assignments[0].module == 0);
+    assert(report.assignments[0].resource == ResourceKind::DmaChannel);
+    assert(report.assignments[0].index == 1);
+    assert(report.assignments[4].module == 3 && report.assignments[4].index == 3);
+
+    // Both are pinned to pio0, which has four state machines; the fifth request cannot be met.
+    assert(report.diagnostics.size() == 1);
+    assert(report.diagnostics[0].kind == ResourceDiagnostic::Kind::Exhausted);
+    assert(report.diagnostics[0].resource == ResourceKind::PioStateMachine);
+    assert(report.diagnostics[0].module == 3);
+
+    ModuleList clean = {
+        std::make_shared<GpioModule>(GpioConfig{25, "output", "none"}),
+        std::make_shared<I2cModule>(I2cConfig{0, 4, 5, 400000}),
+    };
+    assert(ConfigValidator::validateAll(clean).ok());
+
+    std::cout << "✓ validateAll assigns free units and reports exhaustion\n";
+}
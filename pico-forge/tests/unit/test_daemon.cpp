@@ -0,0 +1,266 @@
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/core/daemon_protocol.h"
+
+#ifdef PICOFORGE_HAS_DAEMON
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../../src/core/daemon.h"
+#include "temp_dir.h"
+#endif
+
+using namespace picoforge;
+
+void testFrameDecoding() {
+    std::string wire = encodeFrame("{\"op\":\"ping\"}") + encodeFrame("") + encodeFrame("{\"id\":2}");
+
+    // Feed one byte at a time: frames must reassemble across arbitrary splits.
+    FrameDecoder decoder;
+    std::string frame;
+    std::vector<std::string> frames;
+    for (char c : wire) {
+        decoder.feed(&c, 1);
+        while (decoder.next(frame)) frames.push_back(frame);
+    }
+    assert(frames.size() == 3);
+    assert(frames[0] == "{\"op\":\"ping\"}");
+    assert(frames[1].empty());
+    assert(frames[2] == "{\"id\":2}");
+    assert(decoder.buffered() == 0);
+
+    FrameDecoder bad;
+    bad.feed("12x\n", 4);
+    [[maybe_unused]] bool threw = false;
+    try {
+        bad.next(frame);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    std::cout << "✓ Frame decoding\n";
+}
+
+#ifdef PICOFORGE_HAS_DAEMON
+namespace {
+const char* kBlinkConfig = R"({"project_name": "blink", "gpio": [{"pin": 25, "direction": "output"}]})";
+
+std::string generate_request(int id) {
+    return std::string(R"({"id": )") + std::to_string(id) + R"(, "op": "generate", "config": )" + kBlinkConfig + "}";
+}
+
+DaemonOptions daemon_options(size_t jobs, size_t maxInFlight = 0) {
+    DaemonOptions options;
+    options.jobs = jobs;
+    options.maxInFlight = maxInFlight;
+    return options;
+}
+
+int connect_to(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    // The server thread may not be listening yet.
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) return fd;
+        close(fd);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    return -1;
+}
+
+// Sends one request and waits up to timeoutMs for its response ("" on timeout).
+std::string round_trip(int fd, const std::string& payload, int timeoutMs) {
+    auto frame = encodeFrame(payload);
+    if (write(fd, frame.data(), frame.size()) != static_cast<ssize_t>(frame.size())) return "";
+    FrameDecoder decoder;
+    std::string response;
+    char buf[4096];
+    pollfd p{fd, POLLIN, 0};
+    while (poll(&p, 1, timeoutMs) > 0) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n <= 0) break;
+        decoder.feed(buf, static_cast<size_t>(n));
+        if (decoder.next(response)) return response;
+    }
+    return "";
+}
+}  // namespace
+
+void testDaemonHandlesRequests() {
+    Daemon daemon(daemon_options(1));
+
+    auto pong = daemon.handle(R"({"id": "a", "op": "ping"})");
+    assert(pong == R"({"id":"a","ok":true})");
+
+    auto generated = daemon.handle(generate_request(1));
+    assert(generated.find(R"("ok":true)") != std::string::npos);
+    assert(generated.find(R"("project":"blink")") != std::string::npos);
+    assert(generated.find("gpio_init(25);") != std::string::npos);
+    assert(generated.find("[USER_CODE] main_loop") != std::string::npos);
+
+    auto invalid = daemon.handle(R"({"id": 3, "op": "validate", "config": {"gpio": [{"pin": 40}]}})");
+    assert(invalid.find(R"("ok":false)") != std::string::npos);
+    assert(invalid.find(R"("invalid":["gpio_40"])") != std::string::npos);
+
+    auto conflict = daemon.handle(
+        R"({"id": 30, "op": "validate", "config": {"gpio": [{"pin": 4}], "uart": [{"id": 0, "tx_pin": 4, "rx_pin": 5}]}})");
+    assert(conflict.find(R"("ok":false)") != std::string::npos);
+    assert(conflict.find(R"("invalid":[])") != std::string::npos);
+    assert(conflict.find(R"("kind":"conflict")") != std::string::npos);
+    assert(conflict.find(R"("resource":"GPIO","index":4)") != std::string::npos);
+
+    auto malformed = daemon.handle(R"({"id": 4, "op": "generate", "config": {"gpio": [}})");
+    assert(malformed.rfind(R"({"id":4,"ok":false,"error":")", 0) == 0);
+
+    auto unknown = daemon.handle(R"({"id": 5, "op": "explode"})");
+    assert(unknown.find("unknown op") != std::string::npos);
+
+    assert(daemon.stats().requests == 6);
+    assert(daemon.stats().failures == 2);
+
+    std::cout << "✓ Daemon request handling\n";
+}
+
+void testDaemonServesStreamWithBackpressure() {
+    int requestPipe[2];
+    int responsePipe[2];
+    [[maybe_unused]] int requestOk = pipe(requestPipe);
+    [[maybe_unused]] int responseOk = pipe(responsePipe);
+    assert(requestOk == 0 && responseOk == 0);
+
+    // One in-flight slot: the reader has to wait for each response before
+    // picking up the next request, yet every request is still answered.
+    const int kRequests = 20;
+    std::thread writer([&]() {
+        for (int i = 0; i < kRequests; ++i) {
+            auto frame = encodeFrame(generate_request(i));
+            ssize_t n = write(requestPipe[1], frame.data(), frame.size());
+            assert(n == static_cast<ssize_t>(frame.size()));
+            (void)n;
+        }
+        close(requestPipe[1]);
+    });
+
+    std::vector<std::string> responses;
+    std::thread reader([&]() {
+        FrameDecoder decoder;
+        std::string frame;
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(responsePipe[0], buf, sizeof(buf))) > 0) {
+            decoder.feed(buf, static_cast<size_t>(n));
+            while (decoder.next(frame)) responses.push_back(frame);
+        }
+    });
+
+    {
+        Daemon daemon(daemon_options(2, 1));
+        daemon.serveStream(requestPipe[0], responsePipe[1]);
+        assert(daemon.stats().inFlight == 0);
+    }
+    close(responsePipe[1]);
+    writer.join();
+    reader.join();
+    close(requestPipe[0]);
+    close(responsePipe[0]);
+
+    assert(responses.size() == static_cast<size_t>(kRequests));
+    std::vector<bool> seen(kRequests, false);
+    for (const auto& r : responses) {
+        assert(r.find(R"("ok":true)") != std::string::npos);
+        int id = std::stoi(r.substr(r.find(':') + 1));
+        seen[static_cast<size_t>(id)] = true;
+    }
+    for ([[maybe_unused]] bool s : seen) assert(s);
+
+    std::cout << "✓ Daemon serves a stream with bounded in-flight requests\n";
+}
+
+void testDaemonConfinesPathsToRoot() {
+    auto root = freshTempDir("picoforge_daemon_root_test");
+    auto outside = freshTempDir("picoforge_daemon_outside_test");
+    std::ofstream(root / "blink.json") << kBlinkConfig;
+    std::ofstream(outside / "blink.json") << kBlinkConfig;
+    std::filesystem::create_symlink(outside, root / "escape");
+
+    DaemonOptions options = daemon_options(1);
+    options.root = root.string();
+    Daemon daemon(options);
+    auto request = [](const std::filesystem::path& config, const std::filesystem::path& out) {
+        return R"({"id": 1, "config_path": ")" + config.string() + R"(", "output": ")" + out.string() + R"("})";
+    };
+
+    auto inside = daemon.handle(request(root / "blink.json", root / "out"));
+    assert(inside.find(R"("ok":true)") != std::string::npos);
+    assert(std::filesystem::exists(root / "out" / "main.cpp"));
+
+    auto readOutside = daemon.handle(request(outside / "blink.json", root / "out"));
+    assert(readOutside.find("config_path is outside the daemon root") != std::string::npos);
+    auto writeOutside = daemon.handle(request(root / "blink.json", outside / "out"));
+    assert(writeOutside.find("output is outside the daemon root") != std::string::npos);
+    auto viaLink = daemon.handle(request(root / "blink.json", root / "escape" / "out"));
+    assert(viaLink.find("output is outside the daemon root") != std::string::npos);
+    auto dotDot = daemon.handle(request(root / ".." / outside.filename() / "blink.json", root / "out"));
+    assert(dotDot.find("config_path is outside the daemon root") != std::string::npos);
+    assert(!std::filesystem::exists(outside / "out"));
+
+    std::filesystem::remove_all(root);
+    std::filesystem::remove_all(outside);
+    std::cout << "✓ Daemon root confines config_path and output\n";
+}
+
+void testDaemonSocketLimitsClients() {
+    auto dir = freshTempDir("picoforge_daemon_socket_test");
+    auto path = (dir / "pf.sock").string();
+
+    DaemonOptions options = daemon_options(1);
+    options.maxConnections = 1;
+    Daemon daemon(options);
+    std::thread server([&]() { daemon.serveSocket(path); });
+
+    int first = connect_to(path);
+    assert(first >= 0);
+    [[maybe_unused]] auto pong = round_trip(first, R"({"id": 1, "op": "ping"})", 2000);
+    assert(pong == R"({"id":1,"ok":true})");
+
+    [[maybe_unused]] struct stat st;
+    assert(stat(path.c_str(), &st) == 0 && (st.st_mode & 0777) == 0600);
+
+    // The second client sits in the backlog until the first disconnects.
+    int second = connect_to(path);
+    assert(second >= 0);
+    [[maybe_unused]] auto waiting = round_trip(second, R"({"id": 2, "op": "ping"})", 300);
+    assert(waiting.empty());
+    close(first);
+    FrameDecoder decoder;
+    std::string response;
+    char buf[256];
+    while (!decoder.next(response)) {
+        ssize_t n = read(second, buf, sizeof(buf));
+        assert(n > 0);
+        decoder.feed(buf, static_cast<size_t>(n));
+    }
+    assert(response == R"({"id":2,"ok":true})");
+
+    [[maybe_unused]] auto bye = round_trip(second, R"({"id": 3, "op": "shutdown"})", 2000);
+    assert(bye == R"({"id":3,"ok":true})");
+    close(second);
+    server.join();
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Daemon socket is owner-only and caps concurrent clients\n";
+}
+#endif
@@ -0,0 +1,111 @@
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../../src/core/dependency_injector.h"
+
+using namespace picoforge;
+
+namespace {
+struct Clock {
+    int ticks = 0;
+};
+struct RequestContext {
+    std::shared_ptr<Clock> clock;
+};
+struct Formatter {
+    std::shared_ptr<RequestContext> context;
+};
+
+// Distinct types, so type indices run past kMaxServiceTypes.
+template <size_t N>
+struct Tag {};
+
+template <size_t... N>
+bool any_tag_registered(const DependencyInjector& injector, std::index_sequence<N...>) {
+    return (injector.isRegistered<Tag<N>>() || ...);
+}
+}  // namespace
+
+void testInjectorLifetimes() {
+    DependencyInjector injector;
+    int clocks = 0;
+    injector.registerFactory<Clock>(Lifetime::Singleton, [&clocks] {
+        ++clocks;
+        return std::make_shared<Clock>();
+    });
+    injector.registerFactory<RequestContext>(Lifetime::Scoped, [](const DependencyInjector::Resolver& r) {
+        return std::make_shared<RequestContext>(RequestContext{r.resolve<Clock>()});
+    });
+    injector.registerFactory<Formatter>(Lifetime::Transient, [](const DependencyInjector::Resolver& r) {
+        return std::make_shared<Formatter>(Formatter{r.resolve<RequestContext>()});
+    });
+
+    assert(injector.isRegistered<Clock>());
+    assert(!injector.isRegistered<std::string>());
+    assert(injector.resolve<std::string>() == nullptr);
+
+    auto clock = injector.resolve<Clock>();
+    assert(clock && clock == injector.resolve<Clock>());
+    assert(clocks == 1);
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        injector.resolve<RequestContext>();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    auto a = injector.createScope();
+    auto b = injector.createScope();
+    auto f1 = a.resolve<Formatter>();
+    auto f2 = a.resolve<Formatter>();
+    assert(f1 != f2);                         // transient
+    assert(f1->context == f2->context);       // same scope
+    assert(f1->context != b.resolve<Formatter>()->context);
+    assert(f1->context->clock == clock);      // singleton shared across scopes
+    assert(clocks == 1);
+    std::cout << "✓ Injector singleton/scoped/transient lifetimes\n";
+}
+
+void testInjectorConcurrentSingleton() {
+    DependencyInjector injector;
+    std::atomic<int> built{0};
+    injector.registerFactory<Clock>(Lifetime::Singleton, [&built] {
+        built.fetch_add(1);
+        return std::make_shared<Clock>();
+    });
+
+    std::vector<std::thread> threads;
+    std::vector<Clock*> seen(8, nullptr);
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; ++i) seen[t] = injector.resolve<Clock>().get();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    assert(built.load() == 1);
+    for ([[maybe_unused]] auto* p : seen) assert(p == seen[0]);
+
+    // Re-registering replaces the service for later resolves.
+    auto fixed = std::make_shared<Clock>();
+    fixed->ticks = 7;
+    injector.registerInstance(fixed);
+    assert(injector.resolve<Clock>()->ticks == 7);
+
+    // Runs last: it uses up the process-wide type indices. Types past the
+    // table are reported as unregistered rather than read out of bounds.
+    [[maybe_unused]] bool anyTag =
+        any_tag_registered(injector, std::make_index_sequence<DependencyInjector::kMaxServiceTypes + 8>());
+    assert(!anyTag);
+
+    std::cout << "✓ Injector builds a singleton once across threads\n";
+}
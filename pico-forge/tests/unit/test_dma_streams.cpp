@@ -0,0 +1,98 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/core/resource_allocator.h"
+#include "../../src/modules/dma_module.h"
+#include "golden.h"
+
+using namespace picoforge;
+
+namespace {
+DmaConfig stream(int channel, int dataSize, DmaStream s) {
+    DmaConfig cfg;
+    cfg.channel = channel;
+    cfg.data_size = dataSize;
+    cfg.stream = std::move(s);
+    return cfg;
+}
+}  // namespace
+
+void testDmaStreamGolden() {
+    DmaStream adc;
+    adc.src = "adc";
+    adc.dst = "memory";
+    adc.transfer_count = 256;
+    adc.ping_pong = true;
+    adc.chain_channel = 3;
+    adc.irq = true;
+    DmaModule capture(stream(2, 16, adc));
+    assert(capture.validate());
+    checkGolden("dma_adc_ping_pong.txt", renderModule(capture));
+
+    DmaStream pio;
+    pio.src = "memory";
+    pio.dst = "pio0_sm1";
+    pio.transfer_count = 1024;
+    pio.ring_bits = 8;
+    pio.ping_pong = true;
+    pio.chain_channel = 5;
+    DmaModule waveform(stream(4, 32, pio));
+    assert(waveform.validate());
+    checkGolden("dma_pio_ring.txt", renderModule(waveform));
+
+    DmaStream uart;
+    uart.src = "memory";
+    uart.dst = "uart1";
+    uart.transfer_count = 64;
+    uart.irq = true;
+    uart.irq_line = 1;
+    DmaModule tx(stream(-1, 8, uart));
+    assert(tx.validate());
+    checkGolden("dma_uart_tx.txt", renderModule(tx));
+    std::cout << "✓ DMA streams match golden output (ping-pong IRQ, ring chain, single)\n";
+}
+
+void testDmaStreamValidationAndAllocation() {
+    DmaStream s;
+    s.src = "memory";
+    s.dst = "spi0";
+    s.transfer_count = 32;
+    assert(DmaModule(stream(0, 8, s)).validate());
+
+    [[maybe_unused]] auto broken = [&](auto mutate) {
+        DmaConfig cfg = stream(0, 8, s);
+        mutate(cfg);
+        return !DmaModule(cfg).validate();
+    };
+    assert(broken([](DmaConfig& c) { c.stream.dst = "adc"; }));             // ADC is source only
+    assert(broken([](DmaConfig& c) { c.stream.src = "pwm2"; }));            // PWM is destination only
+    assert(broken([](DmaConfig& c) { c.stream.dst = "pio2_sm0"; }));        // no third PIO block
+    assert(broken([](DmaConfig& c) { c.stream.transfer_count = 0; }));
+    assert(broken([](DmaConfig& c) { c.stream.ping_pong = true; }));         // nothing would rewind it
+    assert(broken([](DmaConfig& c) { c.stream.ring_bits = 16; }));
+    assert(broken([](DmaConfig& c) { c.dreq = "uart3_tx"; }));
+    assert(broken([](DmaConfig& c) { c.stream.transfer_count = 200000; }));  // buffer too large
+
+    // Legacy channel setup now sets the DREQ instead of leaving a comment.
+    DmaConfig legacy;
+    legacy.channel = 1;
+    legacy.dreq = "pio1_rx2";
+    assert(DmaModule(legacy).generateInitCode().find("channel_config_set_dreq(&c, DREQ_PIO1_RX2);") != std::string::npos);
+    assert(DmaModule(legacy).generateDefinitionsCode().empty());
+
+    // The allocator fixes both channels of an auto ping-pong stream.
+    auto project = ConfigParser::parseProjectString(R"({
+        "name": "streams",
+        "dma": [ { "channel": 0 },
+                 { "channel": -1, "data_size": 16, "src": "adc", "dst": "memory", "count": 128,
+                   "ping_pong": true, "irq": true } ]
+    })");
+    auto allocated = ResourceAllocator::allocate(project.modules);
+    assert(allocated.ok());
+    [[maybe_unused]] const auto& cfg = static_cast<const DmaModule&>(*allocated.modules[1]).config();
+    assert(cfg.channel == 1 && cfg.stream.chain_channel == 2);
+    assert(allocated.modules[1]->dependencies().size() == 3);  // dma, irq, adc
+    std::cout << "✓ DMA stream validation and chained channel allocation\n";
+}
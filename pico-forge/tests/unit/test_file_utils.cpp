@@ -0,0 +1,90 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include <sys/stat.h>
+
+#include "../../src/utils/file_utils.h"
+#include "temp_dir.h"
+
+using namespace picoforge;
+
+void testMappedFileReads() {
+    auto dir = freshTempDir("picoforge_mapped_file_test");
+    auto small = (dir / "small.json").string();
+    auto large = (dir / "large.cpp").string();
+
+    [[maybe_unused]] bool wroteSmall = FileUtils::writeFile(small, "{\"gpio\": []}");
+    std::string big(MappedFile::kMapThreshold * 3 + 17, 'x');
+    big.back() = '\n';
+    [[maybe_unused]] bool wroteLarge = FileUtils::writeFile(large, big);
+    assert(wroteSmall && wroteLarge);
+
+    MappedFile s(small);
+    assert(s.isOpen() && !s.isMapped());
+    assert(s.view() == "{\"gpio\": []}");
+
+    MappedFile l = FileUtils::mapFile(large);
+    assert(l.isOpen() && l.isMapped() == MappedFile::canMap());
+    assert(l.view() == big);
+    assert(FileUtils::readFile(large) == big);
+
+    // Moving keeps the view valid, including small-string buffers.
+    MappedFile moved(std::move(s));
+    assert(moved.view() == "{\"gpio\": []}");
+    assert(!s.isOpen());
+
+    MappedFile missing((dir / "nope").string());
+    assert(!missing.isOpen() && missing.view().empty());
+    assert(FileUtils::readFile((dir / "nope").string()).empty());
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ MappedFile maps large files and buffers small ones\n";
+}
+
+void testAtomicWrites() {
+    auto dir = freshTempDir("picoforge_atomic_write_test");
+    auto file = (dir / "main.cpp").string();
+
+    [[maybe_unused]] bool wrote = FileUtils::writeFile(file, "int main() {}\n");
+    assert(wrote);
+    ::chmod(file.c_str(), 0750);
+    [[maybe_unused]] WriteStatus rewritten = FileUtils::writeFileIfChanged(file, "int main() { return 0; }\n");
+    assert(rewritten == WriteStatus::Written);
+    assert(FileUtils::readFile(file) == "int main() { return 0; }\n");
+
+    [[maybe_unused]] struct stat st;
+    assert(::stat(file.c_str(), &st) == 0 && (st.st_mode & 0777) == 0750);
+
+    // Only the target is left behind: temp files are renamed into place.
+    size_t entries = 0;
+    for (const auto& e : std::filesystem::directory_iterator(dir)) {
+        (void)e;
+        ++entries;
+    }
+    assert(entries == 1);
+
+    [[maybe_unused]] bool wroteMissing = FileUtils::writeFile((dir / "missing_dir" / "x").string(), "x");
+    assert(!wroteMissing);
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Writes replace files atomically and keep their mode\n";
+}
+
+void testWritesFollowSymlinks() {
+    auto dir = freshTempDir("picoforge_symlink_write_test");
+    std::filesystem::create_directories(dir / "shared");
+    auto target = dir / "shared" / "main.cpp";
+    auto link = dir / "main.cpp";
+    [[maybe_unused]] bool wrote = FileUtils::writeFile(target.string(), "old\n");
+    std::filesystem::create_symlink(target, link);
+
+    wrote = FileUtils::writeFile(link.string(), "new\n");
+    assert(wrote);
+    assert(std::filesystem::is_symlink(link));
+    assert(FileUtils::readFile(target.string()) == "new\n");
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Writes through a symlink replace its target and keep the link\n";
+}
@@ -0,0 +1,105 @@
+/* Compiles the golden filter kernels as C on the host, checks their numerics
+ * and reports throughput in ns per sample. */
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "golden/filter_average.c"
+#include "golden/filter_biquad.c"
+#include "golden/filter_cic.c"
+
+#define BENCH_SAMPLES (1u << 20)
+#define BLOCK 512
+
+static const double kPi = 3.14159265358979323846;
+
+static void test_average(void) {
+    avg_filter_t f = {0};
+    uint16_t in[20], out[20];
+    for (int i = 0; i < 20; i += 2) {
+        in[i] = 1000;
+        in[i + 1] = (uint16_t)(3000 + i);  /* slot 1 ramps by 2 per frame */
+    }
+    uint32_t produced = avg_filter_block(&f, in, 20, out);
+    assert(produced == 20);
+    (void)produced;
+    assert(out[0] == 200);   /* (1000 + 4 zeros) / 5 */
+    assert(out[8] == 1000);  /* full window from frame 4 on */
+    assert(out[18] == 1000);
+    assert(out[19] == 3014); /* mean of 3010..3018 */
+    printf("  ok average\n");
+}
+
+static void test_cic(void) {
+    cic_filter_t f = {0};
+    uint16_t in[BLOCK], out[BLOCK];
+    for (int i = 0; i < BLOCK; ++i) in[i] = 2048;
+    uint32_t n = cic_filter_block(&f, in, BLOCK, out);
+    assert(n == BLOCK / 16);
+    assert(out[n - 1] == 2048);  /* settled after order x R inputs */
+
+    /* A tone at the output rate falls in the first sinc null. */
+    for (int i = 0; i < BLOCK; ++i) in[i] = (uint16_t)(2048 + 2000 * sin(2 * kPi * i / 16.0));
+    n = cic_filter_block(&f, in, BLOCK, out);
+    for (uint32_t i = 4; i < n; ++i) assert(abs((int)out[i] - 2048) < 8);
+    printf("  ok cic\n");
+}
+
+static double biquad_amplitude(double hz) {
+    lpf_filter_t f = {0};
+    uint16_t in[BLOCK], out[BLOCK];
+    int lo = 65535, hi = 0;
+    for (int b = 0; b < 16; ++b) {
+        for (int i = 0; i < BLOCK; ++i) {
+            in[i] = (uint16_t)(2048 + 1000 * sin(2 * kPi * hz * (b * BLOCK + i) / 48000.0));
+        }
+        lpf_filter_block(&f, in, BLOCK, out);
+        for (int i = 0; b >= 8 && i < BLOCK; ++i) {
+            if (out[i] < lo) lo = out[i];
+            if (out[i] > hi) hi = out[i];
+        }
+    }
+    return (hi - lo) / 2000.0;
+}
+
+static void test_biquad(void) {
+    lpf_filter_t f = {0};
+    uint16_t in[BLOCK], out[BLOCK];
+    for (int i = 0; i < BLOCK; ++i) in[i] = 4000;
+    for (int b = 0; b < 4; ++b) lpf_filter_block(&f, in, BLOCK, out);
+    assert(abs((int)out[BLOCK - 1] - 4000) <= 1);  /* unity DC gain */
+
+    assert(biquad_amplitude(100) > 0.98);
+    double corner = biquad_amplitude(1000);
+    assert(corner > 0.68 && corner < 0.73);        /* -3 dB */
+    (void)corner;
+    assert(biquad_amplitude(10000) < 0.02);        /* -40 dB a decade up */
+    printf("  ok biquad\n");
+}
+
+#define BENCH(name, filter_t, block_fn)                                               \
+    do {                                                                              \
+        filter_t f = {0};                                                             \
+        uint16_t in[BLOCK], out[BLOCK];                                               \
+        uint32_t sink = 0;                                                            \
+        for (int i = 0; i < BLOCK; ++i) in[i] = (uint16_t)((i * 2654435761u) >> 20); \
+        clock_t start = clock();                                                      \
+        for (uint32_t done = 0; done < BENCH_SAMPLES; done += BLOCK) {                \
+            sink += block_fn(&f, in, BLOCK, out) + out[0];                            \
+        }                                                                             \
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / BENCH_SAMPLES; \
+        printf("  %-8s %6.2f ns/sample (%u)\n", name, ns, (unsigned)(sink & 1));      \
+    } while (0)
+
+int main(void) {
+    test_average();
+    test_cic();
+    test_biquad();
+    BENCH("average", avg_filter_t, avg_filter_block);
+    BENCH("cic", cic_filter_t, cic_filter_block);
+    BENCH("biquad", lpf_filter_t, lpf_filter_block);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "../../src/core/generation_cache.h"
+#include "../../src/core/generation_pipeline.h"
+#include "../../src/modules/gpio_module.h"
+#include "../../src/modules/pwm_module.h"
+#include "temp_dir.h"
+
+using namespace picoforge;
+
+namespace {
+
+ProjectConfig make_project(int pin) {
+    ProjectConfig project;
+    project.name = "cache_test";
+    project.modules.push_back(std::make_shared<GpioModule>(GpioConfig{pin, "output", "none"}));
+    project.modules.push_back(std::make_shared<PwmModule>(PwmConfig{2, 1000, 50.0}));
+    return project;
+}
+}  // namespace
+
+void testConfigKeyNormalization() {
+    GpioModule a({15, "output", "none"});
+    GpioModule b({15, "output", "none"});
+    GpioModule c({15, "input", "none"});
+    assert(a.configKey() == b.configKey());
+    assert(a.configKey() != c.configKey());
+    assert(a.configKey() == "gpio{pin=15,direction=\"output\",pull=\"none\"}");
+
+    PwmModule p1({2, 1000, 50.0});
+    PwmModule p2({2, 1000, 50.000001});
+    assert(p1.configKey() != p2.configKey());
+
+    std::cout << "✓ Module config keys are canonical\n";
+}
+
+void testGenerationCacheHitMiss() {
+    auto dir = freshTempDir("picoforge_cache_test");
+    auto project = make_project(15);
+
+    GenerationCache cache(dir.string());
+    auto first = GenerationPipeline::generate(project, {&cache, false, {}});
+    auto second = GenerationPipeline::generate(project, {&cache, false, {}});
+    assert(cache.stats().misses == 1);
+    assert(cache.stats().hits == 1);
+    assert(second.code.mainBody == first.code.mainBody);
+    assert(second.code.headers == first.code.headers);
+    assert(second.cmake == first.cmake);
+    assert(second.moduleCount == 2);
+
+    // Persisted: a fresh cache instance over the same directory hits.
+    GenerationCache reopened(dir.string());
+    GenerationOutput out;
+    assert(reopened.lookup(GenerationCache::normalizedKey(project), out));
+    assert(out.projectName == "cache_test");
+
+    // A config change is a different key.
+    assert(!reopened.lookup(GenerationCache::normalizedKey(make_project(16)), out));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Generation cache hit/miss\n";
+}
+
+void testGenerationCacheEviction() {
+    auto dir = freshTempDir("picoforge_cache_evict_test");
+    GenerationCache probe(dir.string());
+    GenerationPipeline::generate(make_project(0), {&probe, false, {}});
+    uint64_t entrySize = probe.stats().bytes;
+    std::filesystem::remove_all(dir);
+
+    // Room for roughly three entries.
+    GenerationCache cache(dir.string(), entrySize * 3 + entrySize / 2);
+    for (int pin = 0; pin < 6; ++pin) {
+        GenerationPipeline::generate(make_project(pin), {&cache, false, {}});
+        if (pin >= 1) {
+            // Keep pin 0 hot so LRU keeps it.
+            GenerationOutput out;
+            assert(cache.lookup(GenerationCache::normalizedKey(make_project(0)), out));
+        }
+    }
+
+    [[maybe_unused]] auto stats = cache.stats();
+    assert(stats.entries == 3);
+    assert(stats.evictions == 3);
+    assert(stats.bytes <= entrySize * 3 + entrySize / 2);
+
+    GenerationOutput out;
+    assert(cache.lookup(GenerationCache::normalizedKey(make_project(0)), out));
+    assert(cache.lookup(GenerationCache::normalizedKey(make_project(5)), out));
+    assert(!cache.lookup(GenerationCache::normalizedKey(make_project(1)), out));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Generation cache LRU eviction\n";
+}
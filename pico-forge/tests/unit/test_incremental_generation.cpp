@@ -0,0 +1,112 @@
+#include <cassert>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "../../src/core/fragment_store.h"
+#include "../../src/core/generation_pipeline.h"
+#include "../../src/generators/main_generator.h"
+#include "../../src/modules/gpio_module.h"
+#include "../../src/modules/uart_module.h"
+#include "../../src/utils/file_utils.h"
+#include "temp_dir.h"
+
+using namespace picoforge;
+
+namespace {
+// GPIO module that counts how often its fragments are generated.
+class CountingGpio : public GpioModule {
+public:
+    explicit CountingGpio(GpioConfig cfg, int* calls) : GpioModule(std::move(cfg)), calls_(calls) {}
+    std::string generateInitCode() const override {
+        ++*calls_;
+        return GpioModule::generateInitCode();
+    }
+
+private:
+    int* calls_;
+};
+
+}  // namespace
+
+void testFragmentStoreReusesUnchangedModules() {
+    auto dir = freshTempDir("picoforge_fragments_test");
+    auto state = (dir / "fragments").string();
+    int calls = 0;
+
+    ModuleList modules;
+    for (int pin = 0; pin < 10; ++pin) {
+        modules.push_back(std::make_shared<CountingGpio>(GpioConfig{pin, "output", "none"}, &calls));
+    }
+    modules.push_back(std::make_shared<UartModule>(UartConfig{0, 115200, 0, 1, "none"}));
+
+    {
+        FragmentStore store(state);
+        auto code = store.generate(modules);
+        assert(store.emitted() == 11);
+        assert(calls == 10);
+        [[maybe_unused]] bool saved = store.save();
+        assert(saved);
+
+        MainGenerator gen;
+        auto full = gen.generate(modules);
+        assert(code.headers == full.headers);
+        assert(code.mainBody == full.mainBody);
+    }
+
+    calls = 0;
+    modules[3] = std::make_shared<CountingGpio>(GpioConfig{3, "input", "up"}, &calls);
+    {
+        FragmentStore store(state);
+        auto code = store.generate(modules);
+        assert(store.emitted() == 1);
+        assert(store.reused() == 10);
+        assert(calls == 1);
+        assert(code.mainBody.find("gpio_pull_up(3)") != std::string::npos);
+
+        MainGenerator gen;
+        assert(code.mainBody == gen.generate(modules).mainBody);
+    }
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Fragment store re-emits only changed modules\n";
+}
+
+void testWriteSkipsIdenticalFiles() {
+    auto dir = freshTempDir("picoforge_write_skip_test");
+    auto file = (dir / "out.txt").string();
+
+    [[maybe_unused]] WriteStatus created = FileUtils::writeFileIfChanged(file, "abc");
+    assert(created == WriteStatus::Written);
+    [[maybe_unused]] auto mtime = std::filesystem::last_write_time(file);
+    [[maybe_unused]] WriteStatus same = FileUtils::writeFileIfChanged(file, "abc");
+    assert(same == WriteStatus::Unchanged);
+    assert(std::filesystem::last_write_time(file) == mtime);
+    [[maybe_unused]] WriteStatus changed = FileUtils::writeFileIfChanged(file, "abd");
+    assert(changed == WriteStatus::Written);
+    assert(FileUtils::readFile(file) == "abd");
+
+    ProjectConfig project;
+    project.name = "incremental";
+    project.modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "none"}));
+
+    GenerationOptions options;
+    options.incremental = true;
+    auto out = (dir / "project").string();
+
+    [[maybe_unused]] auto first = GenerationPipeline::writeProject(GenerationPipeline::generate(project, options, out), out);
+    assert(first.written == 2);
+    [[maybe_unused]] auto second = GenerationPipeline::writeProject(GenerationPipeline::generate(project, options, out), out);
+    assert(second.written == 0 && second.unchanged == 2);
+
+    auto reused = GenerationPipeline::generate(project, options, out);
+    assert(reused.modulesReused == 1);
+
+    options.cmake.presets = true;
+    [[maybe_unused]] auto withPresets = GenerationPipeline::writeProject(GenerationPipeline::generate(project, options, out), out);
+    assert(withPresets.written == 1 && withPresets.unchanged == 2);
+    assert(FileUtils::fileExists(out + "/CMakePresets.json"));
+
+    std::filesystem::remove_all(dir);
+    std::cout << "✓ Unchanged outputs are not rewritten\n";
+}
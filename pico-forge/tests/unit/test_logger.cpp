@@ -0,0 +1,73 @@
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/utils/logger.h"
+
+using namespace picoforge;
+
+void testLoggerFormatsFieldsAndFiltersLazily() {
+    std::ostringstream out;
+    Logger::setOutput(&out);
+    Logger::setLevel(LogLevel::Info);
+
+    int formatted = 0;
+    Logger::debug([&] {
+        ++formatted;
+        return std::string("expensive");
+    });
+    assert(!Logger::enabled(LogLevel::Debug));
+    Logger::info("generated", {{"project", "blinky"}, {"modules", 3}, {"cached", false}});
+    Logger::warning([&] {
+        ++formatted;
+        return std::string("pin ") + std::to_string(4);
+    }, {{"file", "my main.cpp"}, {"note", ""}});
+    Logger::flush();
+    Logger::setOutput(nullptr);
+
+    assert(formatted == 1);  // the filtered debug message was never built
+    assert(out.str() ==
+           "[INFO]  generated project=blinky modules=3 cached=false\n"
+           "[WARN]  pin 4 file=\"my main.cpp\" note=\"\"\n");
+    std::cout << "✓ Logger formats key/value fields and skips filtered messages\n";
+}
+
+void testLoggerConcurrentProducers() {
+    std::ostringstream out;
+    Logger::setOutput(&out);
+    Logger::setLevel(LogLevel::Info);
+
+    // More records than the ring holds, so producers also wait for space.
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 600;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < kPerThread; ++i) Logger::info("record", {{"thread", t}, {"seq", i}});
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    Logger::flush();
+    Logger::setOutput(nullptr);
+
+    // Every record arrives once, and each thread's records stay in order.
+    std::vector<int> next(kThreads, 0);
+    std::istringstream lines(out.str());
+    std::string line;
+    int total = 0;
+    while (std::getline(lines, line)) {
+        int t = -1;
+        int seq = -1;
+        [[maybe_unused]] int parsed = std::sscanf(line.c_str(), "[INFO]  record thread=%d seq=%d", &t, &seq);
+        assert(parsed == 2);
+        assert(t >= 0 && t < kThreads && seq == next[t]);
+        ++next[t];
+        ++total;
+    }
+    assert(total == kThreads * kPerThread);
+    std::cout << "✓ Logger keeps every record from concurrent producers\n";
+}
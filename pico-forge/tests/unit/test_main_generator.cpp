@@ -7,6 +7,7 @@
 #include "../../src/modules/pwm_module.h"
 #include "../../src/modules/timer_module.h"
 #include "../../src/modules/adc_module.h"
+#include "../../src/modules/pio_module.h"
 
 using namespace picoforge;
 
@@ -15,7 +16,7 @@ void testMainGenerator() {
     modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "up"}));
     modules.push_back(std::make_shared<PwmModule>(PwmConfig{2, 1000, 50.0}));
     modules.push_back(std::make_shared<TimerModule>(TimerConfig{"heartbeat", 500, true, "on_heartbeat"}));
-    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 4, false}));
+    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 4, false, {}}));
 
     MainGenerator gen;
     auto code = gen.generate(modules);
@@ -32,3 +33,51 @@ void testMainGenerator() {
 
     std::cout << "✓ Main generator test passed\n";
 }
+
+namespace {
+class PluginWithHeaders : public GpioModule {
+public:
+    using GpioModule::GpioModule;
+    void emitHeader(CodeWriter& out) const override {
+        out << "#include <hardware/gpio.h>\n#include \"board.h\"\n";
+    }
+};
+
+// Declares a dependency it never emits, and emits an include it never declares.
+class PluginWithDependency : public GpioModule {
+public:
+    using GpioModule::GpioModule;
+    std::vector<Symbol> dependencies() const override {
+        auto deps = GpioModule::dependencies();
+        deps.emplace_back("hardware/watchdog");
+        return deps;
+    }
+    void emitHeader(CodeWriter& out) const override { out << "#include <string.h>\n"; }
+};
+}  // namespace
+
+void testMainGeneratorMinimalIncludes() {
+    ModuleList modules;
+    modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "up"}));
+    modules.push_back(std::make_shared<PioModule>(PioConfig{"leds", "ws2812", 1, 22}));
+    modules.push_back(std::make_shared<PluginWithHeaders>(GpioConfig{3, "input", "none"}));
+    modules.push_back(std::make_shared<TimerModule>(TimerConfig{"tick", 10, true, "on_tick"}));
+
+    auto code = MainGenerator().generate(modules);
+    // hardware/pio.h already includes hardware/gpio.h; other lines are kept once.
+    assert(code.headers ==
+           "#include <hardware/clocks.h>\n"
+           "#include <hardware/pio.h>\n"
+           "#include <pico/time.h>\n"
+           "#include \"board.h\"\n");
+
+    // The include set follows dependencies(), like the CMake link list; an
+    // undeclared include is passed through verbatim.
+    ModuleList plugin = {std::make_shared<PluginWithDependency>(GpioConfig{4, "output", "none"})};
+    assert(MainGenerator().generate(plugin).headers ==
+           "#include <hardware/gpio.h>\n"
+           "#include <hardware/watchdog.h>\n"
+           "#include <string.h>\n");
+
+    std::cout << "✓ Main generator emits the minimal include set\n";
+}
@@ -1,14 +1,21 @@
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <cassert>
+#include <thread>
+#include <vector>
 #include "../src/core/module_registry.h"
 #include "../src/core/module_factory.h"
 #include "../src/core/module.h"
+#include "../src/modules/multicore_module.h"
 
 using namespace picoforge;
 
+namespace {
+ModulePtr factory_test_plugin() { return std::make_shared<MulticoreModule>(); }
+}  // namespace
+
 void testModuleRegistration() {
-    registerAllModules();
-    
     auto& factory = ModuleFactory::instance();
     
     // Test GPIO
@@ -77,3 +84,44 @@ void testUnknownModule() {
     assert(unknown == nullptr);
     std::cout << "✓ Unknown module returns nullptr\n";
 }
+
+void testPluginRegistration() {
+    auto& factory = ModuleFactory::instance();
+
+    // Built-in names are resolved at compile time and cannot be shadowed.
+    [[maybe_unused]] bool shadowed = factory.registerModule("gpio", []() -> ModulePtr { return nullptr; });
+    assert(!shadowed);
+    assert(factory.create("gpio") != nullptr);
+
+    [[maybe_unused]] bool added = factory.registerModule("test_plugin", []() { return factory_test_plugin(); });
+    assert(added);
+    auto plugin = factory.create("test_plugin");
+    assert(plugin != nullptr);
+    assert(plugin->id() == "multicore");
+
+    auto types = factory.registeredTypes();
+    assert(std::is_sorted(types.begin(), types.end()));
+    assert(std::find(types.begin(), types.end(), "test_plugin") != types.end());
+    assert(std::find(types.begin(), types.end(), "spi") != types.end());
+    std::cout << "✓ Plugin modules register at runtime\n";
+}
+
+void testConcurrentCreate() {
+    auto& factory = ModuleFactory::instance();
+    std::atomic<int> created{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&factory, &created, t]() {
+            const char* types[] = {"gpio", "uart", "dma", "test_plugin", "nope"};
+            for (int i = 0; i < 2000; ++i) {
+                if (factory.create(types[(i + t) % 5])) created.fetch_add(1);
+                if (t == 0 && i % 500 == 0) {
+                    factory.registerModule("late_plugin_" + std::to_string(i), []() { return factory_test_plugin(); });
+                }
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    assert(created.load() == 8 * 2000 * 4 / 5);
+    std::cout << "✓ Concurrent create is safe\n";
+}
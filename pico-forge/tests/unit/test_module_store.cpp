@@ -0,0 +1,62 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/core/module_store.h"
+#include "../../src/generators/cmake_generator.h"
+#include "../../src/generators/main_generator.h"
+#include "../../src/utils/file_utils.h"
+
+using namespace picoforge;
+
+namespace {
+class TaggedGpio : public GpioModule {
+public:
+    using GpioModule::GpioModule;
+};
+}  // namespace
+
+void testModuleStoreMatchesModuleList() {
+    for (const char* fixture : {"/sample_forge.json", "/sample_forge_comms.json", "/sample_forge_adc.json"}) {
+        std::string json = FileUtils::readFile(std::string(FIXTURES_PATH) + fixture);
+        auto list = ConfigParser::parseProjectString(json);
+        auto store = ConfigParser::parseProjectStoreString(json);
+        assert(store.name == list.name);
+        assert(store.modules.size() == list.modules.size());
+
+        MainGenerator gen;
+        auto fromList = gen.generate(list.modules);
+        auto fromStore = gen.generate(store.modules);
+        assert(fromStore.headers == fromList.headers);
+        assert(fromStore.mainBody == fromList.mainBody);
+        assert(CMakeGenerator::generate("p", store.modules) == CMakeGenerator::generate("p", list.modules));
+    }
+    std::cout << "✓ ModuleStore generates the same code as ModuleList\n";
+}
+
+void testModuleStoreConversions() {
+    ModuleList list = {
+        std::make_shared<GpioModule>(GpioConfig{25, "output", "none"}),
+        std::make_shared<UartModule>(UartConfig{1, 9600, 4, 5, "even"}),
+        std::make_shared<TimerModule>(TimerConfig{"blink", 250, true, "on_blink"}),
+    };
+
+    ModuleStore store;
+    assert(ModuleStore::fromList(list, store));
+    assert(store.size() == 3);
+    assert(std::holds_alternative<UartModule>(store.values()[1]));
+
+    auto back = store.toList();
+    assert(back.size() == 3);
+    for (size_t i = 0; i < list.size(); ++i) {
+        assert(back[i]->configKey() == list[i]->configKey());
+    }
+
+    // Subclasses would be sliced, so they are refused rather than copied.
+    list.push_back(std::make_shared<TaggedGpio>(GpioConfig{2, "input", "up"}));
+    assert(!ModuleStore::fromList(list, store));
+    assert(store.empty());
+
+    std::cout << "✓ ModuleStore list conversions\n";
+}
@@ -39,13 +39,13 @@ void testTimerValidation() {
 }
 
 void testAdcValidation() {
-    AdcModule adc_ok({26, 4, false});
+    AdcModule adc_ok({26, 4, false, {}});
     assert(adc_ok.validate());
-    AdcModule adc_bad_pin({10, 4, false});
+    AdcModule adc_bad_pin({10, 4, false, {}});
     assert(!adc_bad_pin.validate());
-    AdcModule adc_temp({26, 8, true});
+    AdcModule adc_temp({26, 8, true, {}});
     assert(adc_temp.validate());
-    AdcModule adc_bad_samples({26, 0, false});
+    AdcModule adc_bad_samples({26, 0, false, {}});
     assert(!adc_bad_samples.validate());
     std::cout << "✓ ADC validation tests passed\n";
 }
@@ -0,0 +1,149 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/core/resource_allocator.h"
+#include "../../src/modules/pio_module.h"
+#include "../../src/pio/pio_assembler.h"
+#include "golden.h"
+
+using namespace picoforge;
+
+namespace {
+// pico-examples ws2812.pio (SDK 1.x timings).
+const char* kWs2812 = R"(
+.program ws2812
+.side_set 1
+
+.define public T1 2
+.define public T2 5
+.define public T3 3
+
+.wrap_target
+bitloop:
+    out x, 1       side 0 [T3 - 1] ; Side-set still takes place when instruction stalls
+    jmp !x do_zero side 1 [T1 - 1] ; Branch on the bit we shifted out. Positive pulse
+do_one:
+    jmp  bitloop   side 1 [T2 - 1] ; Continue driving high, for a long pulse
+do_zero:
+    nop            side 0 [T2 - 1] ; Or drive low, for a short pulse
+.wrap
+)";
+
+[[maybe_unused]] bool has_error(const PioAssembly& a, const std::string& text) {
+    for (const auto& e : a.errors) {
+        if (e.find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+}  // namespace
+
+void testPioAssemblerEncoding() {
+    auto ws = PioAssembler::assemble(kWs2812);
+    assert(ws.ok() && ws.programs.size() == 1);
+    [[maybe_unused]] const auto& p = ws.programs[0];
+    assert((p.instructions == std::vector<uint16_t>{0x6221, 0x1123, 0x1400, 0xa442}));  // pioasm's output
+    assert(p.wrap_target == 0 && p.wrapEnd() == 3 && p.sideset_bits == 1 && !p.sideset_optional);
+    assert(p.public_defines.size() == 3 && p.public_defines[2].second == 3);
+
+    auto all = PioAssembler::assemble(R"(
+        .program every
+        top:
+            jmp x-- top
+            jmp !osre top
+            jmp pin, top
+            wait 1 gpio 5
+            wait 0 irq 2 rel
+            in pins, 8
+            out pindirs, 32
+            push iffull noblock
+            pull
+            pull ifempty block
+            mov x, ~osr
+            mov isr, ::x
+            mov pins, !null
+            irq wait 3 rel
+            irq clear 1
+            set pindirs, 0x1f
+            .word 0x1234
+    )");
+    assert(all.ok());
+    assert((all.programs[0].instructions ==
+            std::vector<uint16_t>{0x0040, 0x00e0, 0x00c0, 0x2085, 0x2052, 0x4008, 0x6080, 0x8040, 0x80a0,
+                                  0x80e0, 0xa02f, 0xa0d1, 0xa00b, 0xc033, 0xc041, 0xe09f, 0x1234}));
+
+    // Optional side-set: the enable bit plus two value bits leave two delay bits.
+    auto opt = PioAssembler::assemble(".program o\n.side_set 2 opt pindirs\nnop side 2 [3]\nnop [1]\n");
+    assert(opt.ok() && opt.programs[0].sideset_pindirs);
+    assert((opt.programs[0].instructions == std::vector<uint16_t>{0xbb42, 0xa142}));
+    std::cout << "✓ PIO instructions, side-set and delay encode like pioasm\n";
+}
+
+void testPioAssemblerOutputAndErrors() {
+    auto spi = PioAssembler::assemble(R"(
+        .define BITS 8            ; global, visible to every program
+        .program spi_tx
+        .side_set 1
+        .origin 4
+            pull          side 0
+        .wrap_target
+        PUBLIC bit:
+            out pins, 1   side 0 [1]
+            jmp !osre bit side 1 [(BITS / 8)]
+        .wrap
+        % c-sdk {
+        static inline void spi_tx_note(void) {}
+        %}
+    )");
+    assert(spi.ok());
+    const auto& p = spi.programs[0];
+    assert(p.origin == 4 && p.wrap_target == 1 && p.public_labels[0].second == 1);
+    CodeWriter out;
+    PioAssembler::emitProgram(p, out);
+    checkGolden("pio_spi_tx.txt", out.take());
+
+    auto bad = PioAssembler::assemble(".program b\n.side_set 1\n"
+                                      "frob x\n"                     // line 3
+                                      "nop side 0 [16]\n"            // delay needs 5 bits, only 4 left
+                                      "nop\n"                        // side-set is mandatory
+                                      "jmp nowhere side 0\n");       // line 6
+    assert(!bad.ok());
+    assert(has_error(bad, "line 3: unknown instruction 'frob'"));
+    assert(has_error(bad, "line 4: delay 16 is outside 0-15"));
+    assert(has_error(bad, "line 5: 'side' is required"));
+    assert(has_error(bad, "line 6: unknown symbol 'nowhere'"));
+
+    std::string big = ".program big\n";
+    for (int i = 0; i < 33; ++i) big += "nop\n";
+    assert(has_error(PioAssembler::assemble(big), "is 33 instructions; PIO memory holds 32"));
+    assert(has_error(PioAssembler::assemble("nop\n"), "line 1: instruction outside .program"));
+    assert(has_error(PioAssembler::assemble(".program s\nnop side 1\n"), "'side' without .side_set"));
+    std::cout << "✓ PIO c-sdk output, origin, public symbols and line-numbered errors\n";
+}
+
+void testPioModuleCustomProgram() {
+    auto project = ConfigParser::parseProjectString(R"({
+        "pio": [ { "name": "blink", "pin": 15, "block": 1, "sm": 2,
+                   "program": [ ".program blink",
+                                "    set pins, 1 [31]",
+                                "    set pins, 0 [31]" ] },
+                 { "name": "broken", "program": ".program broken\nfrob\n" } ]
+    })");
+    [[maybe_unused]] const auto& blink = static_cast<const PioModule&>(*project.modules[0]);
+    assert(blink.validate() && blink.programLength() == 2);
+
+    // The allocator places it from the assembled length.
+    auto allocated = ResourceAllocator::allocate({project.modules[0]});
+    assert(allocated.ok());
+    const auto& placed = static_cast<const PioModule&>(*allocated.modules[0]);
+    assert(placed.config().offset == 0);
+    checkGolden("pio_custom_program.txt", renderModule(placed));
+
+    [[maybe_unused]] const auto& broken = static_cast<const PioModule&>(*project.modules[1]);
+    assert(!broken.validate());
+    assert(broken.generateInitCode().find("// pio assembler: line 2: unknown instruction 'frob'") != std::string::npos);
+    assert(broken.generateDefinitionsCode().empty());
+    std::cout << "✓ Custom PIO program assembled, placed and loaded by the module\n";
+}
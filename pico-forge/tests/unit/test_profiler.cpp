@@ -0,0 +1,82 @@
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/config/json_reader.h"
+#include "../../src/core/generation_pipeline.h"
+#include "../../src/utils/profiler.h"
+
+using namespace picoforge;
+
+namespace {
+const char* kConfig = R"({"gpio": [{"pin": 25, "direction": "out"}, {"pin": 40}], "pwm": [{"pin": 2}]})";
+
+// Complete events per name; parsing also checks the trace is well-formed JSON.
+std::map<std::string, size_t> count_events(const std::string& trace) {
+    std::map<std::string, size_t> counts;
+    JsonReader r(trace);
+    std::string_view key;
+    r.beginObject();
+    while (r.nextKey(key)) {
+        if (key != "traceEvents") {
+            r.skipValue();
+            continue;
+        }
+        r.beginArray();
+        while (r.nextElement()) {
+            r.beginObject();
+            while (r.nextKey(key)) {
+                if (key == "name") ++counts[std::string(r.readString())];
+                else r.skipValue();
+            }
+        }
+    }
+    r.expectEnd();
+    return counts;
+}
+}  // namespace
+
+void testProfilerDisabledRecordsNothing() {
+    Profiler::disable();
+    Profiler::reset();
+
+    auto project = ConfigParser::parseProjectString(kConfig);
+    GenerationPipeline::generate(project);
+    {
+        PF_PROFILE_SCOPE_DETAIL("never", std::string(1 << 20, 'x'));
+    }
+    assert(Profiler::eventCount() == 0);
+
+    std::cout << "✓ Disabled profiler records nothing\n";
+}
+
+void testProfilerChromeTrace() {
+    Profiler::reset();
+    Profiler::enable();
+
+    auto project = ConfigParser::parseProjectString(kConfig);
+    GenerationPipeline::generate(project);
+    std::thread worker([]() { PF_PROFILE_SCOPE_DETAIL("worker_phase", "side \"thread\""); });
+    worker.join();
+
+    Profiler::disable();
+    std::string trace = Profiler::chromeTrace();
+    Profiler::reset();
+
+    // Output must be well-formed JSON with one complete event per scope.
+    auto events = count_events(trace);
+    assert(events["parse"] == 1);
+    assert(events["validate"] == 3);
+    assert(events["emit_init"] == 3);
+    assert(events["emit_header"] == 3);
+    assert(events["dedup_headers"] == 1);
+    assert(events["cmake_generate"] == 1);
+    assert(events["worker_phase"] == 1);
+    assert(trace.find(R"("ph":"X")") != std::string::npos);
+    assert(trace.find(R"("args":{"detail":"gpio_25"})") != std::string::npos);
+
+    std::cout << "✓ Profiler Chrome trace output\n";
+}
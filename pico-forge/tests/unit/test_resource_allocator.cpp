@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../../src/core/generation_pipeline.h"
+#include "../../src/core/resource_allocator.h"
+#include "../../src/generators/main_generator.h"
+#include "../../src/modules/dma_module.h"
+#include "../../src/modules/pio_module.h"
+
+using namespace picoforge;
+
+namespace {
+[[maybe_unused]] const PioConfig& pio_at(const AllocationResult& result, size_t i) {
+    return static_cast<const PioModule&>(*result.modules[i]).config();
+}
+
+// Most `declaration` lines found directly inside any one { } block of `source`.
+[[maybe_unused]] int most_per_block(const std::string& source, const std::string& declaration) {
+    std::vector<int> open{0};
+    int most = 0;
+    for (size_t i = 0; i < source.size(); ++i) {
+        if (source[i] == '{') open.push_back(0);
+        else if (source[i] == '}') open.pop_back();
+        else if (source.compare(i, declaration.size(), declaration) == 0) most = std::max(most, ++open.back());
+    }
+    return most;
+}
+}  // namespace
+
+void testAllocatorPinsDmaAndPio() {
+    ModuleList modules = {
+        std::make_shared<DmaModule>(DmaConfig{0, 32, false, false, "none", {}}),
+        std::make_shared<DmaModule>(DmaConfig{-1, 32, true, false, "none", {}}),
+        std::make_shared<DmaModule>(DmaConfig{-1, 8, false, true, "none", {}}),
+        std::make_shared<PioModule>(PioConfig{"strip_a", "ws2812", 1, 2}),
+        std::make_shared<PioModule>(PioConfig{"strip_b", "ws2812", 1, 3}),
+        std::make_shared<PioModule>(PioConfig{"bus", "i2c", 1, 4}),
+        std::make_shared<PioModule>(PioConfig{"serial", "uart", 1, 6}),
+    };
+
+    auto result = ResourceAllocator::allocate(modules);
+    assert(result.ok());
+    assert(result.modules[0] == modules[0]);  // already fixed, left alone
+    assert(static_cast<const DmaModule&>(*result.modules[1]).config().channel == 1);
+    assert(static_cast<const DmaModule&>(*result.modules[2]).config().channel == 2);
+
+    // Largest program first: i2c fills most of pio0, uart goes to the idle pio1,
+    // and both ws2812 strips share one copy of their program in pio1.
+    assert(pio_at(result, 5).block == 0 && pio_at(result, 5).sm == 0 && pio_at(result, 5).offset == 0);
+    assert(pio_at(result, 6).block == 1 && pio_at(result, 6).sm == 0 && pio_at(result, 6).offset == 0);
+    assert(pio_at(result, 3).block == 1 && pio_at(result, 3).sm == 1 && pio_at(result, 3).offset == 8);
+    assert(pio_at(result, 4).block == 1 && pio_at(result, 4).sm == 2 && pio_at(result, 4).offset == 8);
+
+    std::string init = result.modules[3]->generateInitCode();
+    assert(init.find("PIO pio = pio1;") != std::string::npos);
+    assert(init.find("const uint sm = 1;") != std::string::npos);
+    assert(init.find("pio_claim_unused_sm") == std::string::npos);
+    assert(result.modules[1]->generateInitCode().find("int dma_chan = 1;") != std::string::npos);
+
+    std::cout << "✓ Allocator pins DMA channels and balances PIO blocks\n";
+}
+
+void testAllocatorHonoursFixedAndRejectsOversubscription() {
+    ModuleList fixed = {
+        std::make_shared<PioModule>(PioConfig{"custom", "", 1, 2, 1, 0, 0, 32}),
+        std::make_shared<PioModule>(PioConfig{"leds", "ws2812", 1, 3}),
+        std::make_shared<PioModule>(PioConfig{"more", "ws2812", 1, 4, 1}),
+    };
+    auto result = ResourceAllocator::allocate(fixed);
+    assert(result.modules[0] == fixed[0]);
+    assert(pio_at(result, 1).block == 0);
+    // pio1's instruction memory is full, so the block-pinned module cannot load.
+    assert(result.errors.size() == 1);
+    assert(result.errors[0].find("pio_more") == 0);
+
+    ModuleList dma;
+    for (int i = 0; i < 13; ++i) {
+        dma.push_back(std::make_shared<DmaModule>(DmaConfig{-1, 32, false, false, "none", {}}));
+    }
+    assert(ResourceAllocator::allocate(dma).errors.size() == 1);
+
+    ProjectConfig project;
+    project.name = "too_many";
+    project.modules = dma;
+    [[maybe_unused]] bool threw = false;
+    try {
+        GenerationPipeline::generate(project);
+    } catch (const std::runtime_error& e) {
+        threw = std::string(e.what()).find("resource allocation failed") != std::string::npos;
+    }
+    assert(threw);
+
+    std::cout << "✓ Allocator honours fixed placements and rejects over-subscription\n";
+}
+
+void testAllocatedPioModulesShareMain() {
+    PioConfig strip{"strip_a", "ws2812", 1, 2};
+    strip.led_count = 30;
+    ModuleList modules = {
+        std::make_shared<PioModule>(strip),
+        std::make_shared<PioModule>(PioConfig{"strip_b", "ws2812", 1, 3}),
+        std::make_shared<PioModule>(PioConfig{"serial", "uart", 1, 6}),
+    };
+    auto result = ResourceAllocator::allocate(modules);
+    assert(result.ok());
+    std::string main = MainGenerator::composeMainSource(MainGenerator().generate(result.modules));
+
+    // Every module declares pio, sm and offset, each in a block of its own.
+    assert(most_per_block(main, "PIO pio = ") == 1);
+    assert(most_per_block(main, "const uint sm = ") == 1);
+    assert(most_per_block(main, "const uint offset = ") == 1);
+    std::cout << "✓ Several placed PIO modules generate one compilable main()\n";
+}
@@ -5,6 +5,8 @@
 // From test_module_registry.cpp
 void testModuleRegistration();
 void testUnknownModule();
+void testPluginRegistration();
+void testConcurrentCreate();
 
 // From test_modules_validate.cpp
 void testGpioValidation();
@@ -17,17 +19,26 @@ void testSpiValidation();
 
 // From test_config_parser.cpp
 void testConfigParser();
+void testConfigParserReadsValues();
+void testConfigParserArrays();
+void testConfigParserTaggedModules();
+void testConfigParserErrors();
 
 // From test_main_generator.cpp
 void testMainGenerator();
+void testMainGeneratorMinimalIncludes();
 
 // From test_cmake_generator.cpp
 void testCMakeGenerator();
+void testCMakeLibrariesAndPrecompiledHeaders();
+void testCMakeBuildSpeedOptions();
+void testCMakePrebuiltSdkCache();
 
 // From test_code_injector.cpp
 void testCodeInjection();
 void testMultipleBlocks();
 void testNestedBlocks();
+void testLargeSourceScan();
 
 // From test_config_validator.cpp
 void testPinValidation();
@@ -35,6 +46,8 @@ void testFrequencyValidation();
 void testBaudRateValidation();
 void testI2cSpeedValidation();
 void testSpiSpeedValidation();
+void testValidateAllConflicts();
+void testValidateAllAssignsAndExhausts();
 
 // From test_template_generation.cpp
 void testTemplateGeneration();
@@ -42,6 +55,88 @@ void testTemplateGeneration();
 // From test_code_generation_correctness.cpp
 void testCodeGenerationCorrectness();
 
+// From test_batch_runner.cpp
+void testThreadPoolRunsAllTasks();
+void testBatchManifestParsing();
+void testBatchRunOrderAndErrors();
+
+// From test_generation_cache.cpp
+void testConfigKeyNormalization();
+void testGenerationCacheHitMiss();
+void testGenerationCacheEviction();
+
+// From test_incremental_generation.cpp
+void testFragmentStoreReusesUnchangedModules();
+void testWriteSkipsIdenticalFiles();
+
+// From test_code_writer.cpp
+void testCodeWriterFormatting();
+void testCodeWriterIndentation();
+void testEmitMatchesStringAdapters();
+
+// From test_daemon.cpp
+void testFrameDecoding();
+#ifdef PICOFORGE_HAS_DAEMON
+void testDaemonHandlesRequests();
+void testDaemonServesStreamWithBackpressure();
+void testDaemonConfinesPathsToRoot();
+void testDaemonSocketLimitsClients();
+#endif
+
+// From test_profiler.cpp
+void testProfilerDisabledRecordsNothing();
+void testProfilerChromeTrace();
+
+// From test_module_store.cpp
+void testModuleStoreMatchesModuleList();
+void testModuleStoreConversions();
+
+// From test_resource_allocator.cpp
+void testAllocatorPinsDmaAndPio();
+void testAllocatorHonoursFixedAndRejectsOversubscription();
+void testAllocatedPioModulesShareMain();
+
+// From test_file_utils.cpp
+void testMappedFileReads();
+void testAtomicWrites();
+void testWritesFollowSymlinks();
+
+// From test_dependency_injector.cpp
+void testInjectorLifetimes();
+void testInjectorConcurrentSingleton();
+
+// From test_logger.cpp
+void testLoggerFormatsFieldsAndFiltersLazily();
+void testLoggerConcurrentProducers();
+
+// From test_symbol_table.cpp
+void testSymbolInterning();
+void testModuleIdsCachedDependenciesInterned();
+
+// From test_dma_streams.cpp
+void testDmaStreamGolden();
+void testDmaStreamValidationAndAllocation();
+
+// From test_adc_capture.cpp
+void testAdcCaptureGolden();
+void testAdcCaptureValidationAndAllocation();
+void testAdcCaptureOwnsConverter();
+
+// From test_adc_filters.cpp
+void testFilterKernelGoldens();
+void testFilterDesignMath();
+void testAdcFilterHooks();
+
+// From test_pio_assembler.cpp
+void testPioAssemblerEncoding();
+void testPioAssemblerOutputAndErrors();
+void testPioModuleCustomProgram();
+
+// From test_ws2812.cpp
+void testWs2812DriverGolden();
+void testWs2812Options();
+void testWs2812DmaAllocation();
+
 int main() {
     std::cout << "=== Running PicoForge Unit Tests ===\n\n";
     
@@ -50,6 +145,8 @@ int main() {
     try {
         testModuleRegistration();
         testUnknownModule();
+        testPluginRegistration();
+        testConcurrentCreate();
         std::cout << "✅ Module Registry Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ Module Registry Tests Failed\n\n";
@@ -76,6 +173,10 @@ int main() {
     std::cout << "--- Config Parser Tests ---\n";
     try {
         testConfigParser();
+        testConfigParserReadsValues();
+        testConfigParserArrays();
+        testConfigParserTaggedModules();
+        testConfigParserErrors();
         std::cout << "✅ Config Parser Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ Config Parser Tests Failed\n\n";
@@ -86,6 +187,7 @@ int main() {
     std::cout << "--- Main Generator Tests ---\n";
     try {
         testMainGenerator();
+        testMainGeneratorMinimalIncludes();
         std::cout << "✅ Main Generator Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ Main Generator Tests Failed\n\n";
@@ -96,6 +198,9 @@ int main() {
     std::cout << "--- CMake Generator Tests ---\n";
     try {
         testCMakeGenerator();
+        testCMakeLibrariesAndPrecompiledHeaders();
+        testCMakeBuildSpeedOptions();
+        testCMakePrebuiltSdkCache();
         std::cout << "✅ CMake Generator Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ CMake Generator Tests Failed\n\n";
@@ -108,6 +213,7 @@ int main() {
         testCodeInjection();
         testMultipleBlocks();
         testNestedBlocks();
+        testLargeSourceScan();
         std::cout << "✅ Code Injector Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ Code Injector Tests Failed\n\n";
@@ -122,6 +228,8 @@ int main() {
         testBaudRateValidation();
         testI2cSpeedValidation();
         testSpiSpeedValidation();
+        testValidateAllConflicts();
+        testValidateAllAssignsAndExhausts();
         std::cout << "✅ Config Validator Tests Passed\n\n";
     } catch (...) {
         std::cerr << "❌ Config Validator Tests Failed\n\n";
@@ -148,6 +256,207 @@ int main() {
         return 1;
     }
     
+    // Batch Runner Tests
+    std::cout << "--- Batch Runner Tests ---\n";
+    try {
+        testThreadPoolRunsAllTasks();
+        testBatchManifestParsing();
+        testBatchRunOrderAndErrors();
+        std::cout << "✅ Batch Runner Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Batch Runner Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Generation Cache Tests
+    std::cout << "--- Generation Cache Tests ---\n";
+    try {
+        testConfigKeyNormalization();
+        testGenerationCacheHitMiss();
+        testGenerationCacheEviction();
+        std::cout << "✅ Generation Cache Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Generation Cache Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Incremental Generation Tests
+    std::cout << "--- Incremental Generation Tests ---\n";
+    try {
+        testFragmentStoreReusesUnchangedModules();
+        testWriteSkipsIdenticalFiles();
+        std::cout << "✅ Incremental Generation Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Incremental Generation Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Code Writer Tests
+    std::cout << "--- Code Writer Tests ---\n";
+    try {
+        testCodeWriterFormatting();
+        testCodeWriterIndentation();
+        testEmitMatchesStringAdapters();
+        std::cout << "✅ Code Writer Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Code Writer Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Daemon Tests
+    std::cout << "--- Daemon Tests ---\n";
+    try {
+        testFrameDecoding();
+#ifdef PICOFORGE_HAS_DAEMON
+        testDaemonHandlesRequests();
+        testDaemonServesStreamWithBackpressure();
+        testDaemonConfinesPathsToRoot();
+        testDaemonSocketLimitsClients();
+#endif
+        std::cout << "✅ Daemon Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Daemon Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Profiler Tests
+    std::cout << "--- Profiler Tests ---\n";
+    try {
+        testProfilerDisabledRecordsNothing();
+        testProfilerChromeTrace();
+        std::cout << "✅ Profiler Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Profiler Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Module Store Tests
+    std::cout << "--- Module Store Tests ---\n";
+    try {
+        testModuleStoreMatchesModuleList();
+        testModuleStoreConversions();
+        std::cout << "✅ Module Store Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Module Store Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Resource Allocator Tests
+    std::cout << "--- Resource Allocator Tests ---\n";
+    try {
+        testAllocatorPinsDmaAndPio();
+        testAllocatorHonoursFixedAndRejectsOversubscription();
+        testAllocatedPioModulesShareMain();
+        std::cout << "✅ Resource Allocator Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Resource Allocator Tests Failed\n\n";
+        return 1;
+    }
+    
+    // File Utils Tests
+    std::cout << "--- File Utils Tests ---\n";
+    try {
+        testMappedFileReads();
+        testAtomicWrites();
+        testWritesFollowSymlinks();
+        std::cout << "✅ File Utils Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ File Utils Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Dependency Injector Tests
+    std::cout << "--- Dependency Injector Tests ---\n";
+    try {
+        testInjectorLifetimes();
+        testInjectorConcurrentSingleton();
+        std::cout << "✅ Dependency Injector Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Dependency Injector Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Logger Tests
+    std::cout << "--- Logger Tests ---\n";
+    try {
+        testLoggerFormatsFieldsAndFiltersLazily();
+        testLoggerConcurrentProducers();
+        std::cout << "✅ Logger Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Logger Tests Failed\n\n";
+        return 1;
+    }
+    
+    // Symbol Table Tests
+    std::cout << "--- Symbol Table Tests ---\n";
+    try {
+        testSymbolInterning();
+        testModuleIdsCachedDependenciesInterned();
+        std::cout << "✅ Symbol Table Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ Symbol Table Tests Failed\n\n";
+        return 1;
+    }
+    
+    // DMA Stream Tests
+    std::cout << "--- DMA Stream Tests ---\n";
+    try {
+        testDmaStreamGolden();
+        testDmaStreamValidationAndAllocation();
+        std::cout << "✅ DMA Stream Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ DMA Stream Tests Failed\n\n";
+        return 1;
+    }
+    
+    // ADC Capture Tests
+    std::cout << "--- ADC Capture Tests ---\n";
+    try {
+        testAdcCaptureGolden();
+        testAdcCaptureValidationAndAllocation();
+        testAdcCaptureOwnsConverter();
+        std::cout << "✅ ADC Capture Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ ADC Capture Tests Failed\n\n";
+        return 1;
+    }
+    
+    // ADC Filter Tests
+    std::cout << "--- ADC Filter Tests ---\n";
+    try {
+        testFilterKernelGoldens();
+        testFilterDesignMath();
+        testAdcFilterHooks();
+        std::cout << "✅ ADC Filter Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ ADC Filter Tests Failed\n\n";
+        return 1;
+    }
+    
+    // PIO Assembler Tests
+    std::cout << "--- PIO Assembler Tests ---\n";
+    try {
+        testPioAssemblerEncoding();
+        testPioAssemblerOutputAndErrors();
+        testPioModuleCustomProgram();
+        std::cout << "✅ PIO Assembler Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ PIO Assembler Tests Failed\n\n";
+        return 1;
+    }
+    
+    // WS2812 Driver Tests
+    std::cout << "--- WS2812 Driver Tests ---\n";
+    try {
+        testWs2812DriverGolden();
+        testWs2812Options();
+        testWs2812DmaAllocation();
+        std::cout << "✅ WS2812 Driver Tests Passed\n\n";
+    } catch (...) {
+        std::cerr << "❌ WS2812 Driver Tests Failed\n\n";
+        return 1;
+    }
+    
     std::cout << "=== ✅ All Unit Tests Passed! ===\n";
     return 0;
 }
@@ -0,0 +1,64 @@
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/core/dependency_graph.h"
+#include "../../src/modules/gpio_module.h"
+#include "../../src/modules/pio_module.h"
+#include "../../src/utils/symbol_table.h"
+
+using namespace picoforge;
+
+void testSymbolInterning() {
+    Symbol a("symbol_test_gpio_4");
+    Symbol b(std::string("symbol_test_") + "gpio_4");
+    Symbol c("symbol_test_gpio_5");
+    assert(a.valid() && a == b && a != c);
+    assert(a.str() == "symbol_test_gpio_4");
+    assert(&a.str() == &b.str());  // one stored copy
+    assert(SymbolTable::find("symbol_test_gpio_5") == c);
+    assert(!SymbolTable::find("symbol_test_never_interned").valid());
+    assert(Symbol().str().empty());
+
+    // Concurrent interning of the same names agrees on handles.
+    std::vector<std::vector<Symbol>> seen(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 5000; ++i) seen[t].push_back(Symbol("symbol_test_bulk_" + std::to_string(i)));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for ([[maybe_unused]] const auto& symbols : seen) assert(symbols == seen[0]);
+    assert(seen[0][4321].str() == "symbol_test_bulk_4321");
+    std::cout << "✓ Symbols intern to stable shared handles\n";
+}
+
+void testModuleIdsCachedDependenciesInterned() {
+    GpioModule gpio(GpioConfig{7, "input", "up"});
+    [[maybe_unused]] const std::string& id = gpio.id();
+    assert(id == "gpio_7");
+    assert(&gpio.id() == &id);  // cached, not rebuilt
+
+    GpioModule copy = gpio;
+    assert(copy.id() == "gpio_7" && &copy.id() != &id);
+
+    // Ids carry user names, so a long-running daemon must not intern them.
+    [[maybe_unused]] size_t before = SymbolTable::size();
+    for (int i = 0; i < 100; ++i) {
+        PioModule pio(PioConfig{"request_" + std::to_string(i), "", 1, 2});
+        [[maybe_unused]] const std::string& pioId = pio.id();
+        assert(pioId == "pio_request_" + std::to_string(i));
+    }
+    assert(SymbolTable::size() == before);
+
+    DependencySet deps;
+    deps.addDependency(gpio.dependencies()[0]);
+    deps.addDependency(Symbol("hardware/pio"));
+    deps.addDependency(Symbol("vendor/sensor"));
+    deps.addDependency(Symbol("vendor/sensor"));
+    assert((deps.includes() == std::vector<std::string>{"hardware/pio.h", "vendor/sensor.h"}));
+    std::cout << "✓ Module ids are cached per module; dependency names resolve through symbols\n";
+}
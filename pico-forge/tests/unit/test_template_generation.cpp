@@ -67,7 +67,7 @@ void testAdcTemplateCorrect() {
     std::cout << "    Testing ADC template...\n";
     
     ModuleList modules;
-    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 12, true}));
+    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 12, true, {}}));
     
     MainGenerator gen;
     auto code = gen.generate(modules);
@@ -99,7 +99,7 @@ void testMultiModuleTemplateCorrect() {
     ModuleList modules;
     modules.push_back(std::make_shared<GpioModule>(GpioConfig{15, "output", "none"}));
     modules.push_back(std::make_shared<PwmModule>(PwmConfig{0, 1000, 50.0}));
-    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 12, true}));
+    modules.push_back(std::make_shared<AdcModule>(AdcConfig{26, 12, true, {}}));
     modules.push_back(std::make_shared<UartModule>(UartConfig{0, 115200, 0, 1, "none"}));
     
     MainGenerator gen;
@@ -0,0 +1,87 @@
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../../src/config/config_parser.h"
+#include "../../src/core/resource_allocator.h"
+#include "../../src/modules/dma_module.h"
+#include "../../src/modules/pio_module.h"
+#include "golden.h"
+
+using namespace picoforge;
+
+namespace {
+[[maybe_unused]] bool contains(const std::string& text, const std::string& part) { return text.find(part) != std::string::npos; }
+}  // namespace
+
+void testWs2812DriverGolden() {
+    auto project = ConfigParser::parseProjectString(R"({
+        "pio": [ { "name": "strip", "preset": "ws2812", "data_pin": 16, "led_count": 60 } ]
+    })");
+    auto allocated = ResourceAllocator::allocate(project.modules);
+    assert(allocated.ok());
+    const auto& strip = static_cast<const PioModule&>(*allocated.modules[0]);
+    assert(strip.drivesLeds() && strip.config().dma_channel == 0 && strip.config().offset == 0);
+    checkGolden("ws2812_driver.txt", renderModule(strip));
+
+    // The built-in program is the pioasm encoding of pico-examples' ws2812.pio.
+    std::string defs = strip.generateDefinitionsCode();
+    assert(contains(defs, "0x6321, //  0: out x, 1 side 0 [T3 - 1]"));
+    // 9 words of 24 bits at 800 kHz drain in 270 us, then 280 us of reset.
+    assert(contains(defs, "add_alarm_in_us(550, pio_strip_latched, nullptr, true);"));
+    std::cout << "✓ WS2812 driver: program, clock divider, double buffer and DMA\n";
+}
+
+void testWs2812Options() {
+    PioConfig cfg{"rgbw", "ws2812", 1, 5};
+    cfg.led_count = 8;
+    cfg.rgbw = true;
+    cfg.freq_hz = 400000;
+    cfg.dma_channel = 7;
+    cfg.irq_line = 1;
+    PioModule rgbw(cfg);
+    assert(rgbw.validate());
+    std::string init = rgbw.generateInitCode();
+    assert(contains(init, "sm_config_set_out_shift(&c, false, true, 32);"));
+    assert(contains(init, "clock_get_hz(clk_sys) / (400000.0f * (ws2812_T1 + ws2812_T2 + ws2812_T3))"));
+    assert(contains(init, "pio_rgbw_dma_chan = 7;") && !contains(init, "dma_channel_claim"));
+    assert(contains(init, "irq_set_enabled(DMA_IRQ_1, true);"));
+    std::string defs = rgbw.generateDefinitionsCode();
+    assert(contains(defs, "uint8_t b, uint8_t w)"));
+    assert(contains(defs, "add_alarm_in_us(1000, pio_rgbw_latched"));  // ceil(9 * 32 / 0.4) + 280
+
+    // Without a frame buffer the preset only starts the state machine.
+    PioModule bare(PioConfig{"bare", "ws2812", 1, 22});
+    assert(!bare.drivesLeds() && bare.dependencies().size() == 2);
+    assert(contains(bare.generateInitCode(), "pio_sm_set_enabled(pio, sm, true);"));
+    assert(!contains(bare.generateInitCode(), "dma_"));
+
+    for (auto broken : {PioConfig{"a", "uart", 1, 5}, PioConfig{"b", "ws2812", 2, 5}, PioConfig{"c", "ws2812", 1, 5}}) {
+        broken.led_count = broken.name == "c" ? 5000 : 8;
+        assert(!PioModule(broken).validate());
+    }
+    cfg.irq_line = 2;
+    assert(!PioModule(cfg).validate());
+    std::cout << "✓ WS2812 RGBW, bit rate, fixed DMA channel and validation\n";
+}
+
+void testWs2812DmaAllocation() {
+    PioConfig leds{"leds", "ws2812", 1, 3};
+    leds.led_count = 16;
+    ModuleList modules = {
+        std::make_shared<DmaModule>(DmaConfig{0, 32, false, false, "none", {}}),
+        std::make_shared<PioModule>(leds),
+    };
+    auto result = ResourceAllocator::allocate(modules);
+    assert(result.ok());
+    [[maybe_unused]] const auto& placed = static_cast<const PioModule&>(*result.modules[1]).config();
+    assert(placed.dma_channel == 1 && placed.block >= 0 && placed.sm >= 0);
+
+    ModuleList full;
+    for (int ch = 0; ch < 12; ++ch) full.push_back(std::make_shared<DmaModule>(DmaConfig{ch, 32, false, false, "none", {}}));
+    full.push_back(std::make_shared<PioModule>(leds));
+    auto exhausted = ResourceAllocator::allocate(full);
+    assert(!exhausted.ok() && exhausted.errors[0] == "pio_leds: all DMA channels are in use");
+    std::cout << "✓ WS2812 frame DMA channel is allocated around fixed channels\n";
+}
@@ -27,7 +27,10 @@ class BuildService {
 
         // TODO: This command needs to align with what the pico-forge container expects
         // Assuming a builder script that takes project name 
-        const cmd = ['/bin/bash', '-c', `cd /app/workspace/${projectName} && mkdir -p build && cd build && cmake .. && make`];
+        // Projects generated with --presets/--ninja carry CMakePresets.json (Ninja, build/ dir)
+        const cmd = ['/bin/bash', '-c', `cd /app/workspace/${projectName} && ` +
+            `if [ -f CMakePresets.json ]; then cmake --preset default && cmake --build --preset default; ` +
+            `else mkdir -p build && cd build && cmake .. && make -j$(nproc); fi`];
 
         try {
             const { stream } = await dockerService.runBuild(image, cmd, binds);
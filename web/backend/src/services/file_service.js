@@ -38,6 +38,12 @@ class FileService {
             const fullPath = this._getFilePath(projectName, filePath);
             // Ensure directory exists
             await fs.mkdir(path.dirname(fullPath), { recursive: true });
+            // Leave identical files untouched so their mtimes (and incremental builds) survive
+            const existing = await fs.readFile(fullPath, 'utf8').catch(() => null);
+            if (existing === content) {
+                logger.info(`Unchanged file: ${filePath} in project ${projectName}`);
+                return;
+            }
             await fs.writeFile(fullPath, content, 'utf8');
             logger.info(`Wrote file: ${filePath} in project ${projectName}`);
         } catch (error) {